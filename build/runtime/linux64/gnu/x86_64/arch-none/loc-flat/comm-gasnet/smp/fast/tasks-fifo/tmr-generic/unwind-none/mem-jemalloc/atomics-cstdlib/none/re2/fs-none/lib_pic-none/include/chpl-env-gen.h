@@ -0,0 +1,40 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* THIS FILE IS AUTOMATICALLY GENERATED */
+#ifndef _CHPL_ENV_GEN_H_
+#define _CHPL_ENV_GEN_H_
+#define CHPL_TARGET_PLATFORM_LINUX64
+#define CHPL_TARGET_COMPILER_GNU
+#define CHPL_TARGET_ARCH_X86_64
+#define CHPL_TARGET_CPU_NONE
+#define CHPL_LOCALE_MODEL_FLAT
+#define CHPL_COMM_GASNET
+#define CHPL_COMM_SUBSTRATE_SMP
+#define CHPL_GASNET_SEGMENT_FAST
+#define CHPL_TASKS_FIFO
+#define CHPL_TIMERS_GENERIC
+#define CHPL_UNWIND_NONE
+#define CHPL_MEM_JEMALLOC
+#define CHPL_ATOMICS_CSTDLIB
+#define CHPL_HWLOC_NONE
+#define CHPL_REGEXP_RE2
+#define CHPL_AUX_FILESYS_NONE
+#define CHPL_LIB_PIC_NONE
+#endif /* _CHPL_ENV_GEN_H_ */
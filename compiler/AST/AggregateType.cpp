@@ -22,6 +22,7 @@
 #include "astutil.h"
 #include "AstVisitor.h"
 #include "build.h"
+#include "compileProfile.h"
 #include "docsDriver.h"
 #include "driver.h"
 #include "expr.h"
@@ -729,6 +730,8 @@ AggregateType* AggregateType::instantiationWithParent(AggregateType* parent) {
 
     retval->instantiatedFrom = this;
 
+    profileCompileInstantiation(this);
+
     retval->symbol->copyFlags(symbol);
 
     retval->substitutions.copy(substitutions);
@@ -831,6 +834,8 @@ AggregateType* AggregateType::getNewInstantiation(Symbol* sym) {
 
   retval->instantiatedFrom = this;
 
+  profileCompileInstantiation(this);
+
   retval->symbol->copyFlags(symbol);
 
   retval->substitutions.copy(substitutions);
@@ -907,6 +912,8 @@ AggregateType::getInstantiationParent(AggregateType* parentType) {
   instantiations.push_back(newInstance);
   newInstance->instantiatedFrom = this;
 
+  profileCompileInstantiation(this);
+
   // Handle dispatch parent
   newInstance->dispatchParents.add(parentType);
 
@@ -1269,11 +1269,14 @@ CallExpr* buildScanExpr(Expr* opExpr, Expr* dataExpr, bool zippered) {
   buildReduceScanPreface1(fn, data, eltType, opExpr, dataExpr, zippered);
   buildReduceScanPreface2(fn, eltType, globalOp, opExpr);
 
-  fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
-
   if( !zippered ) {
+    CallExpr* isPar = new CallExpr("chpl__scanIsParallel", globalOp, data);
+    fn->insertAtTail(new CondStmt(new CallExpr("_cond_test",
+                                               new CallExpr("!", isPar)),
+      new_Expr("compilerWarning('scan has been serialized (see issue #5760)')")));
     fn->insertAtTail("'return'(chpl__scanIterator(%S, %S))", globalOp, data);
   } else {
+    fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
     fn->insertAtTail("'return'(chpl__scanIteratorZip(%S, %S))", globalOp, data);
   }
 
@@ -57,6 +57,7 @@
 #include <cctype>
 #include <cstring>
 #include <cstdio>
+#include <unistd.h>
 #include <vector>
 
 // function prototypes
@@ -1352,7 +1353,7 @@ static void codegen_defn(std::set<const char*> & cnames, std::vector<TypeSymbol*
   genComment("Virtual Method Table");
   genVirtualMethodTable(types, false);
 
-  if(fIncrementalCompilation) {
+  if(codegenMultipleCFiles()) {
     genComment("Global Variables");
     forv_Vec(VarSymbol, varSymbol, globals) {
       varSymbol->codegenGlobalDef(false);
@@ -2227,6 +2228,93 @@ static void setupDefaultFilenames() {
   }
 }
 
+// The number of C files to spread the module code over, per
+// --c-compile-jobs.  1 means it is all #included into _main.c.
+static int numCShards() {
+  static int numShards = 0;
+
+  if (numShards == 0) {
+    if (llvmCodegen) {
+      numShards = 1;
+    } else if (fCCompileJobs > 0) {
+      numShards = fCCompileJobs;
+    } else {
+      long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+      numShards = (numCores > 0) ? (int) numCores : 1;
+    }
+  }
+
+  return numShards;
+}
+
+// Whether some of the generated code is compiled separately from
+// _main.c, so that the functions and globals it defines must be
+// visible to the other C files.
+bool codegenMultipleCFiles() {
+  return fIncrementalCompilation || numCShards() > 1;
+}
+
+// The path of a generated C file without its ".c", which is how the
+// Makefile names its object.
+static const char* objectPathForCFile(fileinfo* cfile) {
+  const char* path = astr(cfile->pathname);
+  size_t      len  = strlen(path);
+
+  INT_ASSERT(len > 2 && strcmp(path + len - 2, ".c") == 0);
+
+  return astr(std::string(path, len - 2).c_str());
+}
+
+//
+// Spread the functions of 'mods' over the 'shards' files, giving each
+// about the same amount of code by AST size.  Functions are taken in
+// module and then line order and each shard gets a contiguous run of
+// them, so most calls stay within one file where the C compiler can
+// still inline them.
+//
+static void codegenModulesSharded(const std::vector<ModuleSymbol*>& mods,
+                                  std::vector<fileinfo>& shards) {
+  GenInfo* info = gGenInfo;
+  std::vector<std::vector<FnSymbol*> > modFns(mods.size());
+  std::vector<std::vector<size_t> > fnSizes(mods.size());
+  std::vector<BaseAST*> asts;
+  size_t totalSize = 0;
+  size_t doneSize = 0;
+
+  for (size_t i = 0; i < mods.size(); i++) {
+    modFns[i] = mods[i]->getCodegenFunctions();
+
+    for_vector(FnSymbol, fn, modFns[i]) {
+      asts.clear();
+      collect_asts(fn, asts);
+      fnSizes[i].push_back(asts.size());
+      totalSize += asts.size();
+    }
+  }
+
+  for (size_t i = 0; i < mods.size(); i++) {
+    ModuleSymbol* mod = mods[i];
+
+    mysystem(astr("# codegen-ing module", mod->name),
+             "generating comment for --print-commands option");
+
+    // As in ModuleSymbol::codegenDef()
+    info->filename = mod->fname();
+    info->lineno   = mod->linenum();
+    commIDMap[info->filename] = 0;
+
+    info->cStatements.clear();
+    info->cLocalDecls.clear();
+
+    for (size_t j = 0; j < modFns[i].size(); j++) {
+      info->cfile = shards[doneSize * shards.size() / totalSize].fptr;
+      modFns[i][j]->codegenDef();
+      doneSize += fnSizes[i][j];
+    }
+
+    flushStatements();
+  }
+}
 
 void codegen() {
   if (no_codegen)
@@ -2260,6 +2348,7 @@ void codegen() {
 
   fileinfo hdrfile  = { NULL, NULL, NULL };
   fileinfo mainfile = { NULL, NULL, NULL };
+  std::vector<fileinfo> shardfiles;
   fileinfo defnfile = { NULL, NULL, NULL };
   fileinfo strconfig = { NULL, NULL, NULL };
 
@@ -2332,16 +2421,24 @@ void codegen() {
         if(currentModule->modTag == MOD_USER) {
           fileinfo modulefile;
           openCFile(&modulefile, filename, "c");
-          int modulePathLen = strlen(astr(modulefile.pathname));
-          char path[FILENAME_MAX];
-          strncpy(path, astr(modulefile.pathname), modulePathLen-2);
-          path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
+          userFileName.push_back(objectPathForCFile(&modulefile));
           closeCFile(&modulefile);
         }
       }
     }
 
+    // With --c-compile-jobs, the code for the modules that would be
+    // #included into _main.c goes into this many separate files instead.
+    if (numCShards() > 1) {
+      for (int i = 0; i < numCShards(); i++) {
+        fileinfo shardfile;
+        openCFile(&shardfile, astr("chpl__shard", istr(i)), "c");
+        fprintf(shardfile.fptr, "#include \"chpl__header.h\"\n");
+        userFileName.push_back(objectPathForCFile(&shardfile));
+        shardfiles.push_back(shardfile);
+      }
+    }
+
     codegen_makefile(&mainfile, NULL, false, userFileName);
     if (fLibraryCompile && fLibraryMakefile) {
       codegen_library_makefile();
@@ -2395,7 +2492,14 @@ void codegen() {
     }
 
     ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
+    std::vector<ModuleSymbol*> shardedModules;
     forv_Vec(ModuleSymbol, currentModule, allModules) {
+      if (shardfiles.size() > 0 &&
+          !(fIncrementalCompilation && (currentModule->modTag == MOD_USER))) {
+        shardedModules.push_back(currentModule);
+        continue;
+      }
+
       mysystem(astr("# codegen-ing module", currentModule->name),
                "generating comment for --print-commands option");
 
@@ -2414,6 +2518,13 @@ void codegen() {
         fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
 
+    if (shardfiles.size() > 0) {
+      codegenModulesSharded(shardedModules, shardfiles);
+
+      for (size_t i = 0; i < shardfiles.size(); i++)
+        closeCFile(&shardfiles[i]);
+    }
+
     fprintf(strconfig.fptr, "#include \"chpl-string.h\"\n");
     fprintf(strconfig.fptr, "chpl_string defaultStringValue=\"\";\n");
 
@@ -2446,6 +2557,12 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+
+    // The generated Makefile has a rule per C file, so it can compile
+    // the --c-compile-jobs shards in parallel.
+    if (numCShards() > 1)
+      makeflags = astr("-j", istr(numCShards()), " ", makeflags);
+
     const char* command = astr(astr(CHPL_MAKE, " "),
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
@@ -680,7 +680,7 @@ void VarSymbol::codegenDefC(bool global, bool isHeader) {
   //
   std::string str;
 
-  if(fIncrementalCompilation || (this->hasFlag(FLAG_EXTERN) &&
+  if(codegenMultipleCFiles() || (this->hasFlag(FLAG_EXTERN) &&
                                  this->hasFlag(FLAG_GENERATE_SIGNATURE))) {
     bool addExtern =  global && isHeader;
     str = (addExtern ? "extern " : "") + typestr + " " + cname;
@@ -1646,7 +1646,7 @@ void FnSymbol::codegenHeaderC(void) {
   if (fGenIDS)
     fprintf(outfile, "%s", idCommentTemp(this));
 
-  if (!fIncrementalCompilation && !hasFlag(FLAG_EXPORT) && !hasFlag(FLAG_EXTERN)) {
+  if (!codegenMultipleCFiles() && !hasFlag(FLAG_EXPORT) && !hasFlag(FLAG_EXTERN)) {
     fprintf(outfile, "static ");
   }
   fprintf(outfile, "%s", codegenFunctionType(true).c.c_str());
@@ -2277,16 +2277,8 @@ static int compareLineno(void* v1, void* v2) {
   return fn1->linenum() < fn2->linenum();
 }
 
-void ModuleSymbol::codegenDef() {
-  GenInfo* info = gGenInfo;
-
-  info->filename = fname();
-  info->lineno   = linenum();
-  commIDMap[info->filename] = 0;
-
-  info->cStatements.clear();
-  info->cLocalDecls.clear();
-
+// The functions codegenDef() generates, in the order it generates them.
+std::vector<FnSymbol*> ModuleSymbol::getCodegenFunctions() {
   std::vector<FnSymbol*> fns;
 
   for_alist(expr, block->body) {
@@ -2302,6 +2294,21 @@ void ModuleSymbol::codegenDef() {
 
   std::sort(fns.begin(), fns.end(), compareLineno);
 
+  return fns;
+}
+
+void ModuleSymbol::codegenDef() {
+  GenInfo* info = gGenInfo;
+
+  info->filename = fname();
+  info->lineno   = linenum();
+  commIDMap[info->filename] = 0;
+
+  info->cStatements.clear();
+  info->cLocalDecls.clear();
+
+  std::vector<FnSymbol*> fns = getCodegenFunctions();
+
 #ifdef HAVE_LLVM
   if(debug_info && info->filename) {
     debug_info->get_module_scope(this);
@@ -64,6 +64,7 @@ public:
   // Interface to Symbol
   virtual void            replaceChild(BaseAST* oldAst, BaseAST* newAst);
   virtual void            codegenDef();
+  std::vector<FnSymbol*>  getCodegenFunctions();
 
   // New interface
   std::vector<AggregateType*> getTopLevelClasses();
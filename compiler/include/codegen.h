@@ -156,4 +156,6 @@ void flushStatements(void);
 
 void registerPrimitiveCodegens();
 
+bool codegenMultipleCFiles();
+
 #endif //CODEGEN_H
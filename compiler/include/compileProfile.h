@@ -0,0 +1,52 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _COMPILE_PROFILE_H_
+#define _COMPILE_PROFILE_H_
+
+class AggregateType;
+class FnSymbol;
+
+//
+// Support for --profile-compile, which writes a JSON report of where
+// the compiler spends its time and memory:
+//
+//   - per pass: the time, the peak RSS so far, and the live AST nodes
+//     by kind along with how many were created and removed
+//   - the functions that took the longest to resolve
+//   - the number of instantiations of each generic function and type
+//
+// All of these do nothing unless --profile-compile is given.
+//
+
+void profileCompileStartPass(const char* passName);
+void profileCompileEndPass();
+
+// Bracket the resolution of a function's body.  Nested resolutions are
+// subtracted from the enclosing function's time.
+void profileCompileStartResolve(FnSymbol* fn);
+void profileCompileEndResolve(FnSymbol* fn);
+
+// Count a new instantiation of a generic function or type.
+void profileCompileInstantiation(FnSymbol* generic);
+void profileCompileInstantiation(AggregateType* generic);
+
+void writeCompileProfile();
+
+#endif
@@ -52,6 +52,7 @@ extern bool fNoDivZeroChecks;
 extern bool fMungeUserIdents;
 extern bool fEnableTaskTracking;
 extern bool fLLVMWideOpt;
+extern int  fLLVMCodegenThreads;
 
 extern bool fNoRemoteValueForwarding;
 extern bool fNoInferConstRefs;
@@ -69,6 +70,7 @@ extern bool fNoRemoveEmptyRecords;
 extern bool fNoInferLocalFields;
 extern bool fRemoveUnreachableBlocks;
 extern bool fReplaceArrayAccessesWithRefTemps;
+extern bool fResolutionCache;
 extern int  optimize_on_clause_limit;
 extern int  scalar_replace_limit;
 extern int  inline_iter_yield_limit;
@@ -122,6 +124,9 @@ extern const char* CHPL_LLVM_UNIQ_CFG_PATH;
 extern bool  printPasses;
 extern FILE* printPassesFile;
 
+extern char  fProfileCompile[FILENAME_MAX+1];
+extern int   fProfileCompileTop;
+
 extern char fExplainCall[256];
 extern int  explainCallID;
 extern int  breakOnResolveID;
@@ -227,6 +232,7 @@ extern bool fMinimalModules;
 
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
+extern int  fCCompileJobs;
 
 // LLVM flags (-mllvm)
 extern std::string llvmFlags;
@@ -31,6 +31,7 @@ extern char libmodeHeadername[FILENAME_MAX+1];
 extern char fortranModulename[FILENAME_MAX+1];
 extern char pythonModulename[FILENAME_MAX+1];
 extern char saveCDir[FILENAME_MAX+1];
+extern char compileCacheDir[FILENAME_MAX+1];
 extern std::string ccflags;
 extern std::string ldflags;
 extern bool ccwarnings;
@@ -25,6 +25,14 @@ class PhaseTracker;
 void runPasses(PhaseTracker& tracker, bool isChpldoc);
 void initPassesForLogging();
 
+// Time the remainder of the current pass as a separately reported
+// phase.  For passes that do several distinct steps, e.g. makeBinary.
+void startPassPhase(const char* phaseName);
+
+// Add a line of statistics to print after the current pass's time in
+// --print-passes output, e.g. the hit rate of a cache it uses.
+void reportPassStatistic(const char* text);
+
 extern int currentPassNo;
 
 #endif
@@ -22,6 +22,8 @@
 
 #include "vec.h"
 
+#include <vector>
+
 class BlockStmt;
 class CallExpr;
 class CallInfo;
@@ -35,6 +37,9 @@ void       getVisibleFunctions(const char*      name,
                                CallExpr*        call,
                                Vec<FnSymbol*>&  visibleFns);
 
+int        getVisibilityKey(CallInfo&                info,
+                            std::vector<BlockStmt*>& key);
+
 BlockStmt* getVisibilityScope(Expr* expr);
 BlockStmt* getInstantiationPoint(Expr* expr);
 
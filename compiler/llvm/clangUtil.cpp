@@ -28,7 +28,9 @@
 #include <cctype>
 #include <cstring>
 #include <cstdio>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 #ifdef HAVE_LLVM
 #include "clang/AST/GlobalDecl.h"
@@ -55,6 +57,7 @@
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/MC/SubtargetFeature.h"
@@ -66,6 +69,7 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 
 #ifdef HAVE_LLVM_RV
 #include "rv/passes.h"
@@ -79,6 +83,7 @@
 #include "files.h"
 #include "mysystem.h"
 #include "passes.h"
+#include "runpasses.h"
 #include "stmt.h"
 #include "stringutil.h"
 #include "symbol.h"
@@ -2559,6 +2564,72 @@ void checkAdjustedDataLayout() {
   INT_ASSERT(dl.getTypeSizeInBits(testTy) == GLOBAL_PTR_SIZE);
 }
 
+static unsigned llvmCodegenParts() {
+  if (fLLVMCodegenThreads > 0)
+    return fLLVMCodegenThreads;
+
+  unsigned nCores = std::thread::hardware_concurrency();
+  return (nCores > 0) ? nCores : 1;
+}
+
+// Emit the optimized module as nParts object files, the first to
+// 'firstOS' and the rest to new files whose names are added to
+// 'partFilenames'.  llvm::splitCodeGen() splits the module by function
+// and generates code for each part on its own thread, in its own
+// LLVMContext and with its own TargetMachine.  The optimization passes
+// have already run on the whole module, so splitting it loses no
+// inlining.
+static
+void emitObjectFilesInParallel(llvm::raw_pwrite_stream& firstOS,
+                               unsigned nParts,
+                               std::vector<std::string>& partFilenames) {
+  GenInfo* info = gGenInfo;
+  llvm::TargetMachine* tm = info->targetMachine;
+
+  std::vector<std::unique_ptr<llvm::raw_fd_ostream> > partFiles;
+  std::vector<llvm::raw_pwrite_stream*> partOSs;
+
+  partOSs.push_back(&firstOS);
+
+  for (unsigned i = 1; i < nParts; i++) {
+    std::string filename =
+      genIntermediateFilename(astr("chpl__module-part", istr(i), ".o"));
+    std::error_code error;
+
+    partFiles.emplace_back(new llvm::raw_fd_ostream(filename, error,
+                                                    llvm::sys::fs::F_None));
+    if (error || partFiles.back()->has_error())
+      USR_FATAL("Could not open output file %s", filename.c_str());
+
+    partOSs.push_back(partFiles.back().get());
+    partFilenames.push_back(filename);
+  }
+
+  auto tmFactory = [tm]() {
+    return std::unique_ptr<llvm::TargetMachine>(
+        tm->getTarget().createTargetMachine(tm->getTargetTriple().str(),
+                                            tm->getTargetCPU(),
+                                            tm->getTargetFeatureString(),
+                                            tm->Options,
+                                            tm->getRelocationModel(),
+                                            tm->getCodeModel(),
+                                            tm->getOptLevel()));
+  };
+
+  // splitCodeGen() consumes the module it is given, but info->module
+  // belongs to clang's code generator, so split a copy of it.
+#if HAVE_LLVM_VER < 70
+  std::unique_ptr<llvm::Module> copy = llvm::CloneModule(info->module);
+#else
+  std::unique_ptr<llvm::Module> copy = llvm::CloneModule(*info->module);
+#endif
+
+  llvm::splitCodeGen(std::move(copy), partOSs, {}, tmFactory,
+                     llvm::TargetMachine::CGFT_ObjectFile);
+
+  for (size_t i = 0; i < partFiles.size(); i++)
+    partFiles[i]->close();
+}
 
 void makeBinaryLLVM(void) {
 
@@ -2664,6 +2735,7 @@ void makeBinaryLLVM(void) {
   }
 
   // Setup for and run LLVM optimization passes
+  startPassPhase("llvmOptimize");
   {
     adjustLayoutForGlobalToWide();
 
@@ -2759,7 +2831,15 @@ void makeBinaryLLVM(void) {
 
   // Emit the .o file for linking with clang
   // Setup and run LLVM passes to emit a .o file to outputOfile
-  {
+  startPassPhase("llvmCodegen");
+
+  unsigned nCodegenParts = llvmCodegenParts();
+  std::vector<std::string> partFilenames;
+
+  if (nCodegenParts > 1) {
+    emitObjectFilesInParallel(outputOfile, nCodegenParts, partFilenames);
+    outputOfile.close();
+  } else {
     llvm::legacy::PassManager emitPM;
 
     emitPM.add(createTargetTransformInfoWrapperPass(
@@ -2784,6 +2864,8 @@ void makeBinaryLLVM(void) {
     outputOfile.close();
   }
 
+  startPassPhase("llvmLink");
+
   //finishClang is before the call to the debug finalize
   deleteClang(clangInfo);
 
@@ -2979,6 +3061,10 @@ void makeBinaryLLVM(void) {
   // linker override specified by the Makefiles (e.g. setting it to mpicxx)
   std::string command = useLinkCXX + " " + options + " " +
                         moduleFilename + " " + maino;
+  for (size_t i = 0; i < partFilenames.size(); i++) {
+    command += " ";
+    command += partFilenames[i];
+  }
   // For dynamic linking, leave it alone.  For static, append -static .
   // See $CHPL_HOME/make/compiler/Makefile.clang (and keep this in sync
   // with it).
@@ -165,6 +165,11 @@ void PhaseTracker::ReportTotal() const
   Phase::ReportTotal(mTimer.elapsedUsecs());
 }
 
+void PhaseTracker::ReportText(const char* text) const
+{
+  Phase::ReportText(text);
+}
+
 void PhaseTracker::ReportRollup() const
 {
   std::vector<Pass> passes;
@@ -84,6 +84,8 @@ public:
 
   void                 ReportRollup()                                const;
 
+  void                 ReportText  (const char* text)                const;
+
 private:
   void                 PassesCollect(std::vector<Pass>& passes) const;
   
@@ -0,0 +1,516 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compileProfile.h"
+
+#include "AggregateType.h"
+#include "baseAST.h"
+#include "driver.h"
+#include "expr.h"
+#include "FnSymbol.h"
+#include "misc.h"
+#include "stringutil.h"
+#include "symbol.h"
+#include "timer.h"
+#include "type.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+/************************************* | **************************************
+*                                                                             *
+* Per-pass statistics.  RSS is the high-water mark of the compiler process    *
+* up to the end of the pass, so a pass that raises it is one that grew the    *
+* compiler's footprint.                                                       *
+*                                                                             *
+************************************** | *************************************/
+
+#define ast_kind_name(type) #type,
+
+static const char* sAstKindNames[] = {
+  foreach_ast_sep(ast_kind_name, )
+};
+
+#undef ast_kind_name
+
+static const int   sNumAstKinds = sizeof(sAstKindNames) /
+                                  sizeof(sAstKindNames[0]);
+
+struct PassProfile {
+  const char*      name;
+  double           seconds;
+  long             maxRssKiB;
+  int              created;
+  int              removed;
+  std::vector<int> live;            // indexed like sAstKindNames
+};
+
+static Timer                    sTimer;
+
+static std::vector<PassProfile> sPasses;
+
+static unsigned long            sPassStart     = 0;
+static int                      sPassStartId   = 0;
+static int                      sPassStartLive = 0;
+
+static bool profiling() {
+  return fProfileCompile[0] != '\0';
+}
+
+static unsigned long now() {
+  return sTimer.elapsedUsecs();
+}
+
+static void countLiveAst(std::vector<int>& live) {
+#define count_gvec(type) live.push_back(g##type##s.n)
+  foreach_ast(count_gvec);
+#undef count_gvec
+}
+
+static int sum(const std::vector<int>& counts) {
+  int retval = 0;
+
+  for (size_t i = 0; i < counts.size(); i++) {
+    retval = retval + counts[i];
+  }
+
+  return retval;
+}
+
+static long maxRssKiB() {
+  struct rusage usage;
+  long          retval = 0;
+
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    retval = usage.ru_maxrss / 1024;     // bytes on Mac OS X
+#else
+    retval = usage.ru_maxrss;
+#endif
+  }
+
+  return retval;
+}
+
+void profileCompileStartPass(const char* passName) {
+  if (profiling() == true) {
+    std::vector<int> live;
+    PassProfile      pass;
+
+    if (sPasses.size() == 0) {
+      sTimer.start();
+    }
+
+    countLiveAst(live);
+
+    pass.name      = passName;
+    pass.seconds   = 0.0;
+    pass.maxRssKiB = 0;
+    pass.created   = 0;
+    pass.removed   = 0;
+
+    sPasses.push_back(pass);
+
+    sPassStart     = now();
+    sPassStartId   = lastNodeIDUsed();
+    sPassStartLive = sum(live);
+  }
+}
+
+// Called after the pass has cleaned the AST, so the counts are of the
+// nodes that are still live.
+void profileCompileEndPass() {
+  if (profiling() == true && sPasses.size() > 0) {
+    PassProfile& pass = sPasses.back();
+
+    countLiveAst(pass.live);
+
+    pass.seconds   = (now() - sPassStart) / 1e6;
+    pass.maxRssKiB = maxRssKiB();
+    pass.created   = lastNodeIDUsed() - sPassStartId;
+    pass.removed   = sPassStartLive + pass.created - sum(pass.live);
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Instantiations, keyed by the id of the generic they were instantiated from  *
+* rather than its address, as the generic may be pruned before the report is  *
+* written.  The compiler can make several generics from one declaration, e.g. *
+* one per width for a formal like 'int(?w)', so the report merges generics    *
+* with the same name and location.                                            *
+*                                                                             *
+************************************** | *************************************/
+
+struct GenericProfile {
+  const char* kind;
+  const char* name;
+  const char* location;
+  int         instantiations;
+  double      resolveSeconds;       // of all of its instantiations
+};
+
+static std::map<int, GenericProfile> sGenerics;
+
+static const char* locationOf(BaseAST* ast) {
+  const char* retval = "<internal>";
+
+  if (ast->fname() != NULL) {
+    retval = astr(ast->fname(), ":", istr(ast->linenum()));
+  }
+
+  return retval;
+}
+
+static GenericProfile& genericProfile(Symbol* generic) {
+  std::map<int, GenericProfile>::iterator it = sGenerics.find(generic->id);
+
+  if (it == sGenerics.end()) {
+    GenericProfile profile;
+
+    if (FnSymbol* fn = toFnSymbol(generic)) {
+      profile.kind         = "function";
+      profile.name         = toString(fn);
+    } else {
+      profile.kind         = "type";
+      profile.name         = generic->name;
+    }
+
+    profile.location       = locationOf(generic);
+    profile.instantiations = 0;
+    profile.resolveSeconds = 0.0;
+
+    it = sGenerics.insert(std::make_pair(generic->id, profile)).first;
+  }
+
+  return it->second;
+}
+
+static FnSymbol* rootGeneric(FnSymbol* fn) {
+  while (fn->instantiatedFrom != NULL) {
+    fn = fn->instantiatedFrom;
+  }
+
+  return fn;
+}
+
+void profileCompileInstantiation(FnSymbol* generic) {
+  if (profiling() == true) {
+    genericProfile(rootGeneric(generic)).instantiations++;
+  }
+}
+
+void profileCompileInstantiation(AggregateType* generic) {
+  if (profiling() == true) {
+    while (generic->instantiatedFrom != NULL) {
+      generic = generic->instantiatedFrom;
+    }
+
+    genericProfile(generic->symbol).instantiations++;
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Resolution times.  A function's time excludes the time spent resolving the  *
+* functions that it calls, so that a function near the root of the call graph *
+* is not charged for the whole program.                                       *
+*                                                                             *
+* Only the costliest --profile-compile-top functions are kept, in a min-heap  *
+* on their time.                                                              *
+*                                                                             *
+************************************** | *************************************/
+
+struct ResolveFrame {
+  FnSymbol*     fn;
+  unsigned long start;
+  unsigned long children;
+};
+
+struct ResolveProfile {
+  const char* name;
+  const char* location;
+  const char* instantiatedFrom;
+  double      seconds;
+  double      totalSeconds;
+};
+
+static bool isCostlier(const ResolveProfile& a, const ResolveProfile& b) {
+  return a.seconds > b.seconds;
+}
+
+static std::vector<ResolveFrame>   sResolveStack;
+static std::vector<ResolveProfile> sCostliest;
+
+static int                         sNumResolved   = 0;
+static unsigned long               sResolveUsecs  = 0;
+
+// The function's name and its formals' types, which tells apart the
+// instantiations of a generic.
+static const char* signatureOf(FnSymbol* fn) {
+  std::string str   = fn->name;
+  bool        first = true;
+
+  str += "(";
+
+  for_formals(formal, fn) {
+    if (formal->type != dtMethodToken) {
+      if (first == false) {
+        str += ", ";
+      }
+
+      str   += formal->name;
+      str   += ": ";
+      str   += formal->type->symbol->name;
+
+      first  = false;
+    }
+  }
+
+  str += ")";
+
+  return astr(str.c_str());
+}
+
+void profileCompileStartResolve(FnSymbol* fn) {
+  if (profiling() == true) {
+    ResolveFrame frame;
+
+    frame.fn       = fn;
+    frame.start    = now();
+    frame.children = 0;
+
+    sResolveStack.push_back(frame);
+  }
+}
+
+void profileCompileEndResolve(FnSymbol* fn) {
+  if (profiling() == true) {
+    ResolveFrame  frame = sResolveStack.back();
+    unsigned long total = now() - frame.start;
+    double        self  = 0.0;
+
+    // gettimeofday() is not monotonic
+    if (total > frame.children) {
+      self = (total - frame.children) / 1e6;
+    }
+
+    INT_ASSERT(frame.fn == fn);
+
+    sResolveStack.pop_back();
+
+    if (sResolveStack.size() > 0) {
+      sResolveStack.back().children += total;
+    } else {
+      sResolveUsecs = sResolveUsecs + total;
+    }
+
+    sNumResolved++;
+
+    if (fn->instantiatedFrom != NULL) {
+      genericProfile(rootGeneric(fn)).resolveSeconds += self;
+    }
+
+    if ((int) sCostliest.size()  <  fProfileCompileTop ||
+        (sCostliest.size()       >  0                  &&
+         sCostliest.front().seconds < self)) {
+      ResolveProfile profile;
+
+      profile.name             = signatureOf(fn);
+      profile.location         = locationOf(fn);
+      profile.instantiatedFrom = NULL;
+      profile.seconds          = self;
+      profile.totalSeconds     = total / 1e6;
+
+      if (fn->instantiatedFrom != NULL) {
+        profile.instantiatedFrom = locationOf(rootGeneric(fn));
+      }
+
+      if ((int) sCostliest.size() >= fProfileCompileTop) {
+        std::pop_heap(sCostliest.begin(), sCostliest.end(), isCostlier);
+        sCostliest.pop_back();
+      }
+
+      sCostliest.push_back(profile);
+      std::push_heap(sCostliest.begin(), sCostliest.end(), isCostlier);
+    }
+  }
+}
+
+/************************************* | **************************************
+*                                                                             *
+* The report                                                                  *
+*                                                                             *
+************************************** | *************************************/
+
+static void writeString(FILE* fp, const char* str) {
+  fputc('"', fp);
+
+  for (const char* c = str; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      fprintf(fp, "\\%c", *c);
+
+    } else if ((unsigned char) *c < 0x20) {
+      fprintf(fp, "\\u%04x", (unsigned char) *c);
+
+    } else {
+      fputc(*c, fp);
+    }
+  }
+
+  fputc('"', fp);
+}
+
+static void writePasses(FILE* fp) {
+  fprintf(fp, "  \"passes\": [\n");
+
+  for (size_t i = 0; i < sPasses.size(); i++) {
+    const PassProfile& pass = sPasses[i];
+
+    fprintf(fp, "    {\n");
+    fprintf(fp, "      \"name\": ");
+    writeString(fp, pass.name);
+    fprintf(fp, ",\n");
+    fprintf(fp, "      \"seconds\": %.6f,\n", pass.seconds);
+    fprintf(fp, "      \"maxRssKiB\": %ld,\n", pass.maxRssKiB);
+    fprintf(fp, "      \"astNodes\": {\n");
+    fprintf(fp, "        \"live\": %d,\n", sum(pass.live));
+    fprintf(fp, "        \"created\": %d,\n", pass.created);
+    fprintf(fp, "        \"removed\": %d,\n", pass.removed);
+    fprintf(fp, "        \"byKind\": {");
+
+    for (int k = 0; k < sNumAstKinds && k < (int) pass.live.size(); k++) {
+      fprintf(fp, "%s\"%s\": %d",
+              (k == 0) ? "" : ", ", sAstKindNames[k], pass.live[k]);
+    }
+
+    fprintf(fp, "}\n");
+    fprintf(fp, "      }\n");
+    fprintf(fp, "    }%s\n", (i + 1 < sPasses.size()) ? "," : "");
+  }
+
+  fprintf(fp, "  ],\n");
+}
+
+static void writeResolution(FILE* fp) {
+  std::vector<ResolveProfile> costliest = sCostliest;
+
+  std::sort(costliest.begin(), costliest.end(), isCostlier);
+
+  fprintf(fp, "  \"resolution\": {\n");
+  fprintf(fp, "    \"functions\": %d,\n", sNumResolved);
+  fprintf(fp, "    \"seconds\": %.6f,\n", sResolveUsecs / 1e6);
+  fprintf(fp, "    \"costliest\": [\n");
+
+  for (size_t i = 0; i < costliest.size(); i++) {
+    const ResolveProfile& profile = costliest[i];
+
+    fprintf(fp, "      {\"function\": ");
+    writeString(fp, profile.name);
+    fprintf(fp, ", \"location\": ");
+    writeString(fp, profile.location);
+
+    if (profile.instantiatedFrom != NULL) {
+      fprintf(fp, ", \"instantiatedFrom\": ");
+      writeString(fp, profile.instantiatedFrom);
+    }
+
+    fprintf(fp, ", \"seconds\": %.6f, \"totalSeconds\": %.6f}%s\n",
+            profile.seconds,
+            profile.totalSeconds,
+            (i + 1 < costliest.size()) ? "," : "");
+  }
+
+  fprintf(fp, "    ]\n");
+  fprintf(fp, "  },\n");
+}
+
+static bool hasMoreInstantiations(const GenericProfile& a,
+                                  const GenericProfile& b) {
+  return a.instantiations > b.instantiations;
+}
+
+static void writeGenerics(FILE* fp) {
+  std::vector<GenericProfile>             generics;
+  std::map<std::string, size_t>           indices;
+  std::map<int, GenericProfile>::iterator it;
+
+  for (it = sGenerics.begin(); it != sGenerics.end(); it++) {
+    const GenericProfile& profile = it->second;
+    std::string           key     = profile.kind;
+
+    key = key + " " + profile.name + " " + profile.location;
+
+    if (indices.count(key) == 0) {
+      indices[key] = generics.size();
+      generics.push_back(profile);
+
+    } else {
+      GenericProfile& merged = generics[indices[key]];
+
+      merged.instantiations = merged.instantiations + profile.instantiations;
+      merged.resolveSeconds = merged.resolveSeconds + profile.resolveSeconds;
+    }
+  }
+
+  // Stable, so that ties stay in the order the generics were created.
+  std::stable_sort(generics.begin(), generics.end(), hasMoreInstantiations);
+
+  fprintf(fp, "  \"generics\": [\n");
+
+  for (size_t i = 0; i < generics.size(); i++) {
+    const GenericProfile& profile = generics[i];
+
+    fprintf(fp, "    {\"kind\": \"%s\", \"name\": ", profile.kind);
+    writeString(fp, profile.name);
+    fprintf(fp, ", \"location\": ");
+    writeString(fp, profile.location);
+    fprintf(fp, ", \"instantiations\": %d, \"resolveSeconds\": %.6f}%s\n",
+            profile.instantiations,
+            profile.resolveSeconds,
+            (i + 1 < generics.size()) ? "," : "");
+  }
+
+  fprintf(fp, "  ]\n");
+}
+
+void writeCompileProfile() {
+  if (profiling() == true) {
+    FILE* fp = fopen(fProfileCompile, "w");
+
+    if (fp == NULL) {
+      USR_WARN("Error opening profile file: %s.", fProfileCompile);
+
+    } else {
+      fprintf(fp, "{\n");
+
+      writePasses(fp);
+      writeResolution(fp);
+      writeGenerics(fp);
+
+      fprintf(fp, "}\n");
+
+      fclose(fp);
+    }
+  }
+}
@@ -145,6 +145,7 @@ bool fNoNilChecks = false;
 bool fNoStackChecks = false;
 bool fNoInferLocalFields = false;
 bool fReplaceArrayAccessesWithRefTemps = false;
+bool fResolutionCache = false;
 bool fUserSetStackChecks = false;
 bool fNoCastChecks = false;
 bool fMungeUserIdents = true;
@@ -153,9 +154,16 @@ bool fEnableTaskTracking = false;
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
 
+char fProfileCompile[FILENAME_MAX+1] = "";
+int  fProfileCompileTop = 25;
+
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
 
+// number of threads (and module partitions) for LLVM code generation,
+// 0 for one per core
+int fLLVMCodegenThreads = 1;
+
 bool fWarnConstLoops = true;
 bool fWarnUnstable = false;
 bool fDefaultUnmanaged = false;
@@ -177,6 +185,10 @@ bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
 
+// number of files to split the generated C code over and compile in
+// parallel, 0 for one per core
+int fCCompileJobs = 1;
+
 int optimize_on_clause_limit = 20;
 int scalar_replace_limit = 8;
 int inline_iter_yield_limit = 10;
@@ -657,6 +669,15 @@ static void verifySaveCDir(const ArgumentDescription* desc, const char* unused)
   }
 }
 
+static void verifyCompileCacheDir(const ArgumentDescription* desc,
+                                  const char* unused) {
+  if (compileCacheDir[0] == '-') {
+    USR_FATAL("--compile-cache-dir takes a directory name as its argument\n"
+              "       (you specified '%s', assumed to be another flag)",
+              compileCacheDir);
+  }
+}
+
 static void setLibmode(const ArgumentDescription* desc, const char* unused);
 
 static void verifySaveLibDir(const ArgumentDescription* desc, const char* unused) {
@@ -928,7 +949,9 @@ static ArgumentDescription arg_desc[] = {
  {"savec", ' ', "<directory>", "Save generated C code in directory", "P", saveCDir, "CHPL_SAVEC_DIR", verifySaveCDir},
 
  {"", ' ', NULL, "C Code Compilation Options", NULL, NULL, NULL, NULL},
+ {"c-compile-jobs", ' ', "<n>", "Split the generated C code into <n> files and compile them in parallel, 0 for one per core", "I", &fCCompileJobs, "CHPL_C_COMPILE_JOBS", NULL},
  {"ccflags", ' ', "<flags>", "Back-end C compiler flags (can be specified multiple times)", "S", NULL, "CHPL_CC_FLAGS", setCCFlags},
+ {"compile-cache-dir", ' ', "<directory>", "Reuse back-end objects for unchanged generated C files from directory", "P", compileCacheDir, "CHPL_COMPILE_CACHE_DIR", verifyCompileCacheDir},
  {"debug", 'g', NULL, "[Don't] Support debugging of generated C code", "N", &debugCCode, "CHPL_DEBUG", setChapelDebug},
  {"dynamic", ' ', NULL, "Generate a dynamically linked binary", "F", &fLinkStyle, NULL, setDynamicLink},
  {"hdr-search-path", 'I', "<directory>", "C header search path", "P", incFilename, "CHPL_INCLUDE_PATH", handleIncDir},
@@ -942,6 +965,7 @@ static ArgumentDescription arg_desc[] = {
 
  {"", ' ', NULL, "LLVM Code Generation Options", NULL, NULL, NULL, NULL},
  {"llvm", ' ', NULL, "[Don't] use the LLVM code generator", "N", &llvmCodegen, "CHPL_LLVM_CODEGEN", NULL},
+ {"llvm-codegen-threads", ' ', "<n>", "Split the optimized LLVM module into <n> parts and generate code for them in parallel, 0 for one per core", "I", &fLLVMCodegenThreads, "CHPL_LLVM_CODEGEN_THREADS", NULL},
  {"llvm-wide-opt", ' ', NULL, "Enable [disable] LLVM wide pointer optimizations", "N", &fLLVMWideOpt, "CHPL_LLVM_WIDE_OPTS", NULL},
  {"mllvm", ' ', "<flags>", "LLVM flags (can be specified multiple times)", "S", NULL, "CHPL_MLLVM", setLLVMFlags},
 
@@ -949,6 +973,8 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"profile-compile", ' ', "<filename>", "Write a JSON profile of the compiler's time and memory to <filename>", "P", fProfileCompile, "CHPL_PROFILE_COMPILE", NULL},
+ {"profile-compile-top", ' ', "<n>", "Report the <n> costliest functions to resolve in the profile", "I", &fProfileCompileTop, "CHPL_PROFILE_COMPILE_TOP", NULL},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -1071,6 +1097,7 @@ static ArgumentDescription arg_desc[] = {
  {"remove-empty-records", ' ', NULL, "Enable [disable] empty record removal", "n", &fNoRemoveEmptyRecords, "CHPL_DISABLE_REMOVE_EMPTY_RECORDS", NULL},
  {"remove-unreachable-blocks", ' ', NULL, "[Don't] remove unreachable blocks after resolution", "N", &fRemoveUnreachableBlocks, "CHPL_REMOVE_UNREACHABLE_BLOCKS", NULL},
  {"replace-array-accesses-with-ref-temps", ' ', NULL, "Enable [disable] replacing array accesses with reference temps (experimental)", "N", &fReplaceArrayAccessesWithRefTemps, NULL, NULL },
+ {"resolution-cache", ' ', NULL, "Enable [disable] reusing the resolution of calls with the same signature (experimental)", "N", &fResolutionCache, "CHPL_RESOLUTION_CACHE", NULL},
  {"incremental", ' ', NULL, "Enable [disable] using incremental compilation", "N", &fIncrementalCompilation, "CHPL_INCREMENTAL_COMP", NULL},
  {"minimal-modules", ' ', NULL, "Enable [disable] using minimal modules",               "N", &fMinimalModules, "CHPL_MINIMAL_MODULES", NULL},
  {"print-chpl-settings", ' ', NULL, "Print current chapel settings and exit", "F", &fPrintChplSettings, NULL,NULL},
@@ -1372,6 +1399,9 @@ static void checkLLVMCodeGen() {
 #ifndef HAVE_LLVM
  if (llvmCodegen) USR_FATAL("This compiler was built without LLVM support");
 #endif
+
+  if (fLLVMCodegenThreads < 0)
+    USR_FATAL("--llvm-codegen-threads must be 0 or more");
 }
 
 static void checkTargetCpu() {
@@ -1382,6 +1412,11 @@ static void checkTargetCpu() {
   }
 }
 
+static void checkCCompileJobs() {
+  if (fCCompileJobs < 0)
+    USR_FATAL("--c-compile-jobs must be 0 or more");
+}
+
 static void checkIncrementalAndOptimized() {
   std::size_t optimizationsEnabled = ccflags.find("-O");
   if(fIncrementalCompilation && ( optimizeCCode ||
@@ -1412,6 +1447,8 @@ static void postprocess_args() {
 
   checkTargetCpu();
 
+  checkCCompileJobs();
+
   checkIncrementalAndOptimized();
 }
 
@@ -20,6 +20,7 @@
 #include "runpasses.h"
 
 #include "checks.h"
+#include "compileProfile.h"
 #include "driver.h"
 #include "log.h"
 #include "parser.h"
@@ -27,10 +28,16 @@
 #include "PhaseTracker.h"
 
 #include <cstdio>
+#include <string>
 #include <sys/time.h>
+#include <vector>
 
 int   currentPassNo   = 1;
 
+static PhaseTracker* sTracker = NULL;
+
+static std::vector<std::string> sPassStatistics;
+
 struct PassInfo {
   void (*passFunction) ();      // The function which implements the pass.
   void (*checkFunction)();      // per-pass check function
@@ -161,6 +168,8 @@ void runPasses(PhaseTracker& tracker, bool isChpldoc) {
 
   setupLogfiles();
 
+  sTracker = &tracker;
+
   if (printPasses == true || printPassesFile != 0) {
     tracker.ReportPass();
   }
@@ -188,10 +197,41 @@ void runPasses(PhaseTracker& tracker, bool isChpldoc) {
     }
   }
 
+  sTracker = NULL;
+
+  writeCompileProfile();
+
   destroyAst();
   teardownLogfiles();
 }
 
+void startPassPhase(const char* phaseName) {
+  if (sTracker == NULL)
+    return;
+
+  // Report the part of the pass that has finished, as runPass() will
+  // only report the last part.
+  if (printPasses == true || printPassesFile != 0) {
+    sTracker->ReportPass();
+  }
+
+  sTracker->StartPhase(phaseName, PhaseTracker::kPrimary);
+}
+
+void reportPassStatistic(const char* text) {
+  sPassStatistics.push_back(text);
+}
+
+static void reportPassStatistics(PhaseTracker& tracker) {
+  for (size_t i = 0; i < sPassStatistics.size(); i++) {
+    char line[256];
+
+    snprintf(line, sizeof(line), "%35s%s\n", "", sPassStatistics[i].c_str());
+
+    tracker.ReportText(line);
+  }
+}
+
 static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
   PassInfo* info = &sPassList[passIndex];
 
@@ -200,6 +240,7 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
   //
 
   tracker.StartPhase(info->name, PhaseTracker::kPrimary);
+  profileCompileStartPass(info->name);
 
   if (fPrintStatistics[0] != '\0' && passIndex > 0)
     printStatistics("clean");
@@ -234,9 +275,14 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
     cleanAst();
   }
 
+  profileCompileEndPass();
+
   if (printPasses == true || printPassesFile != 0) {
     tracker.ReportPass();
+    reportPassStatistics(tracker);
   }
+
+  sPassStatistics.clear();
 }
 
 //
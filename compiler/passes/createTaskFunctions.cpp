@@ -364,6 +364,7 @@ static void addReduceIntentSupport(FnSymbol* fn, CallExpr* call,
                                  new NamedExpr(astr_chpl_manager,
                                              new SymExpr(dtUnmanaged->symbol)));
   headAnchor->insertBefore(new CallExpr(PRIM_MOVE, globalOp, newOp));
+  headAnchor->insertBefore(new CallExpr("chpl__reduceTreeInit", globalOp));
 
   insertInitialAccumulate(headAnchor, globalOp, origSym);
 
@@ -374,6 +375,8 @@ static void addReduceIntentSupport(FnSymbol* fn, CallExpr* call,
                          globalOp);
   tailAnchor->insertAfter("'='(%S, generate(%S,%S))",
                          origSym, gMethodToken, globalOp);
+  tailAnchor->insertAfter("chpl__reduceTreeFini(%S)",
+                         globalOp);
 
   ArgSymbol* parentOp = new ArgSymbol(INTENT_BLANK, "reduceParent", dtUnknown);
   newFormal = parentOp;
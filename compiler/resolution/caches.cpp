@@ -196,3 +196,43 @@ static bool isCacheEntryMatch(Vec<Symbol*>* vec1, Vec<Symbol*>* vec2) {
 }
 
 
+
+/************************************* | **************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+************************************** | *************************************/
+
+CallResolutionCache callResolutionCache;
+
+bool CallSignature::operator<(const CallSignature& other) const {
+  if (name        != other.name)        return name        < other.name;
+  if (methodTag   != other.methodTag)   return methodTag   < other.methodTag;
+  if (version     != other.version)     return version     < other.version;
+  if (scope       != other.scope)       return scope       < other.scope;
+  if (actualNames != other.actualNames) return actualNames < other.actualNames;
+
+  return actuals < other.actuals;
+}
+
+
+void
+addCache(CallResolutionCache& cache,
+         const CallSignature& signature,
+         FnSymbol*            fn) {
+  cache[signature] = fn;
+}
+
+
+FnSymbol*
+checkCache(CallResolutionCache& cache, const CallSignature& signature) {
+  CallResolutionCache::iterator it = cache.find(signature);
+
+  return (it != cache.end()) ? it->second : NULL;
+}
+
+
+void
+freeCache(CallResolutionCache& cache) {
+  cache.clear();
+}
@@ -22,6 +22,9 @@
 
 #include "baseAST.h"
 
+#include <map>
+#include <vector>
+
 //
 // SymbolMapCache: FnSymbol -> FnSymbol cache based on a SymbolMap
 //
@@ -124,4 +127,47 @@ void      freeCache(SymbolVecCache& cache);
 //
 extern SymbolVecCache defaultsCache;
 
+//
+// CallResolutionCache: call signature -> FnSymbol cache
+//
+//   A CallSignature records what decides how a call resolves: its
+//   name, the functions visible to it, and its actuals.  Each actual
+//   is recorded as its type, or as the actual itself when more than
+//   its type matters (e.g. a param).  Calls with the same signature
+//   resolve to the same function, so once one of them has, the rest
+//   can skip finding and filtering the candidates.
+//
+//   Signatures also record the version of the visible function tables
+//   they were computed against, so entries go stale when new visible
+//   functions are added.
+//
+class CallSignature {
+public:
+  bool                     operator<(const CallSignature& other) const;
+
+  const char*              name;
+  bool                     methodTag;
+  int                      version;
+  std::vector<BlockStmt*>  scope;
+  std::vector<const char*> actualNames;
+  std::vector<BaseAST*>    actuals;
+};
+
+typedef std::map<CallSignature, FnSymbol*> CallResolutionCache;
+
+
+void      addCache(CallResolutionCache& cache,
+                   const CallSignature& signature,
+                   FnSymbol*            fn);
+
+FnSymbol* checkCache(CallResolutionCache& cache,
+                     const CallSignature& signature);
+
+void      freeCache(CallResolutionCache& cache);
+
+//
+// Unlike the caches above, this cache is only for performance
+//
+extern CallResolutionCache callResolutionCache;
+
 #endif
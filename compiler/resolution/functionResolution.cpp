@@ -50,6 +50,7 @@
 #include "ResolutionCandidate.h"
 #include "resolveFunction.h"
 #include "resolveIntents.h"
+#include "runpasses.h"
 #include "scopeResolve.h"
 #include "stlUtil.h"
 #include "stringutil.h"
@@ -2189,6 +2190,13 @@ static void      resolveNormalCallConstRef(CallExpr* call);
 
 static void      resolveNormalCallFinalChecks(CallExpr* call);
 
+static bool      getCallSignature(CallInfo&      info,
+                                  CallSignature& signature);
+
+static ResolutionCandidate* checkCallResolutionCache(
+                                  CallInfo&            info,
+                                  const CallSignature& signature);
+
 static FnSymbol* wrapAndCleanUpActuals(ResolutionCandidate* best,
                                        CallInfo&            info,
                                        bool                 followerChecks);
@@ -2257,6 +2265,20 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
 
   FnSymbol*                 retval     = NULL;
 
+  CallSignature             signature;
+  bool                      cacheable  = getCallSignature(info, signature);
+
+  if (cacheable == true) {
+    if (ResolutionCandidate* best = checkCallResolutionCache(info,
+                                                             signature)) {
+      retval = resolveNormalCall(info, checkOnly, best);
+
+      delete best;
+
+      return retval;
+    }
+  }
+
   findVisibleFunctionsAndCandidates(info, mostApplicable, candidates);
 
   numMatches = disambiguateByMatch(info,
@@ -2308,6 +2330,10 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
       best = bestCref;
     }
 
+    if (cacheable == true) {
+      addCache(callResolutionCache, signature, best->fn);
+    }
+
     retval = resolveNormalCall(info, checkOnly, best);
 
   } else {
@@ -2502,6 +2528,111 @@ static FnSymbol* resolveNormalCall(CallInfo&            info,
   return retval;
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Cache the function that a call resolves to, by the call's signature, so     *
+* that resolving another call with the same signature only has to check that  *
+* function instead of finding and filtering all of the candidates.  This is   *
+* common for calls in generic code, where every instantiation of a function   *
+* repeats the calls in its body.                                              *
+*                                                                             *
+* Only calls that resolve to a single function are cached.                    *
+*                                                                             *
+************************************** | *************************************/
+
+static int nCallResolutionCacheLookups = 0;
+static int nCallResolutionCacheHits    = 0;
+
+static bool getCallSignature(CallInfo& info, CallSignature& signature) {
+  CallExpr* call = info.call;
+
+  if (fResolutionCache         == false ||
+      resolved                 == true  ||
+      call->isResolved()       == true  ||
+      call->partialTag         == true  ||
+      explainCallLine          != 0     ||
+      explainCallID            != -1    ||
+      breakOnResolveID         != -1) {
+    return false;
+  }
+
+  signature.name      = info.name;
+  signature.methodTag = call->methodTag;
+  signature.version   = getVisibilityKey(info, signature.scope);
+
+  for (int i = 0; i < info.actuals.n; i++) {
+    Symbol* actual = info.actuals.v[i];
+    Type*   type   = actual->type;
+
+    if (type == dtUnknown) {
+      return false;
+    }
+
+    signature.actualNames.push_back(info.actualNames.v[i]);
+
+    // Where more than the actual's type can matter, e.g. the value of a
+    // param, use the actual itself.
+    if ((isVarSymbol(actual) == false && isArgSymbol(actual) == false) ||
+        actual->isParameter()                   == true                ||
+        type->symbol->hasFlag(FLAG_GENERIC)     == true) {
+      signature.actuals.push_back(actual);
+
+    } else if (actual->hasFlag(FLAG_TYPE_VARIABLE) == true) {
+      signature.actuals.push_back(type->symbol);
+
+    } else {
+      signature.actuals.push_back(type);
+    }
+  }
+
+  return true;
+}
+
+static ResolutionCandidate* checkCallResolutionCache(
+                                      CallInfo&            info,
+                                      const CallSignature& signature) {
+  ResolutionCandidate* retval = NULL;
+
+  nCallResolutionCacheLookups++;
+
+  if (FnSymbol* fn = checkCache(callResolutionCache, signature)) {
+    if (fn->inTree() == true) {
+      ResolutionCandidate* candidate = new ResolutionCandidate(fn);
+
+      if (candidate->isApplicable(info) == true) {
+        retval = candidate;
+
+        nCallResolutionCacheHits++;
+
+      } else {
+        delete candidate;
+      }
+    }
+  }
+
+  return retval;
+}
+
+static void reportCallResolutionCache() {
+  char text[128];
+
+  snprintf(text, sizeof(text),
+           "call resolution cache: %d of %d lookups hit (%.1f%%)",
+           nCallResolutionCacheHits,
+           nCallResolutionCacheLookups,
+           (nCallResolutionCacheLookups > 0) ?
+             100.0 * nCallResolutionCacheHits / nCallResolutionCacheLookups :
+             0.0);
+
+  reportPassStatistic(text);
+}
+
+/************************************* | **************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+************************************** | *************************************/
+
 static void resolveNormalCallConstRef(CallExpr* call) {
   FnSymbol* fn = call->resolvedFunction();
 
@@ -7012,6 +7143,10 @@ void resolve() {
   freeCache(genericsCache);
   freeCache(promotionsCache);
 
+  if (fResolutionCache)
+    reportCallResolutionCache();
+  freeCache(callResolutionCache);
+
   visibleFunctionsClear();
 
   std::map<int, SymbolMap*>::iterator it;
@@ -22,6 +22,7 @@
 #include "astutil.h"
 #include "caches.h"
 #include "chpl.h"
+#include "compileProfile.h"
 #include "driver.h"
 #include "expr.h"
 #include "PartialCopyData.h"
@@ -385,6 +386,8 @@ static AggregateType* instantiateTypeForTypeConstructor(FnSymbol*      fn,
   } else if (AggregateType* at = toAggregateType(fn->retType)) {
     newCt->instantiatedFrom = at;
 
+    profileCompileInstantiation(at);
+
   } else {
     INT_ASSERT(false);
   }
@@ -694,6 +697,8 @@ FnSymbol* instantiateFunction(FnSymbol*  fn,
   newFn->instantiatedFrom = fn;
   newFn->substitutions.map_union(allSubs);
 
+  profileCompileInstantiation(root);
+
   if (call) {
     newFn->setInstantiationPoint(call);
   }
@@ -472,6 +472,7 @@ static void setupForReduce(ForallStmt* fs,
   holder1->insertAtTail(new DefExpr(globalAS));
   insertInitialization(holder1, globalAS,
                        new_Expr("identity(%S,%S)", gMethodToken, globalRP));
+  holder1->insertAtTail("chpl__reduceTreeInit(%S)", globalRP);
   resolveBlockStmt(holder1);
   PAS->type = globalAS->type; // now that we know it
   holder1->flattenAndRemove();
@@ -479,6 +480,7 @@ static void setupForReduce(ForallStmt* fs,
   /// after the forall ///
   BlockStmt* holder2 = new BlockStmt();
   fs->insertAfter(holder2);
+  holder2->insertAtTail("chpl__reduceTreeFini(%S)", globalRP);
   holder2->insertAtTail("accumulate(%S,%S,%S)",
                         gMethodToken, globalRP, globalAS);
   insertDeinitialization(holder2, globalAS);
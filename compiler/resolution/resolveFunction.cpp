@@ -22,6 +22,7 @@
 #include "astutil.h"
 #include "CatchStmt.h"
 #include "CForLoop.h"
+#include "compileProfile.h"
 #include "DeferStmt.h"
 #include "driver.h"
 #include "expr.h"
@@ -468,6 +469,8 @@ void resolveFunction(FnSymbol* fn, CallExpr* forCall) {
 
     fn->addFlag(FLAG_RESOLVED);
 
+    profileCompileStartResolve(fn);
+
     if (strcmp(fn->name, "init") == 0 && fn->isMethod()) {
       AggregateType* at = toAggregateType(fn->_this->getValType());
       if (at->symbol->hasFlag(FLAG_GENERIC) == false) {
@@ -517,6 +520,8 @@ void resolveFunction(FnSymbol* fn, CallExpr* forCall) {
         fn->removeFlag(FLAG_RESOLVED);
       }
     }
+
+    profileCompileEndResolve(fn);
   }
 }
 
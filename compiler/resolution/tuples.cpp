@@ -26,6 +26,7 @@
 #include "astutil.h"
 #include "caches.h"
 #include "chpl.h"
+#include "compileProfile.h"
 #include "driver.h"
 #include "expr.h"
 #include "passes.h"
@@ -384,6 +385,8 @@ TupleInfo getTupleInfo(std::vector<TypeSymbol*>& args,
 
     newType->instantiatedFrom = dtTuple;
 
+    profileCompileInstantiation(dtTuple);
+
     forv_Vec(AggregateType, t, dtTuple->dispatchParents) {
       AggregateType* at = toAggregateType(t);
 
@@ -30,8 +30,10 @@
 #include "symbol.h"
 #include "view.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 
 /*
@@ -62,6 +64,10 @@ static Map<BlockStmt*, VisibleFunctionBlock*> visibleFunctionMap;
 
 static int                                    nVisibleFunctions       = 0;
 
+// Bumped whenever a function is added to visibleFunctionMap, so that
+// anything derived from the map can tell when it is stale.
+static int                                    visibleFunctionsVersion = 0;
+
 
 
 /************************************* | **************************************
@@ -126,6 +132,7 @@ void findVisibleFunctions(CallInfo&       info,
 
 
 static void buildVisibleFunctionMap() {
+  bool added = false;
   for (int i = nVisibleFunctions; i < gFnSymbols.n; i++) {
     FnSymbol* fn = gFnSymbols.v[i];
     if (!fn->hasFlag(FLAG_INVISIBLE_FN) && fn->inTree() && !isArgSymbol(fn->defPoint->parentSymbol)) {
@@ -151,8 +158,14 @@ static void buildVisibleFunctionMap() {
         vfb->visibleFunctions.put(fn->name, fns);
       }
       fns->add(fn);
+
+      added = true;
     }
   }
+  if (added == true) {
+    visibleFunctionsVersion++;
+  }
+
   nVisibleFunctions = gFnSymbols.n;
 }
 
@@ -318,6 +331,123 @@ static void getVisibleFunctions(const char*           name,
   }
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Computes a key for the set of functions visible from a call, for caching    *
+* the results of resolving it.  getVisibleFunctions() walks up from the       *
+* call's visibility scope, through used modules and instantiation points.     *
+* Most blocks on that walk, e.g. the bodies of the many instantiations of a   *
+* generic function, neither define functions nor 'use' modules, and add      *
+* nothing but the blocks they lead to.  The key skips those blocks and lists  *
+* the ones that the rest of the walk starts from, so that calls in different  *
+* blocks that see the same functions get the same key.                        *
+*                                                                             *
+* A block is only skipped if the next block enclosing it is not scopeless,    *
+* since functions defined in a scopeless block affect isMoreVisible() for     *
+* the calls under it.  Module blocks are never skipped, so the first block    *
+* in the key is one that the call is lexically within.                        *
+*                                                                             *
+* Returns the version of visibleFunctionMap that the key is valid for, which  *
+* visibleFunctionsClear() also invalidates.                                   *
+*                                                                             *
+************************************** | *************************************/
+
+static void getVisibilityKey(BlockStmt*               block,
+                             std::vector<BlockStmt*>& visited,
+                             std::vector<BlockStmt*>& key);
+
+static bool isSkippableVisibilityScope(BlockStmt* block);
+
+int getVisibilityKey(CallInfo& info, std::vector<BlockStmt*>& key) {
+  if (gFnSymbols.n != nVisibleFunctions) {
+    buildVisibleFunctionMap();
+  }
+
+  if (info.scope != NULL) {
+    // An explicitly qualified call, e.g. M.f(), only sees M.
+    key.push_back(NULL);
+    key.push_back(info.scope);
+
+  } else {
+    // The walk is short, so a vector is cheaper than a set here.
+    std::vector<BlockStmt*> visited;
+
+    getVisibilityKey(getVisibilityScope(info.call), visited, key);
+  }
+
+  return visibleFunctionsVersion;
+}
+
+static void getVisibilityKey(BlockStmt*               block,
+                             std::vector<BlockStmt*>& visited,
+                             std::vector<BlockStmt*>& key) {
+  if (standardModuleSet.set_in(block) != NULL) {
+    block = theProgram->block;
+  }
+
+  if (std::find(visited.begin(), visited.end(), block) == visited.end()) {
+    visited.push_back(block);
+
+    if (isSkippableVisibilityScope(block) == false) {
+      key.push_back(block);
+
+    } else {
+      FnSymbol* inFn = block->getFunction();
+
+      getVisibilityKey(getVisibilityScope(block), visited, key);
+
+      if (block->parentExpr == NULL) {
+        if (BlockStmt* instantiationPt = inFn->instantiationPoint()) {
+          getVisibilityKey(instantiationPt, visited, key);
+        }
+      }
+    }
+  }
+}
+
+static bool isSkippableVisibilityScope(BlockStmt* block) {
+  Expr* cur    = NULL;
+  bool  retval = false;
+
+  if (block->useList                != NULL ||
+      visibleFunctionMap.get(block) != NULL ||
+      block                         == rootModule->block) {
+    cur = NULL;
+
+  } else if (block->parentExpr != NULL) {
+    cur = block;
+
+  } else if (FnSymbol* inFn = toFnSymbol(block->parentSymbol)) {
+    BlockStmt* instantiationPt = inFn->instantiationPoint();
+
+    // Leave an instantiation point that is not in the tree for
+    // getVisibleFunctions() to complain about.
+    if (instantiationPt == NULL || instantiationPt->parentSymbol != NULL) {
+      cur = inFn->defPoint;
+    }
+  }
+
+  if (cur != NULL) {
+    Expr* parent = cur->parentExpr;
+
+    while (parent != NULL && isBlockStmt(parent) == false) {
+      parent = parent->parentExpr;
+    }
+
+    if (BlockStmt* parentBlock = toBlockStmt(parent)) {
+      retval = parentBlock->blockTag != BLOCK_SCOPELESS;
+    }
+  }
+
+  return retval;
+}
+
+/************************************* | **************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+************************************** | *************************************/
+
 static bool isTryTokenCond(Expr* expr);
 
 static Expr* getTryTokenParent(Expr* expr);
@@ -460,6 +590,8 @@ void visibleFunctionsClear() {
   }
 
   visibleFunctionMap.clear();
+
+  visibleFunctionsVersion++;
 }
 
 /************************************* | **************************************
@@ -60,6 +60,7 @@ char libmodeHeadername[FILENAME_MAX + 1]  = "";
 char fortranModulename[FILENAME_MAX + 1]  = "";
 char pythonModulename[FILENAME_MAX + 1]   = "";
 char saveCDir[FILENAME_MAX + 1]           = "";
+char compileCacheDir[FILENAME_MAX + 1]    = "";
 
 std::string ccflags;
 std::string ldflags;
@@ -655,6 +656,9 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
   fprintf(makefile.fptr, "CHPL_MAKE_THIRD_PARTY = %s\n\n", CHPL_THIRD_PARTY);
   fprintf(makefile.fptr, "TMPDIRNAME = %s\n\n", tmpDirName);
 
+  if (compileCacheDir[0] != '\0')
+    fprintf(makefile.fptr, "CHPL_COMPILE_CACHE_DIR = %s\n\n", compileCacheDir);
+
   // Store the chplenv in the makefile cache
   for (std::map<std::string, const char*>::iterator env=envMap.begin(); env!=envMap.end(); ++env)
   {
@@ -1414,6 +1414,67 @@ private proc _doSimpleBlockTransfer(Dest, destDom, Src, srcDom) {
   if debugBlockDistBulkTransfer then writeln("Comms:",getCommDiagnostics());
 }
 
+//
+// Parallel scan of a 1D Block-distributed array, called by
+// chpl__scanIterator().  Each locale first scans its local block in
+// parallel (see DefaultRectangularArr.doiScan()).  The per-locale
+// totals are then scanned serially, and finally each locale folds the
+// total of the blocks before it into its local results.  The passes
+// are separate coforalls, rather than one coforall with a barrier, so
+// that the scan still completes when the coforalls are serialized.
+//
+proc BlockArr.doiScan(op, resDom) where (rank == 1) &&
+                                        chpl__scanStateResTypesMatch(op) {
+  type resType = op.generate().type;
+  type rngType = range(idxType, BoundedRangeType.bounded, stridable);
+  var res: [resDom] resType;
+
+  const targetLocDom = dom.dist.targetLocDom;
+  const backward = resDom.dim(1).stride < 0;
+  var locTotals: [targetLocDom] resType;
+  var locChunks: [targetLocDom] unmanaged chpl__ScanChunks(rngType, resType);
+
+  coforall locid in targetLocDom do on dom.dist.targetLocales(locid) {
+    const myop = op.clone();
+    const ref myElems = locArr[locid].myElems;
+    ref myRes = res._value.locArr[locid].myElems;
+
+    const (numTasks, rngs, state, total) =
+      myElems._value.chpl__preScan(myop, myRes, myElems.domain);
+    locChunks[locid] = new unmanaged chpl__ScanChunks(rngType, resType,
+                                                      numTasks, rngs, state);
+    locTotals[locid] = total;
+    delete myop;
+  }
+
+  const metaop = op.clone();
+  var next: resType = metaop.identity;
+  for i in targetLocDom.dim(1) by (if backward then -1 else 1) {
+    locTotals[i] <=> next;
+    metaop.accumulateOntoState(next, locTotals[i]);
+  }
+  delete metaop;
+
+  coforall locid in targetLocDom do on dom.dist.targetLocales(locid) {
+    const myop = op.clone();
+    ref myRes = res._value.locArr[locid].myElems;
+    const chunks = locChunks[locid];
+
+    const myadjust = locTotals[locid];
+    for s in chunks.state do
+      myop.accumulateOntoState(s, myadjust);
+    locArr[locid].myElems._value.chpl__postScan(myop, myRes,
+                                                chunks.numTasks,
+                                                chunks.rngs, chunks.state,
+                                                adjustFirst=true);
+    delete chunks;
+    delete myop;
+  }
+
+  delete op;
+  return res;
+}
+
 proc BlockArr.dsiTargetLocales() {
   return dom.dist.targetLocales;
 }
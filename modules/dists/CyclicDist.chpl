@@ -1162,6 +1162,106 @@ where useBulkTransferDist {
   return true;
 }
 
+//
+// One locale's block of the indices in CyclicArr.doiScan(), with its
+// results and chunks, kept between the passes of the scan.
+//
+class CyclicScanBlock {
+  type idxType;
+  param stridable: bool;
+  type resType;
+  var inds: domain(1, idxType, stridable);
+  var res: [inds] resType;
+  var chunks: unmanaged chpl__ScanChunks(range(idxType,
+                                               BoundedRangeType.bounded,
+                                               stridable),
+                                         resType);
+}
+
+//
+// Parallel scan of a 1D Cyclic-distributed array, called by
+// chpl__scanIterator().  A locale's elements aren't contiguous in scan
+// order, so each locale instead gathers one contiguous block of the
+// indices from the other locales and scans it in parallel (see
+// DefaultRectangularArr.doiScan()).  The block totals are then scanned
+// serially, and finally each locale folds the total of the blocks
+// before its own into its results and scatters them back.  As in
+// BlockArr.doiScan(), the passes are separate coforalls so that the
+// scan still completes when they are serialized.
+//
+proc CyclicArr.doiScan(op, resDom) where (rank == 1) &&
+                                         chpl__scanStateResTypesMatch(op) {
+  type resType = op.generate().type;
+  type rngType = range(idxType, BoundedRangeType.bounded, stridable);
+  var res: [resDom] resType;
+
+  const targetLocDom = dom.dist.targetLocDom;
+  const numBlocks = targetLocDom.size;
+  const inds = resDom.dim(1);
+  var blockTotals: [0..#numBlocks] resType;
+  var blocks: [0..#numBlocks] unmanaged CyclicScanBlock(idxType, stridable,
+                                                        resType);
+
+  coforall (locid, b) in zip(targetLocDom, 0..) do
+      on dom.dist.targetLocs(locid) {
+    const (lo, hi) = _computeBlock(inds.size, numBlocks, b, inds.size-1);
+    const myInds = if lo > hi then inds[1..0] else chpl__scanChunk(inds, lo, hi);
+    var myData: [myInds] eltType;
+    for srcid in targetLocDom {
+      const srcInds = locArr[srcid].myElems.domain[myInds];
+      if srcInds.size > 0 then
+        myData[srcInds] = locArr[srcid].myElems[srcInds];
+    }
+
+    const blk = new unmanaged CyclicScanBlock(idxType, stridable, resType,
+                                              inds={myInds});
+    const myop = op.clone();
+    const (numTasks, rngs, state, total) =
+      myData._value.chpl__preScan(myop, blk.res, myData.domain);
+    blk.chunks = new unmanaged chpl__ScanChunks(rngType, resType,
+                                                numTasks, rngs, state);
+    blocks[b] = blk;
+    blockTotals[b] = total;
+    delete myop;
+  }
+
+  const metaop = op.clone();
+  var next: resType = metaop.identity;
+  for i in 0..#numBlocks {
+    blockTotals[i] <=> next;
+    metaop.accumulateOntoState(next, blockTotals[i]);
+  }
+  delete metaop;
+
+  coforall (locid, b) in zip(targetLocDom, 0..) do
+      on dom.dist.targetLocs(locid) {
+    const blk = blocks[b];
+    const chunks = blk.chunks;
+    const myop = op.clone();
+
+    const myadjust = blockTotals[b];
+    for s in chunks.state do
+      myop.accumulateOntoState(s, myadjust);
+    blk.res._value.chpl__postScan(myop, blk.res, chunks.numTasks,
+                                  chunks.rngs, chunks.state,
+                                  adjustFirst=true);
+    delete myop;
+
+    for dstid in targetLocDom {
+      ref dstElems = res._value.locArr[dstid].myElems;
+      const dstInds = dstElems.domain[blk.inds];
+      if dstInds.size > 0 then
+        dstElems[dstInds] = blk.res[dstInds];
+    }
+
+    delete chunks;
+    delete blk;
+  }
+
+  delete op;
+  return res;
+}
+
 proc CyclicArr.dsiTargetLocales() {
   return dom.dist.targetLocs;
 }
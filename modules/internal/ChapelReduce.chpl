@@ -30,7 +30,28 @@ module ChapelReduce {
     delete op;
   }
 
-  iter chpl__scanIterator(op, data) {
+  //
+  // Scans of 1D arrays whose implementation provides doiScan() (see
+  // DefaultRectangular, BlockDist, and CyclicDist) are computed in
+  // parallel and return the result array.  Everything else is scanned
+  // serially by chpl__scanIteratorSerial(), and the compiler warns
+  // about it.
+  //
+  proc chpl__scanIsParallel(op, data) param {
+    use Reflection;
+    return isArray(data) && canResolveMethod(data, "_value") &&
+           canResolveMethod(data._value, "doiScan", op, data.domain);
+  }
+
+  pragma "fn returns iterator"
+  proc chpl__scanIterator(op, data) {
+    if chpl__scanIsParallel(op, data) then
+      return data._value.doiScan(op, data.domain);
+    else
+      return chpl__scanIteratorSerial(op, data);
+  }
+
+  iter chpl__scanIteratorSerial(op, data) {
     for e in data {
       op.accumulate(e);
       yield op.generate();
@@ -38,7 +59,155 @@ module ChapelReduce {
     delete op;
   }
 
+  // A parallel scan combines the states of separately scanned chunks
+  // with accumulateOntoState(), so it requires that an operator's state
+  // have the same type as what it generates, and that the operator
+  // provide identity and clone().
+  proc chpl__scanStateResTypesMatch(op) param {
+    use Reflection;
+    if !canResolveMethod(op, "identity") || !canResolveMethod(op, "clone") {
+      return false;
+    } else {
+      type resType = op.generate().type;
+      type stateType = op.identity.type;
+      var x: resType;
+      return resType == stateType &&
+             canResolveMethod(op, "accumulateOntoState", x, x);
+    }
+  }
+
+  //
+  // Tasks combine their ops into their parent op when they finish.
+  // Tasks on the parent's locale lock it and combine directly, which
+  // covers the intra-locale level of a reduction.  Tasks on other
+  // locales would otherwise each do an 'on' back to the global op and
+  // serialize on its lock, so when the global op has been set up by
+  // chpl__reduceTreeInit() they instead combine into a node op on
+  // their own locale.  chpl__reduceTreeFini() later combines those
+  // nodes up a reduceTreeArity-ary tree over the locales, rooted
+  // at the global op's locale, which takes log(numLocales) rounds.
+  //
+  config param reduceTreeArity = 4;
+
+  // values of chpl__ReduceTreeState.state
+  param chpl__reduceTreeEmpty = 0, // no remote combines yet
+        chpl__reduceTreeAlloc = 1, // tree is being allocated
+        chpl__reduceTreeReady = 2; // tree is ready to use
+
+  // Only the global op of a bracketed reduction has one of these, so
+  // the clones that tasks combine into do not carry an atomic.
+  pragma "no doc"
+  class chpl__ReduceTreeState {
+    var state: atomic int;
+    var tree: unmanaged chpl__ReduceTree;
+  }
+
+  pragma "no doc"
+  class chpl__ReduceTree {
+    const rootId: int;
+    const rankDom = {0..#numLocales};
+    // per-rank node ops; rank 0 uses the global op itself
+    var nodes: [rankDom] unmanaged ReduceScanOp;
+    // 0 = no node, 1 = node being created, 2 = node ready
+    var nodeState: [rankDom] atomic int;
+    // whether there is a node in the subtree rooted at each rank
+    var subtreeUsed: [rankDom] atomic bool;
+
+    inline proc rankOf(locId: int) return (locId - rootId + numLocales) % numLocales;
+    inline proc locIdOf(rank: int) return (rank + rootId) % numLocales;
+    inline proc parentOf(rank: int) return (rank - 1) / reduceTreeArity;
+    inline proc childrenOf(rank: int) {
+      const lo = rank * reduceTreeArity + 1;
+      return lo..min(lo + reduceTreeArity - 1, numLocales - 1);
+    }
+  }
+
+  inline proc chpl__reduceTreeInit(globalOp) {
+    if CHPL_COMM != "none" then
+      globalOp.chpl_treeState = new unmanaged chpl__ReduceTreeState();
+  }
+
+  proc chpl__reduceTreeFini(globalOp) {
+    if CHPL_COMM != "none" {
+      const ts = globalOp.chpl_treeState;
+      if ts.state.read() == chpl__reduceTreeReady {
+        const tree = ts.tree;
+        if tree.subtreeUsed[0].read() then
+          chpl__reduceTreeGather(tree, globalOp, 0);
+        delete tree;
+      }
+      globalOp.chpl_treeState = nil;
+      delete ts;
+    }
+  }
+
+  // Return the tree of 'globalOp', allocating it on the first call.
+  proc chpl__reduceTreeGet(globalOp) {
+    const ts = globalOp.chpl_treeState;
+    if ts == nil then
+      return nil: unmanaged chpl__ReduceTree;
+    if ts.state.read() != chpl__reduceTreeReady {
+      if ts.state.compareExchange(chpl__reduceTreeEmpty,
+                                  chpl__reduceTreeAlloc) {
+        on ts do
+          ts.tree = new unmanaged chpl__ReduceTree(here.id);
+        ts.state.write(chpl__reduceTreeReady);
+      } else {
+        ts.state.waitFor(chpl__reduceTreeReady);
+      }
+    }
+    return ts.tree;
+  }
+
+  // Return the node op for 'here' in 'tree', creating it if needed.
+  proc chpl__reduceTreeNode(tree, globalOp) {
+    const rank = tree.rankOf(here.id);
+    if tree.nodeState[rank].read() != 2 {
+      if tree.nodeState[rank].compareExchange(0, 1) {
+        tree.nodes[rank] = globalOp.clone();
+        // Mark the path to the root, stopping early if another
+        // node has already marked the rest of it.
+        var r = rank;
+        while !tree.subtreeUsed[r].testAndSet() && r != 0 do
+          r = tree.parentOf(r);
+        tree.nodeState[rank].write(2);
+      } else {
+        tree.nodeState[rank].waitFor(2);
+      }
+    }
+    return tree.nodes[rank]: globalOp.type;
+  }
+
+  // Combine the nodes in the subtree rooted at 'rank' into that rank's
+  // node.  Runs on the locale of 'rank'.
+  proc chpl__reduceTreeGather(tree, globalOp, rank: int) {
+    const node = if rank == 0 then globalOp
+                 else chpl__reduceTreeNode(tree, globalOp);
+    const children = tree.childrenOf(rank);
+    coforall child in children do
+      if tree.subtreeUsed[child].read() then
+        on Locales[tree.locIdOf(child)] do
+          chpl__reduceTreeGather(tree, globalOp, child);
+    for child in children {
+      if tree.subtreeUsed[child].read() {
+        const childNode = tree.nodes[child]: globalOp.type;
+        node.combine(childNode);
+        delete childNode;
+      }
+    }
+  }
+
   proc chpl__reduceCombine(globalOp, localOp) {
+    if CHPL_COMM != "none" && globalOp.locale.id != here.id {
+      const tree = chpl__reduceTreeGet(globalOp);
+      if tree != nil {
+        const node = chpl__reduceTreeNode(tree, globalOp);
+        node.lock();
+        node.combine(localOp);
+        node.unlock();
+        return;
+      }
+    }
     on globalOp {
       globalOp.lock();
       globalOp.combine(localOp);
@@ -112,6 +281,9 @@ module ChapelReduce {
   pragma "ReduceScanOp"
   class ReduceScanOp {
     var l: chpl__processorAtomicType(bool); // only accessed locally
+    // combining tree for remote combines, see chpl__reduceCombine();
+    // only set on the global op
+    var chpl_treeState: unmanaged chpl__ReduceTreeState;
 
     proc lock() {
       var lockAttempts = 0,
@@ -25,6 +25,11 @@ module DefaultAssociative {
   config param debugDefaultAssoc = false;
   config param debugAssocDataPar = false;
 
+  // When true, default associative domains use an open-addressing,
+  // Swiss-table style layout (see the chpl__swiss* helpers below)
+  // instead of the prime-sized, quadratically probed table.
+  config param defaultAssocSwissTable = false;
+
   // TODO: make the domain parameterized by this?
   type chpl_table_index_type = int;
 
@@ -51,6 +56,76 @@ module DefaultAssociative {
    27021597764222939, 54043195528445869, 108086391056891903, 216172782113783773,
    432345564227567561, 864691128455135207);
 
+  //
+  // Support for the Swiss-table layout (defaultAssocSwissTable).
+  //
+  // The table has a power-of-two number of slots, split into groups of
+  // 8.  Each group has one 64-bit word of control bytes, one per slot.
+  // A full slot's control byte holds the low 7 bits of its index's hash,
+  // so its high bit is clear; the empty, deleted, and busy (claimed by
+  // an add in progress) states all have the high bit set.  A probe
+  // compares all 8 control bytes of a group against the hash tag at
+  // once using word-wide bit tricks, and only compares the indices of
+  // the slots whose tag matches.  Groups are probed triangularly, which
+  // visits every group when the group count is a power of two.
+  //
+  // The control words are stored XOR'd with chpl__swissMsbs so that a
+  // zero-initialized word is a group of empty slots.
+  //
+  param chpl__swissGroupSize = 8;
+  param chpl__swissNumStripes = 64;
+  param chpl__swissEmpty = 0x80:uint,
+        chpl__swissDeleted = 0xFE:uint,
+        chpl__swissBusy = 0xFF:uint;
+  param chpl__swissLsbs = 0x0101010101010101:uint,
+        chpl__swissMsbs = 0x8080808080808080:uint;
+
+  proc chpl__assocTableSize(sizeNum: int): int {
+    if defaultAssocSwissTable then
+      return chpl__swissGroupSize << sizeNum;
+    else
+      return chpl__primes(sizeNum);
+  }
+
+  proc chpl__swissNumStripeLocks(param parSafe) param {
+    return if defaultAssocSwissTable && parSafe then chpl__swissNumStripes
+           else 0;
+  }
+
+  proc chpl__swissNumGroups(tableSize: int): int {
+    return if defaultAssocSwissTable then tableSize / chpl__swissGroupSize
+           else 0;
+  }
+
+  // Returns a mask with the high bit set for each byte of 'w' equal to
+  // 'b'.  A borrow can also flag a byte just above a true match, but
+  // such a byte is always a full slot, and callers compare the indices.
+  inline proc chpl__swissMatch(w: uint, b: uint): uint {
+    const x = w ^ (chpl__swissLsbs * b);
+    return (x - chpl__swissLsbs) & ~x & chpl__swissMsbs;
+  }
+
+  inline proc chpl__swissMatchEmpty(w: uint): uint {
+    return w & ~(w << 6) & chpl__swissMsbs;
+  }
+
+  inline proc chpl__swissMatchEmptyOrDeleted(w: uint): uint {
+    return w & ~(w << 7) & chpl__swissMsbs;
+  }
+
+  // Returns the position of the lowest byte flagged in the mask 'm'.
+  inline proc chpl__swissFirst(m: uint): int {
+    extern proc chpl_bitops_ctz_64(x: uint(64)) : uint(64);
+    return (chpl_bitops_ctz_64(m) / 8): int;
+  }
+
+  // Returns the stored control word 'stored' with byte 'b' set to 'ctl'.
+  inline proc chpl__swissWithByte(stored: uint, b: int, ctl: uint): uint {
+    const shift = (b * 8): uint;
+    return (stored & ~(0xFF:uint << shift)) |
+           ((ctl ^ chpl__swissEmpty) << shift);
+  }
+
   class DefaultAssociativeDom: BaseAssociativeDom {
     type idxType;
     param parSafe: bool;
@@ -67,14 +142,64 @@ module DefaultAssociative {
     var tableSize : int;
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
+
+    // Used only by the Swiss-table layout.  'ctrl' holds a word of
+    // control bytes per group of slots.  For parSafe domains, adds and
+    // removes lock just the stripe their index hashes to, and
+    // 'activeOps' counts the adds, removes, and lookups in flight so
+    // that whatever takes the tableLock (e.g. a resize) can wait them out.
+    var ctrlDom = {0..#chpl__swissNumGroups(tableSize)};
+    var ctrl: [ctrlDom] chpl__processorAtomicType(uint);
+    var stripeDom = {0..#chpl__swissNumStripeLocks(parSafe)};
+    var stripeLocks: [stripeDom] chpl__processorAtomicType(bool);
+    var activeOps: chpl__processorAtomicType(int);
   
     inline proc lockTable() {
-      while tableLock.testAndSet(memory_order_acquire) do chpl_task_yield();
+      if defaultAssocSwissTable && parSafe {
+        while tableLock.testAndSet() do chpl_task_yield();
+        while activeOps.read() != 0 do chpl_task_yield();
+      } else {
+        while tableLock.testAndSet(memory_order_acquire) do chpl_task_yield();
+      }
     }
   
     inline proc unlockTable() {
       tableLock.clear(memory_order_release);
     }
+
+    // Swiss-table layout, parSafe only: start and finish an add, remove,
+    // or lookup that doesn't hold the tableLock.
+    inline proc _enterTable() {
+      while true {
+        activeOps.add(1);
+        if !tableLock.read() then return;
+        activeOps.sub(1);
+        while tableLock.read() do chpl_task_yield();
+      }
+    }
+
+    inline proc _exitTable() {
+      activeOps.sub(1, memory_order_release);
+    }
+
+    inline proc _lockStripe(h: uint) {
+      const stripe = ((h >> 7) & (chpl__swissNumStripes-1)): int;
+      while stripeLocks[stripe].testAndSet(memory_order_acquire) do
+        chpl_task_yield();
+    }
+
+    inline proc _unlockStripe(h: uint) {
+      const stripe = ((h >> 7) & (chpl__swissNumStripes-1)): int;
+      stripeLocks[stripe].clear(memory_order_release);
+    }
+
+    // Should the table grow before it holds 'n' indices?
+    inline proc _needsGrow(n: int) {
+      if defaultAssocSwissTable then
+        return n*8 > tableSize*7;
+      else
+        return n*2 > tableSize;
+    }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
     //       replace with a named constant/param?
@@ -95,7 +220,7 @@ module DefaultAssociative {
       this.idxType = idxType;
       this.parSafe = parSafe;
       this.dist = dist;
-      this.tableSize = chpl__primes(tableSizeNum);
+      this.tableSize = chpl__assocTableSize(tableSizeNum);
     }
   
     //
@@ -273,6 +398,8 @@ module DefaultAssociative {
         for slot in tableDom {
           table[slot].status = chpl__hash_status.empty;
         }
+        if defaultAssocSwissTable then
+          for g in ctrlDom do ctrl[g].write(0);
         numEntries.write(0);
         if parSafe then unlockTable();
       }
@@ -307,21 +434,61 @@ module DefaultAssociative {
       var retVal = 0;
       on this {
         const shouldLock = needLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if defaultAssocSwissTable && shouldLock {
+          (slotNum, retVal) = _swissAddParSafe(idx);
+        } else {
+          if shouldLock then lockTable();
+          // the Swiss-table layout doesn't hand out a reusable slot from
+          // _findFilledSlot(), so always search again
+          var findAgain = shouldLock || defaultAssocSwissTable;
+          if _needsGrow(numEntries.read()+1) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
+          if shouldLock then unlockTable();
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Swiss-table layout: add 'idx' to a parSafe domain.  Adds of
+    // indices in different lock stripes proceed concurrently, claiming
+    // their slots with atomic updates to the control words; only growing
+    // the table takes the tableLock.
+    proc _swissAddParSafe(idx: idxType): (index(tableDom), int) {
+      const h = chpl__defaultHashWrapper(idx):uint;
+      while true {
+        var full = false;
+        _enterTable();
+        if !_needsGrow(numEntries.read()+1) {
+          _lockStripe(h);
+          const (isFree, slotNum) = _findEmptySlot(idx);
+          if isFree then _add(idx, slotNum);
+          _unlockStripe(h);
+          _exitTable();
+          if slotNum != -1 then
+            return (slotNum, if isFree then 1 else 0);
+          // other tasks' adds took the last free slots
+          full = true;
+        } else {
+          _exitTable();
+        }
+        lockTable();
+        if full || _needsGrow(numEntries.read()+1) {
+          if full && postponeResize then
+            halt("couldn't add ", idx, " -- ", numEntries.read(), " / ",
+                 tableSize, " taken");
+          _resize(grow=true);
+        }
+        unlockTable();
+      }
+      halt("unreachable");
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -336,6 +503,8 @@ module DefaultAssociative {
       if foundSlot {
         table[slotNum].status = chpl__hash_status.full;
         table[slotNum].idx = idx;
+        if defaultAssocSwissTable then
+          _swissSetCtrl(slotNum, chpl__defaultHashWrapper(idx):uint & 0x7F);
         numEntries.add(1);
 
         // default initialize newly added array elements
@@ -355,20 +524,40 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
+        const useStripes = defaultAssocSwissTable && parSafe;
+        const h = if useStripes then chpl__defaultHashWrapper(idx):uint
+                  else 0:uint;
+        if useStripes {
+          _enterTable();
+          _lockStripe(h);
+        } else if parSafe then lockTable();
         const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
         if (foundSlot) {
           for a in _arrs do
             a.clearEntry(idx);
           table[slotNum].status = chpl__hash_status.deleted;
+          if defaultAssocSwissTable then
+            _swissSetCtrl(slotNum, chpl__swissDeleted);
           numEntries.sub(1);
         } else {
           retval = 0;
         }
-        if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
-          _resize(grow=false);
+        if useStripes {
+          _unlockStripe(h);
+          _exitTable();
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            lockTable();
+            if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+              _resize(grow=false);
+            }
+            unlockTable();
+          }
+        } else {
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+          if parSafe then unlockTable();
         }
-        if parSafe then unlockTable();
       }
       return retval;
     }
@@ -393,13 +582,26 @@ module DefaultAssociative {
       return primeLoc;
     }
 
+    // Swiss-table layout: the smallest power-of-two size that holds
+    // 'numKeys' indices without needing to grow.
+    proc findSwissSizeIndex(numKeys:int) {
+      for i in 1..chpl__primes.size {
+        if (numKeys + 1) * 8 <= chpl__assocTableSize(i) * 7 then
+          return i;
+      }
+      halt("Requested capacity (", numKeys, ") exceeds maximum size");
+      return 0;
+    }
+
     proc dsiRequestCapacity(numKeys:int) {
       var entries = numEntries.read();
 
       if entries < numKeys {
 
-        var primeLoc = findPrimeSizeIndex(numKeys);
-        var prime = chpl__primes(primeLoc);
+        var primeLoc = if defaultAssocSwissTable
+                       then findSwissSizeIndex(numKeys)
+                       else findPrimeSizeIndex(numKeys);
+        var prime = chpl__assocTableSize(primeLoc);
 
         //Changing underlying structure, time for locking
         if parSafe then lockTable();
@@ -417,6 +619,7 @@ module DefaultAssociative {
           tableSizeNum = primeLoc;
           tableSize = prime;
           tableDom = {0..tableSize-1};
+          if defaultAssocSwissTable then _swissResetCtrl();
 
           //numEntries will be reconstructed as keys are readded
           numEntries.write(0);
@@ -433,6 +636,7 @@ module DefaultAssociative {
           tableSizeNum=primeLoc;
           tableSize=prime;
           tableDom = {0..tableSize-1};
+          if defaultAssocSwissTable then _swissResetCtrl();
         }
 
         //Unlock the table
@@ -475,8 +679,9 @@ module DefaultAssociative {
       numEntries.write(0); // reset, because the adds below will re-set this
       tableSizeNum += if grow then 1 else -1;
       if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
-      tableSize = chpl__primes(tableSizeNum);
+      tableSize = chpl__assocTableSize(tableSizeNum);
       tableDom = {0..tableSize-1};
+      if defaultAssocSwissTable then _swissResetCtrl();
   
       // insert old data into newly resized table
       for slot in _fullSlots(copyTable) {
@@ -492,6 +697,12 @@ module DefaultAssociative {
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
+      if defaultAssocSwissTable {
+        if parSafe && needLock then _enterTable();
+        const ret = _swissFind(idx, chpl__defaultHashWrapper(idx):uint);
+        if parSafe && needLock then _exitTable();
+        return ret;
+      }
       if parSafe && needLock then lockTable();
       var firstOpen = -1;
       for slotNum in _lookForSlots(idx, table.domain.high+1) {
@@ -519,6 +730,13 @@ module DefaultAssociative {
     // NOTE: Calls to this routine assume that the tableLock has been acquired.
     //
     proc _findEmptySlot(idx: idxType): (bool, index(tableDom)) {
+      if defaultAssocSwissTable {
+        const h = chpl__defaultHashWrapper(idx):uint;
+        const (found, slotNum) = _swissFind(idx, h);
+        if found then return (false, slotNum);
+        const claimed = _swissClaim(h);
+        return (claimed != -1, claimed);
+      }
       for slotNum in _lookForSlots(idx) {
         const slotStatus = table[slotNum].status;
         if (slotStatus == chpl__hash_status.empty ||
@@ -547,6 +765,79 @@ module DefaultAssociative {
       }
     }
   
+    //
+    // Swiss-table layout: searches for 'idx', whose hash is 'h'.  Returns
+    // true and its slot if found; otherwise false and the first free
+    // slot seen, or -1 if there was none.
+    //
+    proc _swissFind(idx: idxType, h: uint): (bool, index(tableDom)) {
+      const groupMask = (ctrlDom.size - 1): uint;
+      const tag = h & 0x7F;
+      var g = ((h >> 7) & groupMask): int;
+      var firstOpen = -1;
+      for probe in 1..ctrlDom.size {
+        const w = ctrl[g].read(memory_order_acquire) ^ chpl__swissMsbs;
+        var m = chpl__swissMatch(w, tag);
+        while m != 0 {
+          const slotNum = g*chpl__swissGroupSize + chpl__swissFirst(m);
+          if table[slotNum].idx == idx then
+            return (true, slotNum);
+          m &= m - 1;
+        }
+        if firstOpen == -1 {
+          const open = chpl__swissMatchEmptyOrDeleted(w);
+          if open != 0 then
+            firstOpen = g*chpl__swissGroupSize + chpl__swissFirst(open);
+        }
+        // an index is never stored past a group with an empty slot
+        if chpl__swissMatchEmpty(w) != 0 then
+          break;
+        g = ((g + probe):uint & groupMask): int;
+      }
+      return (false, firstOpen);
+    }
+
+    //
+    // Swiss-table layout: claims a free slot along the probe sequence
+    // for hash 'h' by atomically marking it busy; the caller publishes
+    // the slot with _swissSetCtrl() once its index is stored.  Returns
+    // -1 if there are no free slots.
+    //
+    proc _swissClaim(h: uint): index(tableDom) {
+      const groupMask = (ctrlDom.size - 1): uint;
+      var g = ((h >> 7) & groupMask): int;
+      for probe in 1..ctrlDom.size {
+        var stored = ctrl[g].read();
+        var m = chpl__swissMatchEmptyOrDeleted(stored ^ chpl__swissMsbs);
+        while m != 0 {
+          const b = chpl__swissFirst(m);
+          if ctrl[g].compareExchange(stored,
+                        chpl__swissWithByte(stored, b, chpl__swissBusy)) then
+            return g*chpl__swissGroupSize + b;
+          stored = ctrl[g].read();
+          m = chpl__swissMatchEmptyOrDeleted(stored ^ chpl__swissMsbs);
+        }
+        g = ((g + probe):uint & groupMask): int;
+      }
+      return -1;
+    }
+
+    proc _swissSetCtrl(slotNum: index(tableDom), ctl: uint) {
+      const g = slotNum / chpl__swissGroupSize,
+            b = slotNum % chpl__swissGroupSize;
+      var stored = ctrl[g].read();
+      while !ctrl[g].compareExchange(stored,
+                                     chpl__swissWithByte(stored, b, ctl)) do
+        stored = ctrl[g].read();
+    }
+
+    // Swiss-table layout: reallocates the control words to match
+    // tableSize, with every slot empty.
+    proc _swissResetCtrl() {
+      ctrlDom = {0..-1};
+      ctrlDom = {0..#chpl__swissNumGroups(tableSize)};
+    }
+
     iter _fullSlots(tab = table) {
       for slot in tab.domain {
         if tab[slot].status == chpl__hash_status.full then
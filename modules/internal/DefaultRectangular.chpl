@@ -2172,6 +2172,105 @@ module DefaultRectangular {
     }
   }
 
+  //
+  // Parallel scan of a 1D array, called by chpl__scanIterator().  Each
+  // task scans a contiguous chunk of the indices, the chunk totals are
+  // scanned serially, and then each task folds the total of the chunks
+  // before it into its own results.
+  //
+  proc DefaultRectangularArr.doiScan(op, resDom) where (rank == 1) &&
+                                          chpl__scanStateResTypesMatch(op) {
+    type resType = op.generate().type;
+    var res: [resDom] resType;
+
+    const (numTasks, rngs, state, _) = chpl__preScan(op, res, resDom);
+    chpl__postScan(op, res, numTasks, rngs, state, adjustFirst=false);
+
+    delete op;
+    return res;
+  }
+
+  //
+  // The first pass of doiScan(): scans each task's chunk of 'resDom'
+  // into 'res'.  Returns the number of chunks, the chunks, each chunk's
+  // starting state (the exclusive scan of the chunk totals), and the
+  // total over all of the chunks.
+  //
+  proc DefaultRectangularArr.chpl__preScan(op, res: [] ?resType, resDom) {
+    const rng = resDom.dim(1);
+    const numTasks = if __primitive("task_get_serial") then
+                       min(1, rng.size)
+                     else _computeNumChunks(rng.size);
+    var rngs: [0..#numTasks] rng.type;
+    for tid in 0..#numTasks {
+      const (lo, hi) = _computeBlock(rng.size, numTasks, tid, rng.size-1);
+      rngs[tid] = chpl__scanChunk(rng, lo, hi);
+    }
+
+    var state: [0..#numTasks] resType;
+    coforall tid in 0..#numTasks {
+      const myop = op.clone();
+      for i in rngs[tid] {
+        myop.accumulate(dsiAccess(i));
+        res[i] = myop.generate();
+      }
+      state[tid] = myop.generate();
+      delete myop;
+    }
+
+    // turn the chunk totals into an exclusive scan of them
+    const metaop = op.clone();
+    var next: resType = metaop.identity;
+    for tid in 0..#numTasks {
+      state[tid] <=> next;
+      metaop.accumulateOntoState(next, state[tid]);
+    }
+    delete metaop;
+
+    return (numTasks, rngs, state, next);
+  }
+
+  //
+  // The chunks of a scan and their starting states, as returned by
+  // chpl__preScan().  Distributed scans keep these on each locale
+  // between their passes (see BlockArr.doiScan()).
+  //
+  class chpl__ScanChunks {
+    type rngType;
+    type resType;
+    const numTasks: int;
+    var rngs: [0..#numTasks] rngType;
+    var state: [0..#numTasks] resType;
+  }
+
+  //
+  // The second pass of doiScan(): folds each chunk's starting state
+  // into its results.  The first chunk's starting state is the identity
+  // unless the caller has adjusted it, so it is skipped by default.
+  //
+  proc DefaultRectangularArr.chpl__postScan(op, res, numTasks, rngs, state,
+                                            adjustFirst: bool) {
+    const firstTask = if adjustFirst then 0 else 1;
+    coforall tid in firstTask..numTasks-1 {
+      const myadjust = state[tid];
+      for i in rngs[tid] do
+        op.accumulateOntoState(res[i], myadjust);
+    }
+  }
+
+  // Returns the indices of 'rng' at positions lo..hi, in 'rng's order.
+  proc chpl__scanChunk(rng: range(?), lo, hi) {
+    if !rng.stridable {
+      return rng.orderToIndex(lo)..rng.orderToIndex(hi);
+    } else {
+      const first = rng.orderToIndex(lo), last = rng.orderToIndex(hi);
+      if rng.stride > 0 then
+        return first..last by rng.stride;
+      else
+        return last..first by rng.stride;
+    }
+  }
+
   proc DefaultRectangularArr.isDefaultRectangular() param return true;
   proc type DefaultRectangularArr.isDefaultRectangular() param return true;
 
@@ -260,6 +260,42 @@ class CSDom: BaseSparseDomImpl {
     return startIdx(i+1)-1;
   }
 
+  pragma "no doc"
+  /* Split the compressed dimension into contiguous ranges of (rows|cols)
+     for parallel kernels that walk 'startIdx' directly.  Unlike the
+     leader iterator, chunks never break a (row|col) apart.  Each chunk is
+     sized to hold about the same number of nonzeros, counting every
+     (row|col) as one more, so that long empty stretches are split too. */
+  proc nnzBalancedChunks() {
+    const lo = startIdxDom.low,
+          hi = startIdxDom.high - 1,
+          work = nnz + (hi - lo + 1);
+    const numChunks = max(1, _computeNumChunks(work));
+
+    // The work done before (row|col) 'i' is startIdx(i)-1 + (i-lo), which
+    // is nondecreasing in 'i', so each chunk boundary is a binary search.
+    proc workBefore(i) return startIdx(i) - 1 + (i - lo);
+
+    var chunks: [0..#numChunks] range(idxType);
+    var first = lo;
+    for c in 0..#numChunks {
+      var last = hi;
+      if c < numChunks - 1 {
+        const target = work * (c+1) / numChunks;
+        // Find the last 'i' in first-1..hi with workBefore(i) < target
+        var l = first - 1, h = hi;
+        while l < h {
+          const m = (l + h + 1) / 2;
+          if workBefore(m) < target then l = m; else h = m - 1;
+        }
+        last = l;
+      }
+      chunks[c] = first..last;
+      first = last + 1;
+    }
+    return chunks;
+  }
+
   proc find(ind: rank*idxType) {
     use Search;
 
@@ -368,6 +404,20 @@ class CSDom: BaseSparseDomImpl {
     return 1;
   }
 
+  override proc dsiBulkAdd(inds: [] index(rank, idxType),
+                           dataSorted=false, isUnique=false, preserveInds=true) {
+    // Filling an empty domain doesn't reorder 'inds', so it needs no copy
+    if nnz == 0 && !dataSorted then
+      return bulkBuild(inds);
+
+    if !dataSorted && preserveInds {
+      var _inds = inds;
+      return bulkAdd_help(_inds, dataSorted, isUnique);
+    } else {
+      return bulkAdd_help(inds, dataSorted, isUnique);
+    }
+  }
+
   override proc bulkAdd_help(inds: [?indsDom] rank*idxType, dataSorted=false,
                              isUnique=false) {
 
@@ -509,6 +559,125 @@ class CSDom: BaseSparseDomImpl {
     return actualAddCnt;
   }
 
+  pragma "no doc"
+  /* Fill this empty domain with the indices in 'inds', which may be
+     unsorted and contain repeats, using O(inds.size) work:
+
+     1. count the indices in each (row|col), in parallel
+     2. scan the counts into offsets and scatter the minor indices into a
+        buffer grouped by (row|col)
+     3. sort each (row|col) of the buffer and count its distinct indices
+     4. scan the distinct counts into 'startIdx' and fill 'idx'
+
+     Returns the number of indices added.  If 'withOrder' is true, the
+     buffer also carries the position of each index in 'inds', and this
+     returns (order, runStart) instead: 'order' lists the positions in
+     'inds' sorted by where their index ended up in 'idx', and the indices
+     in inds[order[runStart[k]..runStart[k+1]-1]] are all idx(k).  This
+     lets callers build the values of an array in O(inds.size) work too. */
+  proc bulkBuild(inds: [?indsDom] rank*idxType, param withOrder=false) {
+    use Sort;
+
+    if nnz != 0 then
+      halt("CSDom.bulkBuild() requires an empty domain");
+
+    if boundsChecking then
+      forall i in inds do boundsCheck(i);
+
+    inline proc major(ind) return if compressRows then ind(1) else ind(2);
+    inline proc minor(ind) return if compressRows then ind(2) else ind(1);
+    inline proc bufIdx(b) return if withOrder then b(1) else b;
+
+    type bufType = if withOrder then (idxType, int) else idxType;
+    const majorDom = {startIdxDom.low..startIdxDom.high-1},
+          n = inds.size;
+
+    // 1. Count the indices in each (row|col)
+    var counts: [majorDom] atomic int;
+    forall ind in inds do
+      counts[major(ind)].add(1);
+
+    // 2. bufEnd(r) is one past the last buffer slot of (row|col) 'r'.
+    // The counts then become cursors for the scatter.
+    var bufEnd: [majorDom] int;
+    forall (e, c) in zip(bufEnd, counts) do
+      e = c.read();
+    bufEnd = + scan bufEnd;
+    bufEnd += 1;
+    forall (e, c) in zip(bufEnd, counts) do
+      c.write(e - c.read());
+
+    var buf: [1..n] bufType;
+    forall (ind, i) in zip(inds, indsDom) {
+      const slot = counts[major(ind)].fetchAdd(1);
+      if withOrder then
+        buf[slot] = (minor(ind), i);
+      else
+        buf[slot] = minor(ind);
+    }
+
+    // 3. Sort each (row|col), and count its distinct indices
+    inline proc bufRange(r) {
+      const lo = if r == majorDom.low then 1 else bufEnd[r-1];
+      return lo..bufEnd[r]-1;
+    }
+
+    var numDistinct: [majorDom] idxType;
+    forall r in majorDom {
+      const rr = bufRange(r);
+      if rr.size > 32 {
+        sort(buf[rr]);
+      } else {
+        // insertion sort
+        for k in rr.low+1..rr.high {
+          const b = buf[k];
+          var j = k;
+          while j > rr.low && b < buf[j-1] {
+            buf[j] = buf[j-1];
+            j -= 1;
+          }
+          buf[j] = b;
+        }
+      }
+      var cnt = 0: idxType;
+      for k in rr do
+        if k == rr.low || bufIdx(buf[k]) != bufIdx(buf[k-1]) then
+          cnt += 1;
+      numDistinct[r] = cnt;
+    }
+
+    // 4. Fill startIdx and idx
+    numDistinct = + scan numDistinct;
+    startIdx[startIdxDom.low] = 1;
+    forall r in majorDom do
+      startIdx[r+1] = numDistinct[r] + 1;
+
+    nnz = startIdx[startIdxDom.high] - 1;
+    _bulkGrow();
+
+    var runStart: [1..if withOrder then nnz+1 else 0] int;
+    forall r in majorDom {
+      var next = startIdx[r];
+      const rr = bufRange(r);
+      for k in rr {
+        if k == rr.low || bufIdx(buf[k]) != bufIdx(buf[k-1]) {
+          idx[next] = bufIdx(buf[k]);
+          if withOrder then
+            runStart[next] = k;
+          next += 1;
+        }
+      }
+    }
+
+    if withOrder {
+      runStart[nnz+1] = n + 1;
+      const order = [b in buf] b(2);
+      return (order, runStart);
+    } else {
+      return nnz;
+    }
+  }
+
   proc dsiRemove(ind: rank*idxType) {
     // find position in nnzDom to remove old index
     const (found, insertPt) = find(ind);
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+   .. warning::
+     This module represents work in progress. The API is unstable and likely to
+     change over time.
+
+   This module provides aggregated gathers and scatters of individual array
+   elements for ``numeric`` and ``bool`` types. Rather than doing one network
+   GET or PUT per element, the elements are bucketed by the locale they live
+   on and each locale's share is moved as a single batch. This can provide a
+   significant speedup for codes that read or write many elements at random
+   locations of a distributed array, such as graph codes.
+
+   .. code-block:: chapel
+
+     use BlockDist, Aggregation;
+
+     const D = {1..n} dmapped Block({1..n});
+     var A: [D] int;
+     var inds: [1..m] int = ...;   // random indices into A
+
+     var vals: [1..m] int;
+     gather(vals, A, inds);         // vals[i] = A[inds[i]]
+     scatter(A, inds, vals);        // A[inds[i]] = vals[i]
+
+   Finding where each element lives takes a round of communication of its
+   own. When the same set of elements is moved repeatedly, compute the
+   locations once with :proc:`remoteAddrs` and reuse them with
+   :proc:`gatherv` and :proc:`scatterv`:
+
+   .. code-block:: chapel
+
+     const addrs = remoteAddrs(A, inds);
+     for iter in 1..numIters {
+       gatherv(vals, addrs);
+       ...
+     }
+
+   The gathered and scattered local arrays must be 1-dimensional, non-
+   distributed, and live on the calling locale.
+
+   .. note::
+     Under ``CHPL_COMM=gasnet`` each locale's share is moved with a single
+     GASNet indexed (VIS) transfer, and under ``CHPL_COMM=ofi`` with a
+     pipelined batch of RMA operations. Under ``CHPL_COMM=ugni`` gathers use
+     the same buffering as :mod:`BufferedGets`.
+ */
+module Aggregation {
+  use SysCTypes;
+
+  private extern proc chpl_comm_gatherv(dstaddr: c_void_ptr,
+                                        srcnodes: c_ptr(int(32)),
+                                        srcaddrs: c_ptr(c_void_ptr),
+                                        n: size_t, elemSize: size_t,
+                                        commID: int(32),
+                                        ln: c_int, fn: int(32));
+
+  private extern proc chpl_comm_scatterv(dstnodes: c_ptr(int(32)),
+                                         dstaddrs: c_ptr(c_void_ptr),
+                                         srcaddr: c_void_ptr,
+                                         n: size_t, elemSize: size_t,
+                                         commID: int(32),
+                                         ln: c_int, fn: int(32));
+
+  /*
+     The locations of a batch of array elements: element ``i`` lives at
+     address ``addrs[i]`` on the locale whose id is ``nodes[i]``.
+
+     The addresses stay valid only as long as the arrays they were computed
+     from are neither destroyed nor resized.
+   */
+  record RemoteAddrs {
+    /* The positions of the elements in the batch. */
+    var D: domain(1);
+    /* The id of the locale each element lives on. */
+    var nodes: [D] int(32);
+    /* The address of each element on its locale. */
+    var addrs: [D] c_void_ptr;
+
+    proc init(n: int) {
+      D = {0..#n};
+    }
+  }
+
+  /*
+     Compute the locations of the elements ``A[inds[i]]``, for use with
+     :proc:`gatherv` and :proc:`scatterv`.
+   */
+  proc remoteAddrs(ref A: [] ?t, inds: [?D] A.idxType): RemoteAddrs
+  where D.rank == 1 {
+    const n = D.size;
+    var ra = new RemoteAddrs(n);
+
+    forall (node, i) in zip(ra.nodes, inds) do
+      node = A.domain.dist.idxToLocale(i).id: int(32);
+
+    // Bucket the indices by locale, so each locale can look up all of
+    // its own addresses in one visit.
+    var count: [LocaleSpace] int;
+    for node in ra.nodes do
+      count[node] += 1;
+    const start = (+ scan count) - count;
+
+    var cursor = start;
+    var order: [0..#n] int;
+    var bucketInds: [0..#n] A.idxType;
+    for (i, node, pos) in zip(inds, ra.nodes, 0..) {
+      const k = cursor[node];
+      cursor[node] += 1;
+      order[k] = pos;
+      bucketInds[k] = i;
+    }
+
+    var bucketAddrs: [0..#n] c_void_ptr;
+    coforall loc in Locales do if count[loc.id] > 0 then on loc {
+      const myRange = start[here.id]..#count[here.id];
+      const myInds: [myRange] A.idxType = bucketInds[myRange];
+      var myAddrs: [myRange] c_void_ptr;
+      forall (addr, i) in zip(myAddrs, myInds) do
+        addr = c_ptrTo(A[i]): c_void_ptr;
+      bucketAddrs[myRange] = myAddrs;
+    }
+
+    forall (k, addr) in zip(0..#n, bucketAddrs) with (ref ra) do
+      ra.addrs[order[k]] = addr;
+
+    return ra;
+  }
+
+  /*
+     Gather the elements at ``addrs`` into ``dst``, which must have as many
+     elements as ``addrs`` describes. Only supported for numeric and bool
+     types.
+   */
+  proc gatherv(ref dst: [?D] ?t, const ref addrs: RemoteAddrs) {
+    checkLocalArr(dst, addrs);
+    if D.size == 0 then return;
+    chpl_comm_gatherv(c_ptrTo(dst): c_void_ptr,
+                      dataPtr(addrs.nodes), dataPtr(addrs.addrs),
+                      D.size: size_t, numBytes(t): size_t,
+                      -1: int(32),
+                      __primitive("_get_user_line"): c_int,
+                      __primitive("_get_user_file"));
+  }
+
+  /*
+     Scatter the elements of ``src`` out to ``addrs``, which must describe as
+     many elements as ``src`` has. Only supported for numeric and bool types.
+   */
+  proc scatterv(const ref addrs: RemoteAddrs, const ref src: [?D] ?t) {
+    checkLocalArr(src, addrs);
+    if D.size == 0 then return;
+    chpl_comm_scatterv(dataPtr(addrs.nodes), dataPtr(addrs.addrs),
+                       dataPtr(src): c_void_ptr,
+                       D.size: size_t, numBytes(t): size_t,
+                       -1: int(32),
+                       __primitive("_get_user_line"): c_int,
+                       __primitive("_get_user_file"));
+  }
+
+  /*
+     Set ``dst[i] = A[inds[i]]`` for each index ``i`` of ``inds``. ``dst``
+     must be over the same indices as ``inds``.
+   */
+  proc gather(ref dst: [?D] ?t, ref A: [] t, inds: [D] A.idxType) {
+    gatherv(dst, remoteAddrs(A, inds));
+  }
+
+  /*
+     Set ``A[inds[i]] = src[i]`` for each index ``i`` of ``inds``. If
+     ``inds`` names the same element of ``A`` more than once, which of the
+     values ends up there is unspecified.
+   */
+  proc scatter(ref A: [] ?t, inds: [?D] A.idxType, const ref src: [D] t) {
+    scatterv(remoteAddrs(A, inds), src);
+  }
+
+  // c_ptrTo() wants a mutable array, but the runtime only reads these.
+  private inline proc dataPtr(const ref arr: [?D]) {
+    return c_ptrTo(arr._value.dsiAccess(D.low));
+  }
+
+  private proc checkLocalArr(const ref arr: [?D] ?t, const ref addrs) {
+    if !(isNumericType(t) || isBoolType(t)) then
+      compilerError("Aggregation is only supported on numeric and bool types");
+    if D.rank != 1 || !arr._value.isDefaultRectangular() then
+      compilerError("Aggregation requires a 1-dimensional local array");
+    if arr._value.locale != here || addrs.D._value.locale != here then
+      halt("Aggregation requires arrays that live on the calling locale");
+    if D.size != addrs.D.size then
+      halt("size mismatch in aggregated gather/scatter: ",
+           D.size, " elements vs. ", addrs.D.size, " addresses");
+  }
+}
@@ -69,13 +69,19 @@
    updates to perform and the order of those operations doesn't matter.
 
    .. note::
-     Currently, these are only optimized for ``CHPL_NETWORK_ATOMICS=ugni``.
-     Processor atomics or any other implementation falls back to non-buffered
-     operations. Under ugni these operations are internally buffered. When the
-     buffers are flushed, the operations are performed all at once. Cray Linux
-     Environment (CLE) 5.2.UP04 or newer is required for best performance. In
-     our experience, buffered atomics can achieve up to a 5X performance
-     improvement over non-buffered atomics for CLE 5.2UP04 or newer.
+     Currently, these are optimized for ``CHPL_NETWORK_ATOMICS=ugni`` and for
+     ``CHPL_COMM=gasnet`` and ``CHPL_COMM=ofi``. Under ugni these operations
+     are internally buffered. When the buffers are flushed, the operations are
+     performed all at once. Cray Linux Environment (CLE) 5.2.UP04 or newer is
+     required for best performance. In our experience, buffered atomics can
+     achieve up to a 5X performance improvement over non-buffered atomics for
+     CLE 5.2UP04 or newer.
+
+     Under gasnet and ofi, operations are buffered per thread and destination
+     locale, and each full buffer is sent to its locale in a single message
+     and applied there as a batch by the processor. This replaces one
+     round-trip per operation with one per buffer. 8- and 16-bit atomics and
+     any other configuration fall back to non-buffered operations.
  */
 module BufferedAtomics {
 
@@ -85,9 +91,32 @@ module BufferedAtomics {
     if isReal(T) then return "chpl_comm_atomic_" + s + "_real" + numBits(T):string;
   }
 
+  // The gasnet and ofi comm layers buffer ops on processor atomics too.
+  private proc commBuffersProcAtomics(type T) param {
+    return (CHPL_COMM == "gasnet" || CHPL_COMM == "ofi") && numBits(T) >= 32;
+  }
+
+  pragma "no doc"
+  inline proc AtomicT._localeid(): int(32) {
+    return _v.locale.id:int(32);
+  }
+
+  pragma "no doc"
+  inline proc AtomicT._addr(): c_void_ptr {
+    return __primitive("_wide_get_addr", _v);
+  }
+
   /* Buffered atomic add. */
   inline proc AtomicT.addBuff(value:T): void {
-    this.add(value);
+    if commBuffersProcAtomics(T) {
+      pragma "insert line file info" extern externFunc("add_unordered", T)
+        proc atomic_add_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_add_unordered(v, _localeid(), _addr());
+    } else {
+      this.add(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.addBuff(value:T): void {
@@ -100,7 +129,15 @@ module BufferedAtomics {
 
   /* Buffered atomic sub. */
   inline proc AtomicT.subBuff(value:T): void {
-    this.sub(value);
+    if commBuffersProcAtomics(T) {
+      pragma "insert line file info" extern externFunc("sub_unordered", T)
+        proc atomic_sub_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_sub_unordered(v, _localeid(), _addr());
+    } else {
+      this.sub(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.subBuff(value:T): void {
@@ -113,7 +150,16 @@ module BufferedAtomics {
 
   /* Buffered atomic or. */
   inline proc AtomicT.orBuff(value:T): void {
-    this.or(value);
+    if commBuffersProcAtomics(T) {
+      if !isIntegral(T) then compilerError("or is only defined for integer atomic types");
+      pragma "insert line file info" extern externFunc("or_unordered", T)
+        proc atomic_or_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_or_unordered(v, _localeid(), _addr());
+    } else {
+      this.or(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.orBuff(value:T): void {
@@ -127,7 +173,16 @@ module BufferedAtomics {
 
   /* Buffered atomic and. */
   inline proc AtomicT.andBuff(value:T): void {
-    this.and(value);
+    if commBuffersProcAtomics(T) {
+      if !isIntegral(T) then compilerError("and is only defined for integer atomic types");
+      pragma "insert line file info" extern externFunc("and_unordered", T)
+        proc atomic_and_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_and_unordered(v, _localeid(), _addr());
+    } else {
+      this.and(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.andBuff(value:T): void {
@@ -141,7 +196,16 @@ module BufferedAtomics {
 
   /* Buffered atomic xor. */
   inline proc AtomicT.xorBuff(value:T): void {
-    this.xor(value);
+    if commBuffersProcAtomics(T) {
+      if !isIntegral(T) then compilerError("xor is only defined for integer atomic types");
+      pragma "insert line file info" extern externFunc("xor_unordered", T)
+        proc atomic_xor_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_xor_unordered(v, _localeid(), _addr());
+    } else {
+      this.xor(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.xorBuff(value:T): void {
@@ -159,7 +223,8 @@ module BufferedAtomics {
      locale.
    */
   inline proc flushAtomicBuff(): void {
-    if CHPL_NETWORK_ATOMICS != "none" {
+    if CHPL_NETWORK_ATOMICS != "none" ||
+       CHPL_COMM == "gasnet" || CHPL_COMM == "ofi" {
       extern proc chpl_comm_atomic_unordered_fence();
       coforall loc in Locales do on loc {
         chpl_comm_atomic_unordered_fence();
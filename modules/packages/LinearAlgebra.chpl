@@ -37,6 +37,9 @@ Some procedures have implementations both with `and` without dependencies. By
 default, the implementation with dependencies will be selected. Users can
 explicitly opt out of using the :mod:`BLAS` and :mod:`LAPACK` dependent
 implementations by setting the ``blasImpl`` and ``lapackImpl`` flags to ``none``.
+The native implementations of dense matrix-matrix and matrix-vector
+multiplication are cache-blocked and run in parallel, so :proc:`dot` and
+:proc:`matPow` remain reasonably fast without :mod:`BLAS`.
 
 **Building programs with no dependencies**
 
@@ -193,7 +196,8 @@ use LAPACK;
 private param usingBLAS = BLAS.header != '';
 private param usingLAPACK = LAPACK.header != '';
 
-// TODO: compilerError if matrices are distributed
+// TODO: compilerError if matrices are distributed (other than dot() of
+//       Block-distributed matrices)
 
 //
 // Error hierarchy
@@ -555,6 +559,46 @@ proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType) where isDefaultRectangularArr(
     return matMult(A, B);
 }
 
+/*
+    Matrix multiplication of ``Block``-distributed matrices ``A`` and
+    ``B``, which returns a matrix distributed over the same grid of locales
+    as ``A``.
+
+    The product is computed with the SUMMA algorithm.  Each locale owns
+    a block of the result.  It walks the inner dimension in panels: for
+    each panel it bulk-copies the rows of ``A`` and the columns of ``B``
+    that its block needs, and multiplies them with the native GEMM kernel.
+    It fetches the next panel while it multiplies the current one.
+*/
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where _isBlockArr(A) && _isBlockArr(B) && Adom.rank == 2 && Bdom.rank == 2
+{
+  use BlockDist;
+
+  if !isNumericType(eltType) then
+    compilerError("dot() of Block-distributed matrices requires a numeric element type");
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
+  // Block needs a non-empty, non-strided bounding box.
+  proc bbox(r: range(?)) {
+    return if r.size == 0 then 1..1 else r.low..r.high;
+  }
+
+  const Cdom = {Adom.dim(1), Bdom.dim(2)}
+               dmapped Block(boundingBox={bbox(Adom.dim(1)), bbox(Bdom.dim(2))},
+                             targetLocales=A.targetLocales());
+  var C: [Cdom] eltType;
+  _summa(A, B, C);
+  return C;
+}
+
+pragma "no doc"
+private proc _isBlockArr(A) param {
+  use BlockDist;
+  return isArray(A) && isSubtype(A._value.type, BlockArr);
+}
+
 /* Compute the dot-product
 
   .. note::
@@ -681,17 +725,25 @@ proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 
   var Y: [Ydom] eltType;
 
-  // naive algorithm
   if !trans {
     if Adom.shape(2) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[i,..]*X[..]);
   } else {
     if Adom.shape(1) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[.., i]*X[..]);
+  }
+
+  if isNumericType(eltType) {
+    _gemv(A, X, Y, trans);
+  } else {
+    // naive algorithm
+    if !trans {
+      forall i in Ydom do
+        Y[i] = + reduce (A[i,..]*X[..]);
+    } else {
+      forall i in Ydom do
+        Y[i] = + reduce (A[.., i]*X[..]);
+    }
   }
 
   return Y;
@@ -706,16 +758,264 @@ proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
   if Adom.rank != 2 || Bdom.rank != 2 then
     compilerError("Rank sizes are not 2 and 2");
 
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
   var C: [Adom.dim(1), Bdom.dim(2)] eltType;
 
-  // naive algorithm
-  forall (i,j) in C.domain do
-    C[i,j] = + reduce (A[i,..]*B[..,j]);
+  if isNumericType(eltType) {
+    _gemm(A, B, C);
+  } else {
+    // naive algorithm
+    forall (i,j) in C.domain do
+      C[i,j] = + reduce (A[i,..]*B[..,j]);
+  }
 
   return C;
 }
 
 
+//
+// Native matrix multiplication
+//
+// These kernels are used for numeric element types when the BLAS module
+// is not available or does not support the element type.
+//
+// _gemm() follows the usual blocked GEMM structure.  C is split into
+// tiles of _gemmMC x _gemmNC elements, which are computed in parallel.
+// For each _gemmKC-deep slice of the inner dimension, a task packs the
+// corresponding blocks of A and B into contiguous buffers, laid out in
+// the order in which the micro-kernel reads them, and then computes
+// every MR x NR block of its tile in registers.  The packed block of A
+// is sized to stay in the L2 cache while the micro-kernel streams
+// through the packed block of B.
+//
+
+pragma "no doc"
+private param _gemmMC = 128,
+              _gemmKC = 256,
+              _gemmNC = 256;
+
+pragma "no doc"
+/* Rows of the register block computed by the micro-kernel */
+private proc _gemmMR(type eltType) param {
+  return if isComplexType(eltType) then 2 else 4;
+}
+
+pragma "no doc"
+/* Columns of the register block computed by the micro-kernel */
+private proc _gemmNR(type eltType) param {
+  return if isComplexType(eltType) then 4 else 8;
+}
+
+pragma "no doc"
+/* C += A * B for 2D arrays, with C sized to match A and B */
+private proc _gemm(A: [?Adom] ?eltType, B: [?Bdom] eltType,
+                   ref C: [?Cdom] eltType) {
+  param MR = _gemmMR(eltType),
+        NR = _gemmNR(eltType);
+
+  const m = Adom.dim(1).size,
+        k = Adom.dim(2).size,
+        n = Bdom.dim(2).size;
+  if m == 0 || n == 0 || k == 0 then return;
+
+  // The i-th index along a dimension is first + i*stride.
+  const (aRows, aCols) = Adom.dims(),
+        (bRows, bCols) = Bdom.dims(),
+        (cRows, cCols) = Cdom.dims();
+
+  const tiles = {0..#divceil(m, _gemmMC), 0..#divceil(n, _gemmNC)};
+
+  forall (ti, tj) in tiles
+    with (var Ap: [0..#_gemmMC*_gemmKC] eltType,
+          var Bp: [0..#_gemmKC*_gemmNC] eltType) {
+    const i0 = ti*_gemmMC, mc = min(_gemmMC, m-i0),
+          j0 = tj*_gemmNC, nc = min(_gemmNC, n-j0);
+
+    for p0 in 0..k-1 by _gemmKC {
+      const kc = min(_gemmKC, k-p0);
+
+      // Pack A[i0.., p0..] as MR-row panels, each stored column by
+      // column and zero-padded to MR rows.
+      for ir in 0..mc-1 by MR {
+        for p in 0..#kc {
+          const col = aCols.first + (p0+p)*aCols.stride;
+          for r in 0..#MR {
+            const i = ir + r;
+            Ap[ir*kc + p*MR + r] =
+              if i < mc then A[aRows.first + (i0+i)*aRows.stride, col]
+              else 0:eltType;
+          }
+        }
+      }
+
+      // Pack B[p0.., j0..] as NR-column panels, each stored row by row
+      // and zero-padded to NR columns.
+      for jr in 0..nc-1 by NR {
+        for p in 0..#kc {
+          const row = bRows.first + (p0+p)*bRows.stride;
+          for c in 0..#NR {
+            const j = jr + c;
+            Bp[jr*kc + p*NR + c] =
+              if j < nc then B[row, bCols.first + (j0+j)*bCols.stride]
+              else 0:eltType;
+          }
+        }
+      }
+
+      const ApPtr = c_ptrTo(Ap), BpPtr = c_ptrTo(Bp);
+      for jr in 0..nc-1 by NR {
+        for ir in 0..mc-1 by MR {
+          var acc: MR*(NR*eltType);
+          _gemmMicroKernel(MR, NR, kc, ApPtr + ir*kc, BpPtr + jr*kc, acc);
+
+          for r in 0..#min(MR, mc-ir) {
+            const i = cRows.first + (i0+ir+r)*cRows.stride;
+            for c in 0..#min(NR, nc-jr) do
+              C[i, cCols.first + (j0+jr+c)*cCols.stride] += acc(r+1)(c+1);
+          }
+        }
+      }
+    }
+  }
+}
+
+pragma "no doc"
+/* acc += a * b for one MR x kc panel of A and one kc x NR panel of B */
+private inline proc _gemmMicroKernel(param MR, param NR, kc: int,
+                                     a: c_ptr(?eltType), b: c_ptr(eltType),
+                                     ref acc: MR*(NR*eltType)) {
+  for p in 0..#kc {
+    const ap = a + p*MR,
+          bp = b + p*NR;
+    for param r in 1..MR {
+      const ar = ap[r-1];
+      for param c in 1..NR do
+        acc(r)(c) += ar * bp[c-1];
+    }
+  }
+}
+
+pragma "no doc"
+/* Depth of the panels of the inner dimension that _summa() moves at once */
+private param _summaPanel = 256;
+
+pragma "no doc"
+/* C = A * B, for 2D distributed arrays and a C whose distribution gives
+   each locale a single local subdomain */
+private proc _summa(A: [?Adom] ?eltType, B: [?Bdom] eltType,
+                    ref C: [?Cdom] eltType) {
+  const k = Adom.dim(2).size;
+  if k == 0 then return;
+  const aCols = Adom.dim(2),
+        bRows = Bdom.dim(1),
+        numPanels = divceil(k, _summaPanel);
+
+  coforall loc in C.targetLocales() with (ref C) do on loc {
+    const myInds = Cdom.localSubdomain(),
+          myRows = myInds.dim(1),
+          myCols = myInds.dim(2),
+          mr = myRows.size,
+          nc = myCols.size;
+
+    if mr > 0 && nc > 0 {
+      var Cloc: [0..#mr, 0..#nc] eltType;
+      var buf0 = new _summaBuffers(eltType),
+          buf1 = new _summaBuffers(eltType);
+
+      // Pull the rows of A and the columns of B for panel p.  The p-th
+      // panel covers the elements of the inner dimension with orders
+      // p*_summaPanel through p*_summaPanel+kb-1.
+      proc fetch(ref buf, p: int) {
+        const p0 = p*_summaPanel,
+              kb = min(_summaPanel, k-p0);
+        buf.ADom = {0..#mr, 0..#kb};
+        buf.BDom = {0..#kb, 0..#nc};
+        buf.Ap = A[myRows, (aCols # (p0+kb)) # -kb];
+        buf.Bp = B[(bRows # (p0+kb)) # -kb, myCols];
+      }
+
+      // Multiply panel p from 'cur' while fetching panel p+1 into 'next'.
+      proc step(ref cur, ref next, p: int) {
+        cobegin with (ref next, ref Cloc) {
+          if p+1 < numPanels then fetch(next, p+1);
+          _gemm(cur.Ap, cur.Bp, Cloc);
+        }
+      }
+
+      fetch(buf0, 0);
+      for p in 0..#numPanels by 2 {
+        step(buf0, buf1, p);
+        if p+1 < numPanels then step(buf1, buf0, p+1);
+      }
+
+      C[myInds] = Cloc;
+    }
+  }
+}
+
+pragma "no doc"
+/* One panel's worth of A and B on a locale during _summa() */
+record _summaBuffers {
+  type eltType;
+  var ADom, BDom: domain(2);
+  var Ap: [ADom] eltType;
+  var Bp: [BDom] eltType;
+}
+
+pragma "no doc"
+/* Y = A * X, or Y = transpose(A) * X if trans is true */
+private proc _gemv(A: [?Adom] ?eltType, X: [?Xdom] eltType,
+                   ref Y: [?Ydom] eltType, trans: bool) {
+  // Rows of A handled together, so that each element of X is
+  // loaded once for all of them.
+  param R = 4;
+
+  const (aRows, aCols) = Adom.dims(),
+        xInds = Xdom.dim(1),
+        yInds = Ydom.dim(1);
+  const m = aRows.size,
+        n = aCols.size;
+
+  if !trans {
+    forall i0 in 0..m-1 by R {
+      if i0 + R <= m {
+        var acc: R*eltType;
+        for (col, xi) in zip(aCols, xInds) {
+          const x = X[xi];
+          for param r in 1..R do
+            acc(r) += A[aRows.first + (i0+r-1)*aRows.stride, col] * x;
+        }
+        for param r in 1..R do
+          Y[yInds.first + (i0+r-1)*yInds.stride] = acc(r);
+      } else {
+        for i in i0..m-1 {
+          const row = aRows.first + i*aRows.stride;
+          var acc: eltType;
+          for (col, xi) in zip(aCols, xInds) do
+            acc += A[row, col] * X[xi];
+          Y[yInds.first + i*yInds.stride] = acc;
+        }
+      }
+    }
+  } else {
+    // Walk A by rows, so that its accesses are contiguous, and give
+    // each task a block of Y that stays in cache.
+    param blockSize = 1024;
+    forall j0 in 0..n-1 by blockSize {
+      const nb = min(blockSize, n-j0);
+      for (row, xi) in zip(aRows, xInds) {
+        const x = X[xi];
+        for j in j0..#nb do
+          Y[yInds.first + j*yInds.stride] +=
+            A[row, aCols.first + j*aCols.stride] * x;
+      }
+    }
+  }
+}
+
+
 /*
   Return the matrix ``A`` to the ``bth`` power, where ``b`` is a positive
   integral type.
@@ -1383,7 +1683,12 @@ matrices (2D arrays).
 
 Sparse matrices are represented as 2D arrays domain-mapped to a sparse *layout*.
 Only the ``CS(compressRows=true)`` (CSR) layout of the
-:mod:`LayoutCS` layout module is currently supported.
+:mod:`LayoutCS` layout module is currently supported, except that
+``dot`` products of a ``CS(compressRows=false)`` (CSC) matrix with a
+dense vector or matrix are also supported.
+Distributed matrices, over a sparse subdomain of a ``Block``-distributed
+domain with ``sparseLayoutType=CS``, are supported for multiplication with
+``Block``-distributed vectors; see :class:`DistributedSpMV`.
 
 See the :ref:`Sparse Primer <primers-sparse>` for more information about working
 with sparse domains and arrays in Chapel.
@@ -1554,6 +1859,30 @@ module Sparse {
     return A;
   }
 
+  /* Return a CSR matrix over parent domain: ``{1..M, 1..N}``, where
+     ``(M, N) = shape``, from nonzeros in coordinate (COO) format.
+     ``data[k]`` is the value at index ``inds[k]``.
+
+     ``inds`` does not need to be sorted.  The values of repeated indices are
+     summed.  The matrix is built in parallel, with work proportional to the
+     number of nonzeros.
+  */
+  proc CSRMatrix(shape: 2*int, data: [?nnzDom] ?eltType, inds: [nnzDom] 2*int)
+    where nnzDom.rank == 1 {
+    const (M, N) = shape;
+    var ADom = CSRDomain(M, N);
+    const (order, runStart) = ADom._value.bulkBuild(inds, withOrder=true);
+
+    var A: [ADom] eltType;
+    forall k in 1..ADom.size {
+      var sum: eltType;
+      for p in runStart[k]..runStart[k+1]-1 do
+        sum += data[order[p]];
+      A.data[k] = sum;
+    }
+    return A;
+  }
+
   /* Return a CSR domain constructed from internal representation */
   proc CSRDomain(shape: 2*int, indices: [?nnzDom], indptr: [?indDom])
     where indDom.rank == 1 && nnzDom.rank == 1 {
@@ -1577,7 +1906,12 @@ module Sparse {
 
   /*
       Generic matrix multiplication, ``A`` and ``B`` can be a scalar, dense
-      vector, or sparse matrix.
+      vector, or sparse matrix.  ``B`` can also be a dense matrix when ``A``
+      is a sparse matrix.
+
+      Sparse matrix-vector and sparse matrix-dense matrix products are
+      computed in parallel, with the rows of ``A`` divided between tasks
+      according to their number of nonzeros.
 
       .. note::
 
@@ -1593,8 +1927,12 @@ module Sparse {
 
   /* CSR matrix-(matrix|vector) multiplication */
   private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) where (isSparseArr(A) || isSparseArr(B)) {
+    // distributed matrix-vector
+    if Adom.rank == 2 && Bdom.rank == 1 && _isSparseBlockCSArr(A) {
+      return _distCSRmatvecMult(A, B);
+    }
     // matrix-vector
-    if Adom.rank == 2 && Bdom.rank == 1 {
+    else if Adom.rank == 2 && Bdom.rank == 1 {
       if !isCSArr(A) then
         halt("Only CSR format is supported for sparse multiplication");
       return _csrmatvecMult(A, B);
@@ -1607,9 +1945,13 @@ module Sparse {
     }
     // matrix-matrix
     else if Adom.rank == 2 && Bdom.rank == 2 {
-      if !isCSArr(A) || !isCSArr(B) then
-        halt("Only CSR format is supported for sparse multiplication");
-      return _csrmatmatMult(A, B);
+      if isCSArr(A) && !isSparseArr(B) {
+        return _csrmatdenseMult(A, B);
+      } else {
+        if !isCSArr(A) || !isCSArr(B) then
+          halt("Only CSR format is supported for sparse multiplication");
+        return _csrmatmatMult(A, B);
+      }
     }
     else {
       compilerError("Rank sizes are not 1 or 2");
@@ -1627,7 +1969,7 @@ module Sparse {
   }
 
 
-  /* CSR Matrix-vector multiplication */
+  /* CSR or CSC Matrix-vector multiplication */
   private proc _csrmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
                               trans=false) where isCSArr(A)
   {
@@ -1639,31 +1981,131 @@ module Sparse {
                     else {Adom.dim(1)};
     var Y: [Ydom] eltType;
 
+    // Work on the CS arrays directly, with the compressed dimension split
+    // between tasks so that each gets about the same number of nonzeros.
+    param csr = Adom._value.compressRows;
+    const chunks = Adom._value.nnzBalancedChunks();
+    const major = if csr then Adom.dim(1) else Adom.dim(2);
+    const ref start = Adom._value.startIdx,
+              idx = Adom._value.idx,
+              values = A._value.data;
+
     if !trans {
       if Adom.shape(2) != Xdom.shape(1) then
         halt("Mismatched shape in matrix-vector multiplication");
-        // TODO: Loop over non-zero rows only
-        forall i in Adom.dim(1) {
-          for j in Adom.dimIter(2, i) {
-            Y[i] += A[i, j] * X[j];
-          }
-        }
     } else {
       if Adom.shape(1) != Xdom.shape(1) then
         halt("Mismatched shape in matrix-vector multiplication");
+    }
 
+    // A * x for CSR, or transpose(x) * A for CSC: each (row|col) of the
+    // compressed dimension gathers one entry of Y.  Otherwise each scales
+    // one entry of x into Y.
+    if csr && !trans {
+      coforall chunk in chunks {
+        for i in major[chunk] {
+          var acc: eltType;
+          for jj in start[i]..start[i+1]-1 do
+            acc += values[jj] * X[idx[jj]];
+          Y[i] = acc;
+        }
+      }
+    } else {
       // Ensure same domain indices
-      ref X2 = X.reindex(Adom.dim(1));
-
-      forall i in Adom.dim(1) with (+ reduce Y) {
-        for j in Adom.dimIter(2, i) {
-          Y[j] += A[i, j] * X2[i];
+      ref X2 = X.reindex(if trans then Adom.dim(1) else Adom.dim(2));
+
+      if !csr && trans {
+        coforall chunk in chunks {
+          for i in major[chunk] {
+            var acc: eltType;
+            for jj in start[i]..start[i+1]-1 do
+              acc += values[jj] * X2[idx[jj]];
+            Y[i] = acc;
+          }
+        }
+      } else {
+        coforall chunk in chunks with (+ reduce Y) {
+          for i in major[chunk] {
+            const x = X2[i];
+            for jj in start[i]..start[i+1]-1 do
+              Y[idx[jj]] += values[jj] * x;
+          }
         }
       }
     }
     return Y;
   }
 
+  /* SparseBlock CSR matrix-Block vector multiplication */
+  private proc _distCSRmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType) {
+    use BlockDist;
+
+    if !_isBlockDom(Xdom) then
+      compilerError("Only Block-distributed vectors are supported for distributed sparse matrix-vector multiplication");
+
+    const rows = {Adom.dim(1)};
+    const Ydom = rows dmapped Block(rows, targetLocales=X.targetLocales());
+    var Y: [Ydom] eltType;
+
+    var spmv = new unmanaged DistributedSpMV(A, Xdom, Ydom);
+    spmv.apply(X, Y);
+    delete spmv;
+
+    return Y;
+  }
+
+  /* CSR or CSC matrix-dense matrix multiplication */
+  private proc _csrmatdenseMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+    where isCSArr(A)
+  {
+    if Adom.shape(2) != Bdom.shape(1) then
+      halt("Mismatched shape in matrix-matrix multiplication");
+
+    var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+
+    const (rows, aCols) = Adom.dims(),
+          (bRows, bCols) = Bdom.dims();
+    const ref start = Adom._value.startIdx,
+              idx = Adom._value.idx,
+              values = A._value.data;
+
+    // Each nonzero A[i, k] adds a multiple of row k of B to row i of C.
+    // Both rows are contiguous, so the inner loop vectorizes.
+    if Adom._value.compressRows {
+      const rowChunks = Adom._value.nnzBalancedChunks();
+
+      coforall chunk in rowChunks {
+        for i in rows[chunk] {
+          for jj in start[i]..start[i+1]-1 {
+            const a = values[jj],
+                  k = bRows.orderToIndex(aCols.indexOrder(idx[jj]));
+            for j in vectorizeOnly(bCols) do
+              C[i, j] += a * B[k, j];
+          }
+        }
+      }
+    } else {
+      // A column of A adds to any row of C, so split the columns of C,
+      // rather than A, between tasks.
+      use RangeChunk, DSIUtil;
+      const numChunks = max(1, _computeNumChunks(bCols.size));
+
+      coforall myCols in chunks(bCols, numChunks) {
+        for k in aCols {
+          const kb = bRows.orderToIndex(aCols.indexOrder(k));
+          for jj in start[k]..start[k+1]-1 {
+            const a = values[jj],
+                  i = idx[jj];
+            for j in vectorizeOnly(myCols) do
+              C[i, j] += a * B[kb, j];
+          }
+        }
+      }
+    }
+
+    return C;
+  }
+
   pragma "no doc"
   /* Sparse matrix-matrix multiplication.
 
@@ -1962,6 +2404,343 @@ module Sparse {
     return A;
   }
 
+  //
+  // Distributed sparse matrix-vector multiplication
+  //
+
+  /*
+    Sparse matrix-vector multiplication, ``y = A * x``, for a matrix ``A``
+    whose domain is a sparse subdomain of a ``Block``-distributed domain that
+    uses the ``CS`` layout with ``compressRows=true`` (a ``SparseBlock`` CSR
+    matrix), and vectors ``x`` and ``y`` over ``Block``-distributed 1D
+    domains:
+
+    .. code-block:: chapel
+
+      const Space = {1..n, 1..n} dmapped Block({1..n, 1..n},
+                                               sparseLayoutType=CS);
+      var D: sparse subdomain(Space);
+      var A: [D] real;
+      var x, y: [{1..n} dmapped Block({1..n})] real;
+      // ... fill in D, A, and x ...
+      var spmv = new owned DistributedSpMV(A, x.domain, y.domain);
+      for 1..iterations do
+        spmv.apply(x, y);
+
+    The initializer inspects the nonzero pattern of ``A`` once.  For every
+    locale holding a block of ``A``, it finds the columns that the block
+    uses, and which locales own the corresponding entries of ``x``.  Each
+    call to :proc:`apply` then moves those entries with one bulk transfer
+    per pair of locales that share any, computes each block of ``A`` from its
+    local CSR arrays, and, if the locale grid has more than one column,
+    combines the partial sums of each row with one bulk transfer per block.
+
+    This is meant for iterative methods, which multiply by the same matrix
+    many times.  A ``DistributedSpMV`` refers to the storage of ``A``, so
+    ``A`` must outlive it.  The indices of ``A`` and the distributions of
+    ``x`` and ``y`` must not change while it is in use, but the values of
+    ``A`` may.
+
+    ``dot(A, x)`` on such arrays uses a ``DistributedSpMV`` for a single
+    product.
+  */
+  class DistributedSpMV {
+    pragma "no doc"
+    type eltType;
+    pragma "no doc"
+    type arrType;
+
+    pragma "no doc"
+    var blocksDom: domain(1);
+    pragma "no doc"
+    var blocks: [blocksDom] unmanaged _SpMVBlock(eltType, arrType);
+    pragma "no doc"
+    var sendersDom: domain(1);
+    pragma "no doc"
+    var senders: [sendersDom] unmanaged _SpMVSender(eltType, arrType);
+    pragma "no doc"
+    var receiversDom: domain(1);
+    pragma "no doc"
+    var receivers: [receiversDom] unmanaged _SpMVReceiver(eltType, arrType);
+
+    /*
+      Compute the communication pattern of products ``A * x`` where ``x``
+      is over ``xDom`` and the result is stored in an array over ``yDom``.
+    */
+    proc init(A: [?Adom] ?eltType, xDom: domain, yDom: domain)
+      where _isSparseBlockCSArr(A) {
+      this.eltType = eltType;
+      const AV = A._value;
+      this.arrType = AV.locArr[AV.locArrDom.low].myElems._value.type;
+      blocksDom = {0..#AV.locArrDom.size};
+      sendersDom = {0..#xDom.targetLocales().size};
+      receiversDom = {0..#yDom.targetLocales().size};
+      this.complete();
+
+      if !_isBlockDom(xDom) || !_isBlockDom(yDom) ||
+         xDom.rank != 1 || yDom.rank != 1 then
+        compilerError("DistributedSpMV requires Block-distributed 1D vectors");
+      if xDom.stridable || yDom.stridable then
+        compilerError("DistributedSpMV does not support strided vectors");
+      if !A._value.sparseLayoutType.compressRows then
+        compilerError("DistributedSpMV requires a CSR matrix: ",
+                      "sparseLayoutType=CS(compressRows=true)");
+      if Adom.dim(2) != xDom.dim(1) || Adom.dim(1) != yDom.dim(1) then
+        halt("Mismatched indices in DistributedSpMV: ",
+             "A is over ", Adom.parentDom, ", x over ", xDom, ", y over ", yDom);
+
+      const xV = xDom._value,
+            yV = yDom._value;
+      const xRanges = [i in xV.dist.targetLocDom] xV.locDoms[i].myBlock.dim(1);
+
+      // Each block finds the entries of x it uses, and which locale owns them
+      coforall (b, li) in zip(blocksDom, AV.locArrDom) {
+        on AV.dom.dist.targetLocales(li) {
+          const blk = new unmanaged _SpMVBlock(eltType, arrType,
+                                               AV.locArr[li].myElems._value);
+          blk.setup(xRanges);
+          blocks[b] = blk;
+        }
+      }
+
+      // Each locale owning part of x collects the requests for it
+      coforall (s, xi) in zip(sendersDom, xV.dist.targetLocDom) {
+        on xV.dist.targetLocales(xi) {
+          const snd = new unmanaged _SpMVSender(eltType, arrType);
+          snd.setup(blocks, xi);
+          senders[s] = snd;
+        }
+      }
+
+      // Each locale owning part of y finds the blocks that contribute to it
+      coforall (r, yi) in zip(receiversDom, yV.dist.targetLocDom) {
+        on yV.dist.targetLocales(yi) {
+          const rcv = new unmanaged _SpMVReceiver(eltType, arrType);
+          rcv.setup(blocks, yV.locDoms[yi].myBlock.dim(1));
+          receivers[r] = rcv;
+        }
+      }
+    }
+
+    pragma "no doc"
+    proc deinit() {
+      coforall b in blocks do on b do delete b;
+      coforall s in senders do on s do delete s;
+      coforall r in receivers do on r do delete r;
+    }
+
+    /*
+      Compute ``y = A * x``, with the current values of ``A``.  ``x`` and
+      ``y`` must be over the ``xDom`` and ``yDom`` this ``DistributedSpMV``
+      was created with, or over domains distributed the same way.
+    */
+    proc apply(x: [] eltType, ref y: [] eltType) {
+      // Send each block the entries of x that it uses
+      coforall snd in senders do on snd {
+        snd.send(x._value.myLocArr.myElems);
+      }
+
+      // Compute each block, directly into y if it is the only contributor
+      // to this locale's part of y
+      coforall blk in blocks do on blk {
+        if blk.directY then
+          blk.compute(y._value.myLocArr.myElems);
+        else
+          blk.compute(blk.part);
+      }
+
+      // Sum the partial results of the other blocks into y
+      coforall rcv in receivers do on rcv {
+        if !rcv.direct then
+          rcv.receive(y._value.myLocArr.myElems);
+      }
+    }
+  }
+
+  pragma "no doc"
+  /* The part of a DistributedSpMV for a locale's block of the matrix */
+  class _SpMVBlock {
+    type eltType;
+    type arrType;
+    const arr: arrType;
+
+    /* The partial result for this block's rows, unless directY */
+    var partDom: domain(1);
+    var part: [partDom] eltType;
+    var directY = false;
+
+    /* The entries of x that this block uses, ordered by index */
+    var neededDom: domain(1);
+    var needed: [neededDom] int;
+    var ghost: [neededDom] eltType;
+
+    /* The position in 'ghost' of each nonzero's column */
+    var ghostColDom: domain(1);
+    var ghostCol: [ghostColDom] int;
+
+    /* For each locale owning part of x, the range of 'needed' it owns */
+    var requestDom: domain(1);
+    var requests: [requestDom] range;
+
+    proc init(type eltType, type arrType, arr: arrType) {
+      this.eltType = eltType;
+      this.arrType = arrType;
+      this.arr = arr;
+    }
+
+    proc setup(xRanges) {
+      const csr = arr.dom;
+      const cols = csr.colRange,
+            nnz = csr.nnz;
+
+      var pos: [cols] int;
+      for k in 1..nnz do
+        pos[csr.idx[k]] = 1;
+
+      var numNeeded = 0;
+      for j in cols do
+        if pos[j] != 0 {
+          numNeeded += 1;
+          pos[j] = numNeeded;
+        }
+
+      neededDom = {1..numNeeded};
+      forall j in cols do
+        if pos[j] != 0 then needed[pos[j]] = j;
+
+      ghostColDom = {1..nnz};
+      forall k in 1..nnz do
+        ghostCol[k] = pos[csr.idx[k]];
+
+      // 'needed' is sorted, and x is split into ascending ranges
+      requestDom = xRanges.domain;
+      var p = 1;
+      for (req, xr) in zip(requests, xRanges) {
+        const first = p;
+        while p <= numNeeded && needed[p] <= xr.high do p += 1;
+        req = first..p-1;
+      }
+
+      partDom = {csr.rowRange};
+    }
+
+    proc compute(ref y) {
+      const csr = arr.dom;
+      const ref rowStart = csr.startIdx,
+                vals = arr.data;
+      const rows = csr.rowRange;
+      coforall chunk in csr.nnzBalancedChunks() {
+        for i in rows[chunk] {
+          var acc: eltType;
+          for jj in rowStart[i]..rowStart[i+1]-1 do
+            acc += vals[jj] * ghost[ghostCol[jj]];
+          y[i] = acc;
+        }
+      }
+    }
+  }
+
+  pragma "no doc"
+  /* The part of a DistributedSpMV for a locale's part of x */
+  class _SpMVSender {
+    type eltType;
+    type arrType;
+
+    /* The blocks that use entries of x from this locale */
+    var destDom: domain(1);
+    var dests: [destDom] unmanaged _SpMVBlock(eltType, arrType);
+    /* Where each block's entries go in its 'ghost', and in 'sendIdx' */
+    var destRange, sendRange: [destDom] range;
+
+    /* The indices of the entries to send, grouped by block */
+    var sendDom: domain(1);
+    var sendIdx: [sendDom] int;
+    var sendBuf: [sendDom] eltType;
+
+    proc setup(blocks, myIdx) {
+      const blockRefs = blocks;
+      var myRequests: [blockRefs.domain] range;
+      forall (req, blk) in zip(myRequests, blockRefs) do
+        req = blk.requests[myIdx];
+
+      var numDests = 0, numSend = 0;
+      for req in myRequests do
+        if req.size > 0 {
+          numDests += 1;
+          numSend += req.size;
+        }
+
+      destDom = {0..#numDests};
+      sendDom = {1..numSend};
+      var d = 0, next = 1;
+      for (req, blk) in zip(myRequests, blockRefs) {
+        if req.size == 0 then continue;
+        dests[d] = blk;
+        destRange[d] = req;
+        sendRange[d] = next..#req.size;
+        sendIdx[sendRange[d]] = blk.needed[req];
+        d += 1;
+        next += req.size;
+      }
+    }
+
+    proc send(const ref xLocal) {
+      forall (v, i) in zip(sendBuf, sendIdx) do
+        v = xLocal[i];
+      forall d in destDom do
+        dests[d].ghost[destRange[d]] = sendBuf[sendRange[d]];
+    }
+  }
+
+  pragma "no doc"
+  /* The part of a DistributedSpMV for a locale's part of y */
+  class _SpMVReceiver {
+    type eltType;
+    type arrType;
+
+    /* The blocks with rows in this part of y, and those rows */
+    var srcDom: domain(1);
+    var srcs: [srcDom] unmanaged _SpMVBlock(eltType, arrType);
+    var srcRows: [srcDom] range;
+
+    /* Whether the only source computes directly into y */
+    var direct = false;
+
+    proc setup(blocks, myRows) {
+      const blockRefs = blocks;
+      var rows: [blockRefs.domain] range;
+      forall (r, blk) in zip(rows, blockRefs) do
+        r = blk.arr.dom.rowRange[myRows];
+
+      srcDom = {0..#(+ reduce [r in rows] (r.size > 0):int)};
+      var s = 0;
+      for (r, blk) in zip(rows, blockRefs) {
+        if r.size == 0 then continue;
+        srcs[s] = blk;
+        srcRows[s] = r;
+        s += 1;
+      }
+
+      if srcDom.size == 1 && srcs[0].locale == here &&
+         srcRows[0] == myRows && srcs[0].arr.dom.rowRange == myRows {
+        direct = true;
+        srcs[0].directY = true;
+      }
+    }
+
+    proc receive(ref yLocal) {
+      yLocal = 0: eltType;
+      for (src, r) in zip(srcs, srcRows) {
+        if src.locale == here {
+          yLocal[r] += src.part[r];
+        } else {
+          const part: [r] eltType = src.part[r];
+          yLocal[r] += part;
+        }
+      }
+    }
+  }
+
   //
   // Type helpers
   //
@@ -1969,6 +2748,17 @@ module Sparse {
   proc isCSArr(A: []) param { return isCSType(A.domain.dist.type); }
   pragma "no doc"
   proc isCSDom(D: domain) param { return isCSType(D.dist.type); }
+  pragma "no doc"
+  proc _isSparseBlockCSArr(A: []) param {
+    use SparseBlockDist;
+    return isSubtype(A._value.type, SparseBlockArr) &&
+           isCSType(A._value.sparseLayoutType);
+  }
+  pragma "no doc"
+  proc _isBlockDom(D: domain) param {
+    use BlockDist;
+    return isSubtype(D._value.type, BlockDom);
+  }
 
 } // submodule LinearAlgebra.Sparse
 
@@ -195,6 +195,29 @@ const defaultComparator: DefaultComparator;
 const reverseComparator: ReverseComparator(DefaultComparator);
 
 
+/*
+   Arrays at least this long are sorted by :proc:`sort` with
+   :proc:`radixSort`, when their keys allow it.
+ */
+private param radixSortMinLen = 4096;
+
+/*
+   Arrays at least this long are sorted by :proc:`sort` with
+   :proc:`sampleSort`, when they can't be radix sorted.
+ */
+private param sampleSortMinLen = 65536;
+
+/*
+   Arrays at least this long that are distributed over more than one
+   locale are sorted by :proc:`sort` with a distributed sample sort.
+ */
+private param distSortMinLen = 65536;
+
+/* Number of key bits each radix sort pass handles, and the digit range. */
+private param radixDigitBits = 11,
+              radixBuckets = 1 << radixDigitBits;
+
+
 /* Private methods */
 
 pragma "no doc"
@@ -242,25 +265,26 @@ pragma "no doc"
       data is sorted.
 
  */
-proc chpl_check_comparator(comparator, type eltType) {
+proc chpl_check_comparator(comparator, type eltType) param {
   use Reflection;
 
-  // Dummy data for checking method resolution
-  // This may need updating when constructors support non-default args
-  const data: eltType;
-
+  // Since this is a param function, none of this runs at run time, and
+  // chpl_sortStandIn() stands in for values without creating any.
   if comparator.type == DefaultComparator {}
   // Check for valid comparator methods
-  else if canResolveMethod(comparator, "key", data) {
+  else if canResolveMethod(comparator, "key", chpl_sortStandIn(eltType)) {
     // Check return type of key
-    const keydata = comparator.key(data);
-    type keytype = keydata.type;
-    if !(canResolve("<", keydata, keydata)) then
+    type keytype = chpl_sortKeyType(eltType, comparator);
+    if !(canResolve("<", chpl_sortStandIn(keytype),
+                         chpl_sortStandIn(keytype))) then
       compilerError("The key method must return an object that supports the '<' function");
   }
-  else if canResolveMethod(comparator, "compare", data, data) {
+  else if canResolveMethod(comparator, "compare", chpl_sortStandIn(eltType),
+                                                  chpl_sortStandIn(eltType)) {
     // Check return type of compare
-    type comparetype = comparator.compare(data, data).type;
+    type comparetype = __primitive("static typeof",
+        comparator.compare(chpl_sortStandIn(eltType),
+                           chpl_sortStandIn(eltType)));
     if !(isNumericType(comparetype)) then
       compilerError("The compare method must return a numeric type");
   }
@@ -268,6 +292,18 @@ proc chpl_check_comparator(comparator, type eltType) {
     // If we make it this far, the passed comparator was defined incorrectly
     compilerError("The comparator record requires a 'key(a)' or 'compare(a, b)' method");
   }
+  return true;
+}
+
+
+pragma "no doc"
+/*
+   A reference to a value of type `t`, for resolving calls on one inside
+   ``__primitive("static typeof")`` or a param function.  It must not be
+   called at run time: it dereferences nil.
+ */
+proc chpl_sortStandIn(type t, p: c_ptr(t) = nil) ref : t {
+  return p.deref();
 }
 
 
@@ -276,6 +312,19 @@ proc chpl_check_comparator(comparator, type eltType) {
 /*
    General purpose sorting interface.
 
+   Small arrays are sorted with :proc:`quickSort`.  Larger ones are sorted
+   with :proc:`radixSort` when the sort key is an integral or real value,
+   and otherwise with :proc:`sampleSort` when more than one task can run.
+
+   Large arrays distributed over more than one locale with a distribution
+   that gives each locale a single local subdomain, such as ``Block`` or
+   ``Cyclic``, are sorted with a distributed sample sort, unless their
+   elements are class instances.  Each locale
+   sorts its own elements with the rules above, the locales agree on
+   splitters that divide the elements evenly among them, and then each
+   locale gathers its share from the others with bulk transfers, sorts it,
+   and stores it back into `Data`.
+
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
    :arg comparator: :ref:`Comparator <comparators>` record that defines how the
@@ -283,7 +332,18 @@ proc chpl_check_comparator(comparator, type eltType) {
 
  */
 proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
-  quickSort(Data, comparator=comparator);
+  chpl_check_comparator(comparator, eltType);
+  const n = Dom.size;
+  if !isClassType(eltType) &&
+     Dom.hasSingleLocalSubdomain() && !Dom.stridable &&
+     n >= distSortMinLen && Data.targetLocales().size > 1 then
+    _distributedSort(Data, comparator);
+  else if chpl_radixSortable(eltType, comparator) && n >= radixSortMinLen then
+    radixSort(Data, comparator=comparator);
+  else if n >= sampleSortMinLen && _sortNumTasks(n) > 1 then
+    sampleSort(Data, comparator=comparator);
+  else
+    quickSort(Data, comparator=comparator);
 }
 
 
@@ -357,7 +417,7 @@ proc isSorted(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
  */
 iter sorted(x, comparator:?rec=defaultComparator) {
   var y = x;
-  quickSort(y, comparator=comparator);
+  sort(y, comparator=comparator);
   for i in y do
     yield i;
 }
@@ -803,6 +863,444 @@ proc selectionSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
 }
 
 
+/*
+   Sort the 1D array `Data` using a parallel, stable LSD radix sort.
+
+   Radix sorting works on the bits of a key rather than by comparing
+   elements, so it is only available when the sort key is an integral or
+   real value: either the elements themselves, with the default
+   comparator, or the result of the comparator's ``key(a)`` method.
+   Each pass handles 11 bits of the key, and passes in which every key has
+   the same 11 bits are skipped, so keys of a narrow range sort in fewer
+   passes.  The sort uses two temporary arrays the size of `Data`.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.  It must be the default comparator or have a ``key(a)``
+      method returning an integral or real value.
+
+ */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+  if !chpl_radixSortable(eltType, comparator) then
+    compilerError("radixSort() requires integral or real keys");
+
+  const n = Dom.size;
+  if n <= 1 then return;
+
+  var A, B: [0..#n] eltType;
+  forall (a, d) in zip(A, Data) do a = d;
+
+  const nTasks = _sortNumTasks(n);
+  type keyType = chpl_sortKeyType(eltType, comparator);
+  param nPasses = (numBits(keyType) + radixDigitBits - 1) / radixDigitBits;
+
+  var counts: [0..#radixBuckets*nTasks] int;
+  var inA = true;
+
+  for pass in 0..#nPasses {
+    const shift = (pass * radixDigitBits): uint;
+    const skipped = if inA then _radixPass(A, B, counts, nTasks, shift, comparator)
+                           else _radixPass(B, A, counts, nTasks, shift, comparator);
+    if !skipped then inA = !inA;
+  }
+
+  if inA then
+    forall (d, a) in zip(Data, A) do d = a;
+  else
+    forall (d, b) in zip(Data, B) do d = b;
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("radixSort() requires 1-D array");
+}
+
+
+pragma "no doc"
+/*
+   The type of the value that radix sorting works on: the element type
+   for the default comparator, otherwise the type returned by the
+   comparator's key method, or ``void`` if it has none.
+ */
+proc chpl_sortKeyType(type eltType, comparator) type {
+  use Reflection;
+  if comparator.type == DefaultComparator then
+    return eltType;
+  else if canResolveMethod(comparator, "key", chpl_sortStandIn(eltType)) then
+    return __primitive("static typeof",
+                       comparator.key(chpl_sortStandIn(eltType)));
+  else
+    return void;
+}
+
+
+pragma "no doc"
+proc chpl_radixSortable(type eltType, comparator) param {
+  type keyType = chpl_sortKeyType(eltType, comparator);
+  return isIntegralType(keyType) || isRealType(keyType);
+}
+
+
+/*
+   The bits of a key, as an unsigned integer that orders the same way
+   the key does.  Keys narrower than 64 bits are zero-extended.
+ */
+private inline proc _radixBits(k: integral): uint {
+  param w = numBits(k.type);
+  if isIntType(k.type) then
+    return ((k: uint(w)) ^ (1: uint(w) << (w - 1))): uint;
+  else
+    return k: uint;
+}
+
+private inline proc _radixBits(k: real(64)): uint {
+  var x = k;
+  const u = (c_ptrTo(x): c_ptr(uint(64)))[0];
+  return if u >> 63 then ~u else u | (1: uint << 63);
+}
+
+private inline proc _radixBits(k: real(32)): uint {
+  var x = k;
+  const u = (c_ptrTo(x): c_ptr(uint(32)))[0];
+  return (if u >> 31 then ~u else u | (1: uint(32) << 31)): uint;
+}
+
+private inline proc _radixDigit(a, shift: uint, comparator) {
+  if comparator.type == DefaultComparator then
+    return ((_radixBits(a) >> shift) & (radixBuckets - 1)): int;
+  else
+    return ((_radixBits(comparator.key(a)) >> shift) & (radixBuckets - 1)): int;
+}
+
+
+/*
+   Number of tasks to use on an array of n elements: enough to use the
+   locale, but not so many that each task has too little to do.
+ */
+private proc _sortNumTasks(n: int) {
+  const minPerTask = 4096;
+  const numTasks = if dataParTasksPerLocale==0 then here.maxTaskPar
+                   else dataParTasksPerLocale;
+  return max(1, min(numTasks, n / minPerTask));
+}
+
+private inline proc _sortTaskChunk(n: int, nTasks: int, tid: int) {
+  return (tid * n / nTasks)..#((tid + 1) * n / nTasks - tid * n / nTasks);
+}
+
+
+/*
+   One pass of LSD radix sort, moving Src into Dst ordered by the key
+   digit at 'shift'.  Each task counts the digits in its own chunk of Src,
+   and counts is laid out digit-major so that an exclusive scan of it
+   gives each task the place in Dst for each of its digits.  Returns true
+   without moving anything if all the keys have the same digit.
+ */
+private proc _radixPass(Src: [] ?eltType, Dst: [] eltType, counts: [] int,
+                        nTasks: int, shift: uint, comparator): bool
+  lifetime Dst < Src {
+  const n = Src.size;
+
+  coforall tid in 0..#nTasks with (ref counts) {
+    var hist: c_array(int, radixBuckets);
+    for i in _sortTaskChunk(n, nTasks, tid) do
+      hist[_radixDigit(Src[i], shift, comparator)] += 1;
+    for d in 0..#radixBuckets do
+      counts[d*nTasks + tid] = hist[d];
+  }
+
+  var sum = 0;
+  for d in 0..#radixBuckets {
+    var digitTotal = 0;
+    for tid in 0..#nTasks do
+      digitTotal += counts[d*nTasks + tid];
+    if digitTotal == n then return true;
+  }
+  for c in counts {
+    const cnt = c;
+    c = sum;
+    sum += cnt;
+  }
+
+  coforall tid in 0..#nTasks {
+    var offsets: c_array(int, radixBuckets);
+    for d in 0..#radixBuckets do
+      offsets[d] = counts[d*nTasks + tid];
+    for i in _sortTaskChunk(n, nTasks, tid) {
+      const d = _radixDigit(Src[i], shift, comparator);
+      Dst[offsets[d]] = Src[i];
+      offsets[d] += 1;
+    }
+  }
+  return false;
+}
+
+
+pragma "no doc"
+/*
+   One locale's elements during a distributed sort, sorted.  The runs of
+   them bound for other locales are pulled from here by those locales.
+ */
+class _DistSortBucket {
+  type eltType;
+  var D: domain(1);
+  var A: [D] eltType;
+}
+
+
+pragma "no doc"
+/*
+   Orders the indices of the samples of a distributed sort by sample,
+   breaking ties by index.
+ */
+record _DistSortSampleComparator {
+  const Samples;
+  var comparator;
+
+  proc compare(i: int, j: int) {
+    const c = chpl_compare(Samples[i], Samples[j], comparator);
+    if c < 0 then return -1;
+    if c > 0 then return 1;
+    return i - j;
+  }
+}
+
+
+/*
+   Distributed sample sort of a 1D array that has one local subdomain
+   per target locale.
+ */
+private proc _distributedSort(Data: [?Dom] ?eltType, comparator) {
+  const P = Data.targetLocales().size,
+        oversample = 64;
+  var TL: [0..#P] locale;
+  for (t, l) in zip(TL, Data.targetLocales()) do t = l;
+
+  // Each locale copies out and sorts its own elements, then contributes
+  // evenly spaced samples of them for choosing splitters.  Equal
+  // elements are ordered by locale and then by position in the locale's
+  // sorted elements, so that runs of equal keys can be split between
+  // locales too; each sample records where it came from.
+  var Buckets: [0..#P] unmanaged _DistSortBucket(eltType);
+  var Samples: [0..#P*oversample] eltType;
+  var SamplePos: [0..#P*oversample] int;
+  var nSamples: [0..#P] int;
+
+  coforall p in 0..#P do on TL[p] {
+    const MyInds = Dom.localSubdomain();
+    const b = new unmanaged _DistSortBucket(eltType, {0..#MyInds.size});
+    forall (a, i) in zip(b.A, MyInds) do a = Data[i];
+    sort(b.A, comparator=comparator);
+    Buckets[p] = b;
+
+    const m = b.D.size;
+    if m > 0 {
+      var MySamples: [0..#oversample] eltType;
+      var MyPos: [0..#oversample] int;
+      for i in 0..#oversample {
+        MyPos[i] = (2*i + 1) * m / (2*oversample);
+        MySamples[i] = b.A[MyPos[i]];
+      }
+      Samples[p*oversample..#oversample] = MySamples;
+      SamplePos[p*oversample..#oversample] = MyPos;
+      nSamples[p] = oversample;
+    }
+  }
+
+  // The splitters divide the samples into P equal parts.  Samples are
+  // laid out by locale and position, so sorting their indices with ties
+  // broken by index orders them by (element, locale, position).
+  var Order: [0..#(+ reduce nSamples)] int;
+  var next = 0;
+  for p in 0..#P {
+    if nSamples[p] > 0 {
+      Order[next..#oversample] = p*oversample..#oversample;
+      next += oversample;
+    }
+  }
+  sampleSort(Order,
+             comparator=new _DistSortSampleComparator(Samples, comparator));
+  var Splitters: [0..#P-1] eltType;
+  var SplitterLocs, SplitterPos: [0..#P-1] int;
+  for q in 0..#P-1 {
+    const k = Order[(q + 1) * Order.size / P];
+    Splitters[q] = Samples[k];
+    SplitterLocs[q] = k / oversample;
+    SplitterPos[q] = SamplePos[k];
+  }
+
+  // Each locale finds where its sorted elements cross the splitters.
+  // Counts[p, q] is how many of locale p's elements go to locale q.
+  var Starts, Counts: [0..#P, 0..#P] int;
+
+  coforall p in 0..#P do on TL[p] {
+    const MySplitters = Splitters,
+          MySplitterLocs = SplitterLocs,
+          MySplitterPos = SplitterPos;
+    const b = Buckets[p];
+    var MyStarts: [0..#P+1] int;
+    MyStarts[P] = b.D.size;
+    for q in 0..#P-1 {
+      const sp = MySplitterLocs[q], spos = MySplitterPos[q];
+      var lo = MyStarts[q], hi = b.D.size;
+      while lo < hi {
+        const mid = (lo + hi) / 2;
+        const c = chpl_compare(b.A[mid], MySplitters[q], comparator);
+        if c < 0 || (c == 0 && (p < sp || (p == sp && mid < spos))) then
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      MyStarts[q+1] = lo;
+    }
+    Starts[p, ..] = MyStarts[0..#P];
+    Counts[p, ..] = [q in 0..#P] MyStarts[q+1] - MyStarts[q];
+  }
+
+  // Locale q's elements go to Data starting at the total bound for the
+  // locales before it.
+  var Firsts: [0..#P] int;
+  for q in 1..#P-1 do
+    Firsts[q] = Firsts[q-1] + (+ reduce Counts[.., q-1]);
+
+  // Each locale pulls its bucket from every locale with bulk transfers,
+  // merges the sorted runs it got by sorting them, and stores the result.
+  coforall q in 0..#P do on TL[q] {
+    const MyStarts = Starts[.., q],
+          MyCounts = Counts[.., q];
+    const total = + reduce MyCounts;
+    var R: [0..#total] eltType;
+    var off = 0;
+    for p in 0..#P {
+      const cnt = MyCounts[p];
+      if cnt > 0 {
+        const b = Buckets[p];
+        R[off..#cnt] = b.A[MyStarts[p]..#cnt];
+      }
+      off += cnt;
+    }
+    sort(R, comparator=comparator);
+    if total > 0 then
+      Data[Dom.low + Firsts[q]..#total] = R;
+  }
+
+  coforall p in 0..#P do on TL[p] do
+    delete Buckets[p];
+}
+
+
+/*
+   Sort the 1D array `Data` using a parallel sample sort algorithm.
+
+   A sample of `Data` is sorted to choose splitters that divide the
+   elements into buckets of about equal size.  The elements are moved to
+   their buckets in parallel and the buckets are then sorted in parallel
+   with :proc:`quickSort`.  This works with any comparator.  The sort uses
+   two temporary arrays the size of `Data`.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  use DynamicIters;
+
+  chpl_check_comparator(comparator, eltType);
+
+  const n = Dom.size;
+  const nTasks = _sortNumTasks(n);
+  if nTasks == 1 && !Dom.stridable {
+    quickSort(Data, comparator=comparator);
+    return;
+  }
+
+  // Oversampling makes the bucket sizes even out; having several
+  // buckets per task lets the bucket sorts balance across tasks.
+  const nBuckets = 4 * nTasks,
+        oversample = 32,
+        nSamples = nBuckets * oversample;
+
+  var A, B: [0..#n] eltType;
+  forall (a, d) in zip(A, Data) do a = d;
+
+  // Take the sample from scattered (but repeatable) positions, so that
+  // already-ordered runs in the input don't skew it.
+  var Samples: [0..#nSamples] eltType;
+  forall i in 0..#nSamples do
+    Samples[i] = A[((i: uint * 0x9E3779B97F4A7C15) % n: uint): int];
+  quickSort(Samples, comparator=comparator);
+
+  var Splitters: [0..#nBuckets-1] eltType;
+  forall b in 0..#nBuckets-1 do
+    Splitters[b] = Samples[(b + 1) * oversample];
+
+  // Bucket b gets the elements at least Splitters[b-1] and less than
+  // Splitters[b].
+  inline proc bucketOf(x) {
+    var lo = 0, hi = nBuckets - 1;
+    while lo < hi {
+      const mid = (lo + hi) / 2;
+      if chpl_compare(x, Splitters[mid], comparator) < 0 then
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  }
+
+  var counts: [0..#nBuckets*nTasks] int;
+  coforall tid in 0..#nTasks with (ref counts) {
+    var hist: [0..#nBuckets] int;
+    for i in _sortTaskChunk(n, nTasks, tid) do
+      hist[bucketOf(A[i])] += 1;
+    for b in 0..#nBuckets do
+      counts[b*nTasks + tid] = hist[b];
+  }
+
+  var sum = 0;
+  for c in counts {
+    const cnt = c;
+    c = sum;
+    sum += cnt;
+  }
+
+  coforall tid in 0..#nTasks {
+    var offsets: [0..#nBuckets] int;
+    for b in 0..#nBuckets do
+      offsets[b] = counts[b*nTasks + tid];
+    for i in _sortTaskChunk(n, nTasks, tid) {
+      const b = bucketOf(A[i]);
+      B[offsets[b]] = A[i];
+      offsets[b] += 1;
+    }
+  }
+
+  forall b in dynamic(0..#nBuckets) {
+    const lo = counts[b*nTasks],
+          hi = if b == nBuckets - 1 then n - 1 else counts[(b+1)*nTasks] - 1;
+    if lo < hi then
+      quickSort(B[lo..hi], comparator=comparator);
+  }
+
+  forall (d, b) in zip(Data, B) do d = b;
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("sampleSort() requires 1-D array");
+}
+
+
 /* Comparators */
 
 /* Default comparator used in sort functions.*/
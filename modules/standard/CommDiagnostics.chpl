@@ -137,6 +137,30 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Attributing Communication to Source Lines**
+
+  The counts above say how much communication a program did, but not
+  where it came from.  If the environment variable
+  ``CHPL_RT_COMM_DIAGS_SOURCE_LINES`` is set to ``true`` when the
+  program is run, then while communication is being counted, remote
+  GETs and PUTs are also counted per source line, along with the
+  number of bytes they moved.  The lines responsible for the most
+  communication can then be reported::
+
+    startCommDiagnostics();
+    // ...
+    stopCommDiagnostics();
+    // report the 10 source lines that moved the most bytes
+    printCommDiagnosticsSourceLines(10);
+
+  Each line of the report gives the file name and line number, the
+  number of remote operations and the number of bytes, summed across
+  all locales::
+
+    t.chpl:6: 2 ops, 16 bytes
+
+  Resetting the counters also resets the per-line counts.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -212,9 +236,26 @@ module CommDiagnostics
      */
     var execute_on_fast: uint(64);
     /*
-      non-blocking remote executions
+      non-blocking remote executions.  Under ``CHPL_COMM=ofi`` with
+      ``CHPL_RT_COMM_OFI_AGG_EXECUTE_ON=true``, small non-blocking remote
+      executions to the same locale are sent together, and this counts
+      the messages sent rather than the executions.
      */
     var execute_on_nb: uint(64);
+    /*
+      remote data cache GETs satisfied from the locale-wide shared read
+      cache (see ``CHPL_RT_CACHE_REMOTE_SHARED``)
+     */
+    var cache_shared_hit: uint(64);
+    /*
+      remote data cache GETs that missed in the shared read cache
+     */
+    var cache_shared_miss: uint(64);
+    /*
+      remote data cache GETs that waited for another thread's
+      outstanding GET of the same page in the shared read cache
+     */
+    var cache_shared_dedup: uint(64);
 
     proc writeThis(c) {
       use Reflection;
@@ -258,6 +299,16 @@ module CommDiagnostics
 
   private extern proc chpl_getCommDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_comm_diags_src_line_capacity(): int;
+
+  private extern proc chpl_comm_diags_src_line_get(i: int,
+                                                   ref ln: int(32),
+                                                   ref fn: int(32),
+                                                   ref ops: uint(64),
+                                                   ref bytes: uint(64)): bool;
+
+  private extern proc chpl_lookupFilename(idx: int(32)): c_string;
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -348,6 +399,107 @@ module CommDiagnostics
   }
 
 
+  /*
+    Communication counts for one source line, as returned by
+    :proc:`getCommDiagnosticsSourceLines`.
+   */
+  record commDiagnosticsSourceLine {
+    /* the source file name */
+    var file: string;
+    /* the line number, or -1 for lines that could not be tracked
+       individually */
+    var line: int;
+    /* the number of remote GETs and PUTs done for this line */
+    var ops: uint(64);
+    /* the number of bytes moved by those GETs and PUTs */
+    var bytes: uint(64);
+
+    proc writeThis(c) {
+      if line < 0 then
+        c <~> "<other lines>";
+      else
+        c <~> file <~> ":" <~> line;
+      c <~> ": " <~> ops <~> " ops, " <~> bytes <~> " bytes";
+    }
+  }
+
+  /*
+    Retrieve the source lines that moved the most bytes in remote GETs
+    and PUTs while communication was being counted, summed across all
+    locales.  This requires ``CHPL_RT_COMM_DIAGS_SOURCE_LINES`` to be
+    set when the program is run; otherwise no lines are returned.
+
+    :arg n: the maximum number of lines to return
+    :returns: up to `n` lines, in order of decreasing bytes
+    :rtype: `[] commDiagnosticsSourceLine`
+   */
+  proc getCommDiagnosticsSourceLines(n: int = 10) {
+    var lineDom: domain(2*int);
+    var ops, bytes: [lineDom] uint(64);
+
+    for loc in Locales {
+      var cap: int;
+      on loc do cap = chpl_comm_diags_src_line_capacity();
+
+      // (fn, ln, ops, bytes) for each table entry on loc; ops is 0 for
+      // unused entries
+      var entries: [0..#cap] (int, int, uint(64), uint(64));
+      on loc {
+        var myEntries: [0..#cap] (int, int, uint(64), uint(64));
+        for i in 0..#cap {
+          var ln, fn: int(32);
+          var o, b: uint(64);
+          if chpl_comm_diags_src_line_get(i, ln, fn, o, b) then
+            myEntries[i] = (fn:int, ln:int, o, b);
+        }
+        entries = myEntries;
+      }
+
+      for (fn, ln, o, b) in entries {
+        if o != 0 {
+          lineDom += (fn, ln);
+          ops[(fn, ln)] += o;
+          bytes[(fn, ln)] += b;
+        }
+      }
+    }
+
+    // Pick out the top n by repeatedly selecting the largest remaining.
+    const numLines = min(n, lineDom.size);
+    var result: [0..#numLines] commDiagnosticsSourceLine;
+    var taken: [lineDom] bool;
+    for r in result {
+      var best: 2*int;
+      var found = false;
+      for key in lineDom {
+        if !taken[key] &&
+           (!found || bytes[key] > bytes[best] ||
+            (bytes[key] == bytes[best] && ops[key] > ops[best])) {
+          best = key;
+          found = true;
+        }
+      }
+      taken[best] = true;
+      const (fn, ln) = best;
+      r.file = if ln < 0 then "" else chpl_lookupFilename(fn:int(32)):string;
+      r.line = ln;
+      r.ops = ops[best];
+      r.bytes = bytes[best];
+    }
+    return result;
+  }
+
+  /*
+    Print the source lines that moved the most bytes in remote GETs and
+    PUTs, one per line.  See :proc:`getCommDiagnosticsSourceLines`.
+
+    :arg n: the maximum number of lines to print
+   */
+  proc printCommDiagnosticsSourceLines(n: int = 10) {
+    for l in getCommDiagnosticsSourceLines(n) do
+      writeln(l);
+  }
+
   /*
     If this is set, on-the-fly reporting of communication operations
     will be turned on before any module initialization begins and
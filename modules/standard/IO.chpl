@@ -676,6 +676,8 @@ pragma "no doc"
 extern const QIO_HINT_NOREUSE:c_int;
 pragma "no doc"
 extern const QIO_HINT_OWNED:c_int;
+pragma "no doc"
+extern const QIO_HINT_ASYNC:c_int;
 
 /*  IOHINT_NONE means normal operation, nothing special
     to hint. Expect to use NONE most of the time.
@@ -701,9 +703,20 @@ const IOHINT_CACHED = QIO_HINT_CACHED;
     channels working with this file in parallel.
     It might change the reading/writing implementation
     to something more efficient in that scenario.
+    On Linux, if ``CHPL_RT_IO_URING`` is set to ``true``,
+    buffered channels on the file share an io_uring so that
+    their reads and writes are submitted to the kernel
+    together.  This is experimental and off by default.
  */
 const IOHINT_PARALLEL = QIO_HINT_PARALLEL;
 
+/*  IOHINT_ASYNC means that a buffered channel should overlap
+    its file I/O with the computation using it. Reads are
+    issued ahead of the channel's position and writes are
+    completed behind it by a helper thread.
+ */
+const IOHINT_ASYNC = QIO_HINT_ASYNC;
+
 pragma "no doc"
 extern type qio_file_ptr_t;
 private extern const QIO_FILE_PTR_NULL:qio_file_ptr_t;
@@ -1206,6 +1219,8 @@ The following :type:`iohints` constants are provided:
     cached in memory, possibly all at once.
   * :const:`IOHINT_PARALLEL` suggests to expect many channels
     working with this file in parallel.
+  * :const:`IOHINT_ASYNC` suggests that a buffered channel should read
+    ahead of, or write behind, its position in the background.
 
 
 Other hints might be added in the future.
@@ -70,7 +70,7 @@
     If during execution the amount of allocated memory exceeds this
     limit on any locale, halt the program with a message saying so.
 
-  The following two config variables do not enable memory tracking;
+  The following three config variables do not enable memory tracking;
   they only modify how it is done.
 
 
@@ -78,6 +78,16 @@
     If this is set to a value greater than 0 (zero), only allocation
     requests larger than this are tracked and/or reported.
 
+  ``memSampleBytes``: `uint`:
+    If this is set to a value greater than 0 (zero), allocations are
+    sampled rather than all being tracked.  Allocations of at least
+    this many bytes are always tracked.  Of smaller ones, about one per
+    this many bytes allocated is tracked, and is counted as if it were
+    this many bytes.  The statistics and the leak reports by type are
+    then estimates, and :proc:`printMemAllocs` lists only the sampled
+    allocations.  This greatly reduces the cost of memory tracking in
+    programs that do many small allocations.
+
   ``memLog``: `c_string`:
     Memory reporting is written to this file.  By default it is the
     ``stdout`` associated with the process (not the Chapel channel
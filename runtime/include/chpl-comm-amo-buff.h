@@ -0,0 +1,344 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Common support for buffered (unordered, non-fetching) remote atomic
+// operations, for comm layers that do not have a native way to buffer
+// them.  Each thread keeps a buffer of pending ops per destination
+// node.  When a buffer fills, or when a fence flushes it, the whole
+// buffer is shipped to the destination in one message and applied
+// there as a batch, using processor atomics.
+//
+// The including comm layer must define
+//
+//   static void amo_buff_ship(c_nodeid_t node, amo_buff_op_t* ops, size_t n);
+//
+// which gets the ops to 'node', has amo_buff_apply() called on them
+// there, and does not return until that is done.  It must also call
+// amo_buff_init() once during comm layer initialization, after
+// chpl_numNodes is known.
+//
+
+#ifndef _chpl_comm_amo_buff_h_
+#define _chpl_comm_amo_buff_h_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "chplrt.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-mem.h"
+#include "chpl-mem-desc.h"
+#include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+
+
+typedef enum {
+  amo_buff_op_add,        // sub is an add of the negated operand
+  amo_buff_op_and,
+  amo_buff_op_or,
+  amo_buff_op_xor
+} amo_buff_opcode_t;
+
+typedef enum {
+  amo_buff_type_int32,
+  amo_buff_type_int64,
+  amo_buff_type_uint32,
+  amo_buff_type_uint64,
+  amo_buff_type_real32,
+  amo_buff_type_real64
+} amo_buff_type_t;
+
+typedef struct {
+  void* obj;
+  union {
+    int32_t  i32;
+    int64_t  i64;
+    uint32_t u32;
+    uint64_t u64;
+    _real32  r32;
+    _real64  r64;
+  } operand;
+  uint8_t op;                   // amo_buff_opcode_t
+  uint8_t type;                 // amo_buff_type_t
+} amo_buff_op_t;
+
+
+//
+// Apply a batch of buffered ops on the node that owns their targets.
+//
+static inline
+void amo_buff_apply(amo_buff_op_t* ops, size_t n) {
+  size_t i;
+
+#define AMO_BUFF_APPLY_INT(_t, _m)                                      \
+  do {                                                                  \
+    switch ((amo_buff_opcode_t) p->op) {                                \
+    case amo_buff_op_add:                                               \
+      (void) atomic_fetch_add_##_t((atomic_##_t*) p->obj, p->operand._m); \
+      break;                                                            \
+    case amo_buff_op_and:                                               \
+      (void) atomic_fetch_and_##_t((atomic_##_t*) p->obj, p->operand._m); \
+      break;                                                            \
+    case amo_buff_op_or:                                                \
+      (void) atomic_fetch_or_##_t((atomic_##_t*) p->obj, p->operand._m); \
+      break;                                                            \
+    case amo_buff_op_xor:                                               \
+      (void) atomic_fetch_xor_##_t((atomic_##_t*) p->obj, p->operand._m); \
+      break;                                                            \
+    }                                                                   \
+  } while (0)
+
+  for (i = 0; i < n; i++) {
+    amo_buff_op_t* p = &ops[i];
+    switch ((amo_buff_type_t) p->type) {
+    case amo_buff_type_int32:
+      AMO_BUFF_APPLY_INT(int_least32_t, i32);
+      break;
+    case amo_buff_type_int64:
+      AMO_BUFF_APPLY_INT(int_least64_t, i64);
+      break;
+    case amo_buff_type_uint32:
+      AMO_BUFF_APPLY_INT(uint_least32_t, u32);
+      break;
+    case amo_buff_type_uint64:
+      AMO_BUFF_APPLY_INT(uint_least64_t, u64);
+      break;
+    case amo_buff_type_real32:
+      (void) atomic_fetch_add__real32((atomic__real32*) p->obj,
+                                      p->operand.r32);
+      break;
+    case amo_buff_type_real64:
+      (void) atomic_fetch_add__real64((atomic__real64*) p->obj,
+                                      p->operand.r64);
+      break;
+    }
+  }
+
+#undef AMO_BUFF_APPLY_INT
+}
+
+
+static void amo_buff_ship(c_nodeid_t, amo_buff_op_t*, size_t);
+
+//
+// Per-thread buffers.  A thread's buffers can be flushed by another
+// thread doing a full fence, so each set has a lock.  The lock is never
+// held while shipping: a full buffer is detached first and shipped
+// afterward, and 'shipping' counts detached buffers that are still in
+// flight so that a fence can wait for them.  'nonEmpty' lets a flush
+// skip a thread with nothing buffered without taking its lock.  Thread
+// infos are never freed, so a fence can walk the list without holding
+// its lock.
+//
+typedef struct amo_buff_thread_info_s {
+  pthread_mutex_t lock;
+  size_t* counts;                       // [chpl_numNodes]
+  amo_buff_op_t** bufs;                 // [chpl_numNodes], lazily alloc'd
+  atomic_int_least32_t nonEmpty;
+  atomic_int_least32_t shipping;
+  struct amo_buff_thread_info_s* next;
+} amo_buff_thread_info_t;
+
+static size_t amo_buff_len;
+static amo_buff_thread_info_t* amo_buff_thread_infos;
+static pthread_mutex_t amo_buff_thread_infos_lock = PTHREAD_MUTEX_INITIALIZER;
+static CHPL_TLS_DECL(amo_buff_thread_info_t*, amo_buff_my_info);
+
+
+//
+// 'maxOps' is the most ops the comm layer can ship in one message.
+//
+static inline
+void amo_buff_init(size_t maxOps) {
+  const size_t dfltLen = 1024;
+  amo_buff_len = (maxOps < dfltLen) ? maxOps : dfltLen;
+  if (amo_buff_len == 0)
+    chpl_internal_error("buffered atomics: cannot ship any ops");
+  CHPL_TLS_INIT(amo_buff_my_info);
+}
+
+
+static inline
+amo_buff_thread_info_t* amo_buff_get_my_info(void) {
+  amo_buff_thread_info_t* info = CHPL_TLS_GET(amo_buff_my_info);
+
+  if (info == NULL) {
+    info = chpl_mem_alloc(sizeof(*info), CHPL_RT_MD_COMM_UTIL, 0, 0);
+    pthread_mutex_init(&info->lock, NULL);
+    info->counts = chpl_mem_allocManyZero(chpl_numNodes,
+                                          sizeof(info->counts[0]),
+                                          CHPL_RT_MD_COMM_UTIL, 0, 0);
+    info->bufs = chpl_mem_allocManyZero(chpl_numNodes,
+                                        sizeof(info->bufs[0]),
+                                        CHPL_RT_MD_COMM_UTIL, 0, 0);
+    atomic_init_int_least32_t(&info->nonEmpty, 0);
+    atomic_init_int_least32_t(&info->shipping, 0);
+
+    pthread_mutex_lock(&amo_buff_thread_infos_lock);
+    info->next = amo_buff_thread_infos;
+    amo_buff_thread_infos = info;
+    pthread_mutex_unlock(&amo_buff_thread_infos_lock);
+
+    CHPL_TLS_SET(amo_buff_my_info, info);
+  }
+
+  return info;
+}
+
+
+//
+// Detach a non-empty buffer for shipping.  Called with the info locked.
+//
+static inline
+amo_buff_op_t* amo_buff_detach(amo_buff_thread_info_t* info, c_nodeid_t node,
+                               size_t* pN) {
+  amo_buff_op_t* ops = info->bufs[node];
+  *pN = info->counts[node];
+  info->bufs[node] = NULL;
+  info->counts[node] = 0;
+  (void) atomic_fetch_sub_int_least32_t(&info->nonEmpty, 1);
+  (void) atomic_fetch_add_int_least32_t(&info->shipping, 1);
+  return ops;
+}
+
+
+static inline
+void amo_buff_ship_detached(amo_buff_thread_info_t* info, c_nodeid_t node,
+                            amo_buff_op_t* ops, size_t n) {
+  amo_buff_ship(node, ops, n);
+  chpl_mem_free(ops, 0, 0);
+  (void) atomic_fetch_sub_int_least32_t(&info->shipping, 1);
+}
+
+
+//
+// Buffer one op.  'operand' points to a 'size'-byte value of the type
+// given by 'type'.  For sub, the caller passes an add of the negated
+// operand.
+//
+static inline
+void amo_buff_enqueue(c_nodeid_t node, void* obj,
+                      amo_buff_opcode_t opc, amo_buff_type_t type,
+                      const void* operand, size_t size) {
+  amo_buff_thread_info_t* info;
+  amo_buff_op_t op;
+  amo_buff_op_t* full = NULL;
+  size_t n = 0;
+
+  op.obj = obj;
+  memcpy(&op.operand, operand, size);
+  op.op = opc;
+  op.type = type;
+
+  if (node == chpl_nodeID) {
+    amo_buff_apply(&op, 1);
+    return;
+  }
+
+  info = amo_buff_get_my_info();
+
+  pthread_mutex_lock(&info->lock);
+  if (info->bufs[node] == NULL) {
+    info->bufs[node] = chpl_mem_allocMany(amo_buff_len,
+                                          sizeof(info->bufs[node][0]),
+                                          CHPL_RT_MD_COMM_UTIL, 0, 0);
+  }
+  info->bufs[node][info->counts[node]++] = op;
+  if (info->counts[node] == 1)
+    (void) atomic_fetch_add_int_least32_t(&info->nonEmpty, 1);
+  if (info->counts[node] == amo_buff_len)
+    full = amo_buff_detach(info, node, &n);
+  pthread_mutex_unlock(&info->lock);
+
+  if (full != NULL)
+    amo_buff_ship_detached(info, node, full, n);
+}
+
+
+static inline
+void amo_buff_flush_info(amo_buff_thread_info_t* info) {
+  c_nodeid_t node;
+
+  if (atomic_load_int_least32_t(&info->nonEmpty) == 0)
+    return;
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    amo_buff_op_t* ops = NULL;
+    size_t n = 0;
+
+    pthread_mutex_lock(&info->lock);
+    if (info->counts[node] > 0)
+      ops = amo_buff_detach(info, node, &n);
+    pthread_mutex_unlock(&info->lock);
+
+    if (ops != NULL)
+      amo_buff_ship_detached(info, node, ops, n);
+  }
+}
+
+
+//
+// Flush the buffers of every thread on this node, and wait for any
+// shipments other threads already have in flight.
+//
+static inline
+void amo_buff_flush(void) {
+  amo_buff_thread_info_t* info;
+
+  pthread_mutex_lock(&amo_buff_thread_infos_lock);
+  info = amo_buff_thread_infos;
+  pthread_mutex_unlock(&amo_buff_thread_infos_lock);
+
+  for (amo_buff_thread_info_t* p = info; p != NULL; p = p->next)
+    amo_buff_flush_info(p);
+
+  for (amo_buff_thread_info_t* p = info; p != NULL; p = p->next) {
+    while (atomic_load_int_least32_t(&p->shipping) > 0)
+      chpl_task_yield();
+  }
+}
+
+
+//
+// Flush the buffers the calling task could have filled.  If tasks can
+// move between threads those could be anyone's, so flush them all.
+// Otherwise just flush this thread's, but also wait for any of them
+// that a full fence on another thread detached and is still shipping.
+//
+static inline
+void amo_buff_task_flush(void) {
+  if (chpl_task_canMigrateThreads()) {
+    amo_buff_flush();
+  } else {
+    amo_buff_thread_info_t* info = CHPL_TLS_GET(amo_buff_my_info);
+    if (info != NULL) {
+      amo_buff_flush_info(info);
+      while (atomic_load_int_least32_t(&info->shipping) > 0)
+        chpl_task_yield();
+    }
+  }
+}
+
+
+#endif
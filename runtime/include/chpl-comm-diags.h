@@ -25,6 +25,7 @@
 
 #include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-thread-local-storage.h"
 
 typedef struct _chpl_atomic_commDiagnostics {
 #define _COMM_DIAGS_DECL_ATOMIC(cdv) atomic_uint_least64_t cdv;
@@ -32,32 +33,71 @@ typedef struct _chpl_atomic_commDiagnostics {
 #undef _COMM_DIAGS_DECL_ATOMIC
 } chpl_atomic_commDiagnostics;
 
-chpl_atomic_commDiagnostics chpl_comm_diags_counters;
-atomic_int_least16_t chpl_comm_diags_disable_flag;
+//
+// The counters are split into shards, each on its own cache lines, so
+// that threads counting communication at the same time don't contend
+// on the same counters.  Each thread is assigned a shard the first time
+// it counts something.  Reading the counters sums the shards.
+//
+#define CHPL_COMM_DIAGS_NUM_SHARDS 64
+
+typedef struct {
+  chpl_atomic_commDiagnostics cd;
+} __attribute__((aligned(64))) chpl_comm_diags_shard_t;
+
+extern chpl_comm_diags_shard_t
+       chpl_comm_diags_shards[CHPL_COMM_DIAGS_NUM_SHARDS];
+extern atomic_int_least16_t chpl_comm_diags_disable_flag;
+
+// The calling thread's shard index plus 1, or 0 if it hasn't got one.
+extern CHPL_TLS_DECL(uintptr_t, chpl_comm_diags_shard_plus1);
+
+uintptr_t chpl_comm_diags_assign_shard(void);
 
 static inline
-void chpl_comm_diags_init(void) {
-#define _COMM_DIAGS_INIT(cdv) \
-        atomic_init_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
-  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_INIT);
-#undef _COMM_DIAGS_INIT
-  atomic_init_int_least16_t(&chpl_comm_diags_disable_flag, 0);
+chpl_atomic_commDiagnostics* chpl_comm_diags_my_shard(void) {
+  uintptr_t i = (uintptr_t) CHPL_TLS_GET(chpl_comm_diags_shard_plus1);
+  if (i == 0)
+    i = chpl_comm_diags_assign_shard();
+  return &chpl_comm_diags_shards[i - 1].cd;
 }
 
+//
+// Source line attribution.  If CHPL_RT_COMM_DIAGS_SOURCE_LINES is set,
+// while diagnostics are on we also count the remote operations and
+// bytes for each (line, file) that communication is done for.
+//
+extern int chpl_comm_diags_src_lines;
+
+void chpl_comm_diags_src_line_reset(void);
+void chpl_comm_diags_src_line_count(size_t size, int ln, int32_t fn);
+
+void chpl_comm_diags_init(void);
+
 static inline
 void chpl_comm_diags_reset(void) {
+  int i;
 #define _COMM_DIAGS_RESET(cdv) \
-        atomic_store_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
- CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_RESET);
+        atomic_store_uint_least64_t(&chpl_comm_diags_shards[i].cd.cdv, 0);
+  for (i = 0; i < CHPL_COMM_DIAGS_NUM_SHARDS; i++) {
+    CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_RESET);
+  }
 #undef _COMM_DIAGS_RESET
+  chpl_comm_diags_src_line_reset();
 }
 
 static inline
 void chpl_comm_diags_copy(chpl_commDiagnostics* cd) {
-#define _COMM_DIAGS_COPY(cdv) \
-        cd->cdv = atomic_load_uint_least64_t(&chpl_comm_diags_counters.cdv);
-  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_COPY);
-#undef _COMM_DIAGS_COPY
+  int i;
+#define _COMM_DIAGS_ZERO(cdv) cd->cdv = 0;
+  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_ZERO);
+#undef _COMM_DIAGS_ZERO
+#define _COMM_DIAGS_SUM(cdv) \
+        cd->cdv += atomic_load_uint_least64_t(&chpl_comm_diags_shards[i].cd.cdv);
+  for (i = 0; i < CHPL_COMM_DIAGS_NUM_SHARDS; i++) {
+    CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_SUM);
+  }
+#undef _COMM_DIAGS_SUM
 }
 
 static inline
@@ -101,6 +141,12 @@ void chpl_comm_diags_verbose_printf(const char* format, ...) {
                                  chpl_lookupFilename(fn), ln, op,       \
                                  (int) node)
 
+#define chpl_comm_diags_verbose_rdmaIdx(op, node, cnt, ln, fn)          \
+  chpl_comm_diags_verbose_printf("%s:%d: remote indexed %s, "           \
+                                 "node %d, %zu elements",               \
+                                 chpl_lookupFilename(fn), ln, op,       \
+                                 (int) node, cnt)
+
 #define chpl_comm_diags_verbose_executeOn(kind, node)                   \
   chpl_comm_diags_verbose_printf("remote %-*sexecuteOn, node %d",       \
                                  ((int) strlen(kind)                    \
@@ -110,9 +156,28 @@ void chpl_comm_diags_verbose_printf(const char* format, ...) {
 #define chpl_comm_diags_incr(_ctr)                                      \
   do {                                                                  \
     if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {        \
-      atomic_uint_least64_t* ctrAddr = &chpl_comm_diags_counters._ctr;  \
+      atomic_uint_least64_t* ctrAddr = &chpl_comm_diags_my_shard()->_ctr; \
       (void) atomic_fetch_add_uint_least64_t(ctrAddr, 1);               \
     }                                                                   \
   } while(0)
 
+// The number of bytes moved by a strided GET or PUT.
+static inline
+size_t chpl_comm_diags_strd_size(size_t* count, int32_t stridelevels,
+                                 size_t elemSize) {
+  size_t size = elemSize;
+  int32_t i;
+  for (i = 0; i <= stridelevels; i++)
+    size *= count[i];
+  return size;
+}
+
+#define chpl_comm_diags_incr_src_line(size, ln, fn)                     \
+  do {                                                                  \
+    if (chpl_comm_diags_src_lines && chpl_comm_diagnostics              \
+        && chpl_comm_diags_is_enabled()) {                              \
+      chpl_comm_diags_src_line_count(size, ln, fn);                     \
+    }                                                                   \
+  } while(0)
+
 #endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Common support for indexed (gather/scatter) put/get
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "chplrt.h"
+#include "chpl-comm.h"
+#include "chpl-mem.h"
+#include "chpl-mem-desc.h"
+
+// Don't get warning macros for chpl_comm_get etc
+#include "chpl-comm-no-warning-macros.h"
+
+
+//
+// Bucket the elements of an indexed transfer by node.  On return,
+// (*pOrder)[(*pNodeStart)[nd] .. (*pNodeStart)[nd+1]-1] are the
+// positions in 'nodes' of the elements that live on node 'nd', in
+// their original relative order.  The caller frees both arrays with
+// indexed_xfer_bucket_free().
+//
+static inline
+void indexed_xfer_bucket(c_nodeid_t* nodes, size_t n,
+                         size_t** pNodeStart, size_t** pOrder) {
+  size_t* nodeStart;
+  size_t* order;
+  size_t* cursor;
+  size_t i;
+  c_nodeid_t nd;
+
+  nodeStart = chpl_mem_allocManyZero(chpl_numNodes + 1, sizeof(nodeStart[0]),
+                                     CHPL_RT_MD_COMM_UTIL, 0, 0);
+  order = chpl_mem_allocMany(n, sizeof(order[0]),
+                             CHPL_RT_MD_COMM_UTIL, 0, 0);
+  cursor = chpl_mem_allocMany(chpl_numNodes, sizeof(cursor[0]),
+                              CHPL_RT_MD_COMM_UTIL, 0, 0);
+
+  for (i = 0; i < n; i++)
+    nodeStart[nodes[i] + 1]++;
+  for (nd = 0; nd < chpl_numNodes; nd++) {
+    nodeStart[nd + 1] += nodeStart[nd];
+    cursor[nd] = nodeStart[nd];
+  }
+  for (i = 0; i < n; i++)
+    order[cursor[nodes[i]]++] = i;
+
+  chpl_mem_free(cursor, 0, 0);
+
+  *pNodeStart = nodeStart;
+  *pOrder = order;
+}
+
+
+static inline
+void indexed_xfer_bucket_free(size_t* nodeStart, size_t* order) {
+  chpl_mem_free(nodeStart, 0, 0);
+  chpl_mem_free(order, 0, 0);
+}
+
+
+//
+// Common version of the indexed transfer functions, for comm layer
+// implementations that do not have a native way to batch them.  Like
+// the common strided versions, this keeps up to maxOutstandingXfers
+// nonblocking transactions in flight, and waits for all of them at the
+// end.
+//
+static inline
+void indexed_nb_helper(chpl_comm_nb_handle_t (*xferFn)(void*, c_nodeid_t,
+                                                       void*, size_t,
+                                                       int32_t, int32_t,
+                                                       int, int32_t),
+                       void* localAddr, c_nodeid_t node, void* remoteAddr,
+                       size_t size,
+                       chpl_comm_nb_handle_t* handles, size_t* pCurrHandles,
+                       size_t maxOutstandingXfers,
+                       void (yieldFn)(void),
+                       int32_t commID, int ln, int32_t fn)
+{
+  size_t currHandles = *pCurrHandles;
+
+  if (currHandles >= maxOutstandingXfers) {
+    size_t iOut, iIn;
+
+    while (!chpl_comm_try_nb_some(handles, currHandles)) {
+      (yieldFn)();
+    }
+
+    for (iOut = iIn = 0; iIn < currHandles; iIn++) {
+      if (handles[iIn] != NULL)
+        handles[iOut++] = handles[iIn];
+    }
+    currHandles = iOut;
+  }
+
+  handles[currHandles] = (*xferFn)(localAddr, node, remoteAddr, size,
+                                   -1 /*typeIndex*/, commID, ln, fn);
+  if (handles[currHandles] != NULL)
+    currHandles++;
+
+  *pCurrHandles = currHandles;
+}
+
+
+static inline
+void scatterv_common(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                     size_t n, size_t elemSize,
+                     size_t maxOutstandingXfers, void (yieldFn)(void),
+                     int32_t commID, int ln, int32_t fn) {
+  chpl_comm_nb_handle_t handles[maxOutstandingXfers];
+  size_t currHandles = 0;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    indexed_nb_helper(chpl_comm_put_nb,
+                      (char*) srcaddr + i * elemSize, dstnodes[i], dstaddrs[i],
+                      elemSize,
+                      handles, &currHandles, maxOutstandingXfers, yieldFn,
+                      commID, ln, fn);
+  }
+
+  chpl_comm_wait_nb_some(handles, currHandles);
+}
@@ -432,6 +432,28 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode,
                      int32_t stridelevels, size_t elemSize, int32_t typeIndex, 
                      int32_t commID, int ln, int32_t fn);
 
+//
+// gather 'n' elements of 'elemSize' bytes each, element i coming from
+// remote address 'srcaddrs[i]' on node 'srcnodes[i]', into the
+// contiguous local buffer at 'dstaddr'
+// notes:
+//   the elements may live on any mix of nodes, in any order; the
+//   comm layer buckets them by node and moves each node's share as
+//   one batch where it can
+//   all of the transfers are complete when this returns
+//
+void  chpl_comm_gatherv(void* dstaddr, c_nodeid_t* srcnodes, void** srcaddrs,
+                        size_t n, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn);
+
+//
+// same as chpl_comm_gatherv(), but scatter the contiguous local buffer
+// at 'srcaddr' out to the remote addresses instead
+//
+void  chpl_comm_scatterv(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                         size_t n, size_t elemSize,
+                         int32_t commID, int ln, int32_t fn);
+
 //
 // Get a local copy of a wide string.
 //
@@ -509,7 +531,10 @@ void chpl_comm_task_end(void);
   MACRO(try_nb) \
   MACRO(execute_on) \
   MACRO(execute_on_fast) \
-  MACRO(execute_on_nb)
+  MACRO(execute_on_nb) \
+  MACRO(cache_shared_hit) \
+  MACRO(cache_shared_miss) \
+  MACRO(cache_shared_dedup)
 
 typedef struct _chpl_commDiagnostics {
 #define _COMM_DIAGS_DECL(cdv) uint64_t cdv;
@@ -532,6 +557,9 @@ void chpl_stopCommDiagnosticsHere(void);
 void chpl_gen_stopCommDiagnosticsHere(void);
 void chpl_resetCommDiagnosticsHere(void);
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd);
+int64_t chpl_comm_diags_src_line_capacity(void);
+chpl_bool chpl_comm_diags_src_line_get(int64_t i, int32_t* ln, int32_t* fn,
+                                       uint64_t* ops, uint64_t* bytes);
 
 void* chpl_get_global_serialize_table(int64_t idx);
 
@@ -28,4 +28,46 @@
     chpl_comm_impl_regMemHeapInfo(start_p, size_p)
 void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p);
 
+//
+// Buffered (unordered) non-fetching atomic ops on processor atomic
+// objects.  These have the same interface as the network atomic ones,
+// see chpl-comm-native-atomics.h.
+//
+#define DECL_CHPL_COMM_ATOMIC_BUFF(op, type)                            \
+  void chpl_comm_atomic_ ## op ## _unordered_ ## type                   \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn);
+
+DECL_CHPL_COMM_ATOMIC_BUFF(and, int32)
+DECL_CHPL_COMM_ATOMIC_BUFF(and, int64)
+DECL_CHPL_COMM_ATOMIC_BUFF(and, uint32)
+DECL_CHPL_COMM_ATOMIC_BUFF(and, uint64)
+
+DECL_CHPL_COMM_ATOMIC_BUFF(or, int32)
+DECL_CHPL_COMM_ATOMIC_BUFF(or, int64)
+DECL_CHPL_COMM_ATOMIC_BUFF(or, uint32)
+DECL_CHPL_COMM_ATOMIC_BUFF(or, uint64)
+
+DECL_CHPL_COMM_ATOMIC_BUFF(xor, int32)
+DECL_CHPL_COMM_ATOMIC_BUFF(xor, int64)
+DECL_CHPL_COMM_ATOMIC_BUFF(xor, uint32)
+DECL_CHPL_COMM_ATOMIC_BUFF(xor, uint64)
+
+DECL_CHPL_COMM_ATOMIC_BUFF(add, int32)
+DECL_CHPL_COMM_ATOMIC_BUFF(add, int64)
+DECL_CHPL_COMM_ATOMIC_BUFF(add, uint32)
+DECL_CHPL_COMM_ATOMIC_BUFF(add, uint64)
+DECL_CHPL_COMM_ATOMIC_BUFF(add, real32)
+DECL_CHPL_COMM_ATOMIC_BUFF(add, real64)
+
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, int32)
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, int64)
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, uint32)
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, uint64)
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, real32)
+DECL_CHPL_COMM_ATOMIC_BUFF(sub, real64)
+
+void chpl_comm_atomic_unordered_fence(void);
+void chpl_comm_atomic_unordered_task_fence(void);
+
 #endif // _chpl_comm_impl_h_
@@ -65,6 +65,16 @@ struct chpl_comm_bundleData_execOn_t {
   chpl_comm_amDone_t* pDone;    // initiator's 'done' flag; nonblocking if NULL
 };
 
+//
+// A batch of coalesced non-blocking executeOns for one node.  The
+// individual executeOn bundles follow this one in the same message.
+//
+struct chpl_comm_bundleData_execOnBatch_t {
+  struct chpl_comm_bundleData_base_t b;
+  uint32_t count;               // number of executeOn bundles following
+  uint32_t size;                // #bytes in whole message
+};
+
 struct chpl_comm_bundleData_RMA_t {
   struct chpl_comm_bundleData_base_t b;
   void* addr;                   // address on AM target node
@@ -98,6 +108,7 @@ struct chpl_comm_bundleData_AMO_t {
 typedef union {
   struct chpl_comm_bundleData_base_t b;
   struct chpl_comm_bundleData_execOn_t xo;
+  struct chpl_comm_bundleData_execOnBatch_t xob;
   struct chpl_comm_bundleData_RMA_t rma;
   struct chpl_comm_bundleData_AMO_t amo;
 } chpl_comm_bundleData_t;
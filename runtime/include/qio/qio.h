@@ -287,6 +287,7 @@ static inline void qio_lock_destroy(qio_lock_t* x) { int rc = pthread_mutex_dest
 extern ssize_t qio_too_small_for_default_mmap;
 extern ssize_t qio_too_large_for_default_mmap;
 extern ssize_t qio_mmap_chunk_iobufs;
+extern ssize_t qio_async_iobufs;
 
 #ifdef __cplusplus
 extern "C" {
@@ -348,13 +349,14 @@ typedef enum {
   QIO_METHOD_FREADFWRITE = 3*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MMAP = 4*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MEMORY = 5*QIO_HINT_AFTERCHTYPE,
+  QIO_METHOD_URING = 6*QIO_HINT_AFTERCHTYPE,
   //QIO_METHOD_LIBEVENT,
 } qio_method_t;
 #define QIO_METHODMASK 0x00f0
 #define QIO_HINT_AFTERMETHOD 0x0100
 #define QIO_METHOD_DEFAULT 0
 #define QIO_MIN_METHOD QIO_METHOD_READWRITE
-#define QIO_MAX_METHOD QIO_METHOD_MEMORY
+#define QIO_MAX_METHOD QIO_METHOD_URING
 
 enum {
   QIO_HINT_RANDOM       = QIO_HINT_AFTERMETHOD,
@@ -389,6 +391,12 @@ enum {
   // is opened within the qio implementation.  Otherwise, the user (or system)
   // has to close it.
   QIO_HINT_OWNED        = QIO_HINT_NOFAST<<1,
+
+  // Overlap file I/O with computation on a buffered pread/pwrite
+  // channel: a helper thread keeps qio_async_iobufs iobufs of reads
+  // in flight ahead of a reading channel, and writes a writing
+  // channel's full buffers behind it. Ignored for other methods.
+  QIO_HINT_ASYNC        = QIO_HINT_OWNED<<1,
 };
 
 
@@ -449,6 +457,9 @@ char* qio_hints_to_string(qio_hint_t hint)
       case QIO_METHOD_MEMORY:
         strcat(buf, " memory"); ok = 1;
         break;
+      case QIO_METHOD_URING:
+        strcat(buf, " uring"); ok = 1;
+        break;
       // no default to get warned if any are added.
     }
   }
@@ -465,6 +476,7 @@ char* qio_hints_to_string(qio_hint_t hint)
   if( hint & QIO_HINT_NOREUSE ) strcat(buf, " noreuse");
   if( hint & QIO_HINT_NOFAST ) strcat(buf, " nofast");
   if( hint & QIO_HINT_OWNED ) strcat(buf, " owned");
+  if( hint & QIO_HINT_ASYNC ) strcat(buf, " async");
 
   return qio_strdup(buf);
 }
@@ -537,6 +549,12 @@ typedef struct qio_file_s {
   qio_lock_t lock;
   int64_t max_initial_position;
 
+  // io_uring shared by QIO_METHOD_URING channels on this file.
+  // Created on first use (protected by the file lock); stays NULL
+  // if io_uring is not available, in which case we use preadv.
+  struct qio_uring_s* uring;
+  bool uring_tried;
+
   qio_style_t style;
 } qio_file_t;
 
@@ -546,6 +564,8 @@ qioerr qio_readv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer
 qioerr qio_writev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, ssize_t* num_written);
 qioerr qio_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read);
 qioerr qio_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written);
+qioerr qio_uring_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read);
+qioerr qio_uring_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written);
 
 // if fp is not null, fd is ignored; if fp is null, we use fd.
 // the QIO file takes ownership of fp or fd, closing it when the QIO file is closed.
@@ -812,6 +832,10 @@ typedef struct qio_channel_s {
 
   qbuffer_t buf;
 
+  // Read-ahead/write-behind helper for QIO_HINT_ASYNC channels,
+  // or NULL if the channel does its I/O synchronously.
+  struct qio_async_s* async;
+
   // For reading/writing bits (ie less than a byte) at a time
   qio_bitbuffer_t bit_buffer;
   void* cached_end_bits; // cause flush before byte I/O
@@ -1053,6 +1077,12 @@ qio_file_t* qio_channel_get_file(qio_channel_t* ch)
   return ch->file;
 }
 
+static inline
+qio_hint_t qio_channel_get_hints(qio_channel_t* ch)
+{
+  return ch->hints;
+}
+
 // You should lock/ get ptr/ unlock
 static inline
 qio_style_t* qio_channel_style_ptr(qio_channel_t* ch)
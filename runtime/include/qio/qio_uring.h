@@ -0,0 +1,57 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_URING_H_
+#define _QIO_URING_H_
+
+#include "sys_basic.h"
+#include "sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A Linux io_uring submission/completion ring used by
+ * QIO_METHOD_URING. One ring is shared by all of the channels on
+ * a file, so that parallel readers submit their requests together
+ * instead of each making its own preadv system call.
+ *
+ * Where io_uring is not available (older kernels, other operating
+ * systems, or a seccomp policy that forbids it), qio_uring_create
+ * fails and the sys_uring_ functions with a NULL ring simply call
+ * sys_preadv/sys_pwritev.
+ */
+typedef struct qio_uring_s qio_uring_t;
+
+// Returns true if io_uring can be used on this system. Only
+// checks the first time it is called.
+int qio_uring_supported(void);
+
+err_t qio_uring_create(qio_uring_t** ring_out);
+void qio_uring_destroy(qio_uring_t* ring);
+
+// Same as sys_preadv/sys_pwritev, but submitted through ring.
+err_t sys_uring_preadv(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out);
+err_t sys_uring_pwritev(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
@@ -197,6 +197,16 @@ buffer.
 When processing GETs on adjacent memory locations, the cache triggers
 both synchronous and asynchronous read-ahead.
 
+Strided GETs (such as a column-major sweep of a row-major array) don't
+trigger read-ahead, so each cache also keeps a small table of GET
+'streams'. A GET that is exactly one stride past the last GET of a stream
+continues that stream. Once a stride has repeated a couple of times, we
+start prefetches for the next few strides, so later GETs in the stream
+find their data already on the way. Strides can be negative or span many
+pages, and several streams can be followed at once.
+CHPL_RT_CACHE_PREFETCH_DISTANCE sets how many strides ahead to prefetch
+(0 turns stride prefetching off).
+
 When processing a PUT, we similarly check for the requested cache page in the
 pointer tree and use an unused page if not. We find a unused 'dirty entry' to
 track the dirty bits of the cache page if the cache entry does not already have
@@ -254,6 +264,42 @@ would be to only move tasks between threads in situations that create full
 barriers anyway; notably a full barrier occurs on task start and sync variable
 use.
 
+== Shared Read Cache ==
+
+Because there is one cache per pthread, when many tasks on a locale read
+the same remote data each pthread does its own GETs for it. Setting
+CHPL_RT_CACHE_REMOTE_SHARED=true adds a locale-wide layer under the
+per-pthread caches that holds read-only copies of whole cache pages.
+When a (non-prefetch) GET misses in the per-pthread cache, we look the
+page up in the shared layer before going to the network. The first
+pthread to miss on a page claims a slot and GETs the whole page into it;
+other pthreads that want the same page while that GET is outstanding
+wait for it instead of starting their own. CHPL_RT_CACHE_REMOTE_SHARED_PAGES
+sets the number of shared pages (default 4096, rounded up to a power of 2).
+
+The shared layer is a direct-mapped table. Each slot has a spin lock that
+is only held while examining the slot or copying data out of it, never
+during a GET.
+
+Acquire and release fences still apply. There is a locale-wide 'shared
+clock'. Each shared page records the clock value it was stamped with
+before its GET started. Each per-pthread cache records the minimum stamp
+it will accept:
+
+  - an acquire fence raises the minimum to the current clock, so only
+    pages fetched after the fence are used;
+  - a PUT through the cache stops the pthread from using the shared
+    layer at all, since shared pages might not reflect its own writes;
+  - the next release fence, after all of those PUTs have completed,
+    advances the clock and sets the minimum past it.
+
+Pages copied from the shared layer into a per-pthread cache are then
+treated like any other GET result there. The number of GETs satisfied
+from the shared layer, the number that missed it and the number that
+waited on another pthread's outstanding GET are reported by
+CommDiagnostics as cache_shared_hit, cache_shared_miss and
+cache_shared_dedup.
+
  */
 
 // ASSUMES THAT TASKS DO NOT MIGRATE BETWEEN PTHREADS
@@ -279,6 +325,7 @@ use.
 #include "chpl-atomics.h"
 #include "chpl-thread-local-storage.h" // CHPL_TLS_DECL etc
 #include "chpl-cache.h"
+#include "chpl-env.h"
 #include "chpl-linefile-support.h"
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-compiler-macros.h"
@@ -342,6 +389,21 @@ typedef int16_t readahead_distance_t;
 #define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
 #define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
 
+// Should we detect strided GETs and prefetch ahead of them?
+// The number of strides to prefetch ahead comes from
+// CHPL_RT_CACHE_PREFETCH_DISTANCE (0 disables stride prefetching).
+#define ENABLE_STRIDE_PREFETCH 1
+#define STRIDE_STREAMS 8
+#define DEFAULT_STRIDE_PREFETCH_DISTANCE 4
+#define MAX_STRIDE_PREFETCH_DISTANCE 32
+// How many times must a stride repeat before we prefetch for it?
+#define STRIDE_CONFIRMATIONS 2
+// Larger distances between GETs are not considered strides.
+#define MAX_STRIDE_BYTES (1024*CACHEPAGE_SIZE)
+
+// Default number of pages in the shared read cache, when it is enabled.
+#define DEFAULT_SHARED_CACHE_PAGES 4096
+
 //#define TIME
 //#define TRACE
 //#define DEBUG
@@ -562,6 +624,16 @@ static int count_valid_lines_at_after(uint64_t* valid, uintptr_t at)
 }
 */
 
+// A stream of GETs with a constant stride, used for stride prefetching.
+struct stride_stream_s {
+  c_nodeid_t node; // -1 if this stream is unused
+  raddr_t last_raddr; // address of the last GET in this stream
+  intptr_t stride; // 0 if we haven't seen a stride yet
+  int confirmations; // how many times in a row has stride repeated?
+  raddr_t prefetched_raddr; // furthest address prefetched, or 0
+  uint64_t last_use; // for replacing the least recently used stream
+};
+
 struct top_entry_s {
   struct cache_entry_base_s base; // contains what we hashed to...
   size_t num_entries;
@@ -585,6 +657,10 @@ struct rdcache_s {
   c_nodeid_t last_cache_miss_read_node;
   raddr_t last_cache_miss_read_addr;
 
+  // Streams of strided GETs that we might prefetch for.
+  uint64_t stride_stream_uses;
+  struct stride_stream_s stride_streams[STRIDE_STREAMS];
+
   // The variable names Ain Aout and Am come from the 2Q paper
 
   // Ain is a FIFO queue storing entries initially as they go into
@@ -662,6 +738,11 @@ struct rdcache_s {
   chpl_comm_nb_handle_t *pending;
   cache_seqn_t *pending_sequence_numbers;
 
+  // Pages in the shared read cache are only usable by this cache if
+  // they were stamped at or after this shared clock value.
+  // SHARED_STAMP_BYPASS means don't use the shared read cache.
+  uint64_t shared_min_stamp;
+
   // space for mid-level entries
   int max_top_entries;
   struct cache_entry_base_s* free_top_nodes_head; // a linked list.
@@ -673,6 +754,198 @@ struct rdcache_s {
 static void validate_cache(struct rdcache_s* tree);
 
 
+//////////////// SHARED READ CACHE ////////////////////
+
+// See "Shared Read Cache" above.
+
+#define SHARED_EMPTY 0
+#define SHARED_FETCHING 1
+#define SHARED_VALID 2
+
+#define SHARED_STAMP_BYPASS UINT64_MAX
+
+struct shared_page_s {
+  atomic_bool lock;
+  int state; // SHARED_EMPTY, SHARED_FETCHING or SHARED_VALID
+  c_nodeid_t node;
+  raddr_t raddr; // aligned to CACHEPAGE_SIZE
+  // The shared clock value taken before the GET for this page started.
+  uint64_t stamp;
+  // The pthread cache doing the GET, while state == SHARED_FETCHING.
+  struct rdcache_s* fetcher;
+  // This refers to CACHEPAGE_SIZE bytes of memory.
+  unsigned char* page;
+};
+
+static chpl_bool shared_cache_enabled = false;
+static uintptr_t shared_cache_mask;
+static struct shared_page_s* shared_pages;
+static atomic_uint_least64_t shared_clock;
+
+static
+void shared_cache_init(void)
+{
+  size_t npages;
+  size_t want;
+  size_t i;
+  unsigned char* buffer;
+  unsigned char* pages;
+  uintptr_t offset;
+
+  shared_cache_enabled = chpl_env_rt_get_bool("CACHE_REMOTE_SHARED", false);
+  if( ! shared_cache_enabled ) return;
+
+  want = chpl_env_rt_get_int("CACHE_REMOTE_SHARED_PAGES",
+                             DEFAULT_SHARED_CACHE_PAGES);
+  for( npages = 1; npages < want; npages *= 2 ) ;
+
+  // Allocate the slots and the pages in one go, with an extra
+  // page for alignment.
+  buffer = chpl_malloc(sizeof(struct shared_page_s) * npages +
+                       CACHEPAGE_SIZE + CACHEPAGE_SIZE * npages);
+  shared_pages = (struct shared_page_s*) buffer;
+  pages = buffer + sizeof(struct shared_page_s) * npages;
+  offset = ((uintptr_t) pages) % CACHEPAGE_SIZE;
+  if( offset != 0 ) pages += CACHEPAGE_SIZE - offset;
+
+  for( i = 0; i < npages; i++ ) {
+    atomic_init_bool(&shared_pages[i].lock, false);
+    shared_pages[i].state = SHARED_EMPTY;
+    shared_pages[i].node = -1;
+    shared_pages[i].raddr = 0;
+    shared_pages[i].stamp = 0;
+    shared_pages[i].fetcher = NULL;
+    shared_pages[i].page = pages + i * CACHEPAGE_SIZE;
+  }
+
+  shared_cache_mask = npages - 1;
+  atomic_init_uint_least64_t(&shared_clock, 1);
+}
+
+static inline
+struct shared_page_s* shared_page_for(c_nodeid_t node, raddr_t ra_page)
+{
+  uint64_t h = (ra_page >> CACHEPAGE_BITS) ^
+               (((uint64_t) node * 0x9E3779B97F4A7C15ULL) >> 17);
+  return &shared_pages[h & shared_cache_mask];
+}
+
+static inline
+void shared_page_lock(struct shared_page_s* p)
+{
+  while( atomic_exchange_bool(&p->lock, true) ) {
+    while( atomic_load_explicit_bool(&p->lock, memory_order_relaxed) )
+      chpl_task_yield();
+  }
+}
+
+static inline
+void shared_page_unlock(struct shared_page_s* p)
+{
+  atomic_store_explicit_bool(&p->lock, false, memory_order_release);
+}
+
+// Called on an acquire fence: pages fetched before now are too old.
+static inline
+void shared_cache_acquire(struct rdcache_s* cache)
+{
+  uint64_t now;
+
+  if( cache->shared_min_stamp == SHARED_STAMP_BYPASS ) return;
+  now = atomic_load_uint_least64_t(&shared_clock);
+  if( now > cache->shared_min_stamp ) cache->shared_min_stamp = now;
+}
+
+// Called once all of this pthread's PUTs are complete: only pages
+// fetched from now on can reflect them.
+static inline
+void shared_cache_writes_done(struct rdcache_s* cache)
+{
+  cache->shared_min_stamp =
+    atomic_fetch_add_uint_least64_t(&shared_clock, 1) + 1;
+}
+
+// Try to fill in the lines from ra_line to ra_line_end of the remote
+// page (node, ra_page) from the shared read cache, copying them to the
+// same offsets within page.  Returns 1 if it did so, or 0 if the
+// caller needs to do its own GET.  Prefetches never wait and never
+// start a shared GET.
+static
+int shared_cache_get(struct rdcache_s* cache, unsigned char* page,
+                     c_nodeid_t node, raddr_t ra_page,
+                     raddr_t ra_line, raddr_t ra_line_end,
+                     int isprefetch,
+                     int32_t commID, int ln, int32_t fn)
+{
+  struct shared_page_s* p;
+  uint64_t min_stamp = cache->shared_min_stamp;
+  uintptr_t skip = ra_line - ra_page;
+  uintptr_t len = ra_line_end - ra_line;
+  chpl_comm_nb_handle_t handle;
+  int waited = 0;
+
+  if( ! shared_cache_enabled || min_stamp == SHARED_STAMP_BYPASS ) return 0;
+
+  p = shared_page_for(node, ra_page);
+
+  shared_page_lock(p);
+
+  // Someone else is already getting this page; wait for them.
+  while( p->state == SHARED_FETCHING &&
+         p->node == node && p->raddr == ra_page &&
+         p->stamp >= min_stamp ) {
+    // A GET can run another task on this pthread, which must not wait
+    // on the GET it interrupted.
+    if( isprefetch || p->fetcher == cache ) {
+      shared_page_unlock(p);
+      return 0;
+    }
+    shared_page_unlock(p);
+    chpl_task_yield();
+    waited = 1;
+    shared_page_lock(p);
+  }
+
+  if( p->state == SHARED_VALID &&
+      p->node == node && p->raddr == ra_page &&
+      p->stamp >= min_stamp ) {
+    chpl_memcpy(page + skip, p->page + skip, len);
+    shared_page_unlock(p);
+    if( waited ) chpl_comm_diags_incr(cache_shared_dedup);
+    else chpl_comm_diags_incr(cache_shared_hit);
+    return 1;
+  }
+
+  if( isprefetch || p->state == SHARED_FETCHING ) {
+    // Leave the slot alone; the caller will GET what it needs.
+    shared_page_unlock(p);
+    if( ! isprefetch ) chpl_comm_diags_incr(cache_shared_miss);
+    return 0;
+  }
+
+  // Claim the slot for this page.  The stamp must be taken before the
+  // GET starts.
+  p->state = SHARED_FETCHING;
+  p->node = node;
+  p->raddr = ra_page;
+  p->fetcher = cache;
+  p->stamp = atomic_fetch_add_uint_least64_t(&shared_clock, 1);
+  shared_page_unlock(p);
+
+  handle = chpl_comm_get_nb(p->page, node, (void*) ra_page,
+                            CACHEPAGE_SIZE, -1 /*typei*/, commID, ln, fn);
+  chpl_comm_wait_nb_some(&handle, 1);
+
+  shared_page_lock(p);
+  p->state = SHARED_VALID;
+  p->fetcher = NULL;
+  chpl_memcpy(page + skip, p->page + skip, len);
+  shared_page_unlock(p);
+
+  chpl_comm_diags_incr(cache_shared_miss);
+  return 1;
+}
+
 static
 struct rdcache_s* cache_create(void) {
   struct rdcache_s* c;
@@ -767,6 +1040,17 @@ struct rdcache_s* cache_create(void) {
   c->last_cache_miss_read_node = -1;
   c->last_cache_miss_read_addr = 0;
 
+  c->stride_stream_uses = 0;
+  for( i = 0; i < STRIDE_STREAMS; i++ ) {
+    c->stride_streams[i].node = -1;
+    c->stride_streams[i].last_use = 0;
+  }
+
+  if( shared_cache_enabled )
+    c->shared_min_stamp = atomic_load_uint_least64_t(&shared_clock);
+  else
+    c->shared_min_stamp = SHARED_STAMP_BYPASS;
+
   c->max_pages = cache_pages;
   c->max_entries = n_entries;
   c->max_top_nodes = top_entries;
@@ -2249,6 +2533,7 @@ void cache_get(struct rdcache_s* cache,
   cache_seqn_t sn = NO_SEQUENCE_NUMBER;
   int isprefetch = (addr == NULL);
   int entry_after_acquire;
+  int from_shared;
   chpl_comm_nb_handle_t handle;
   uintptr_t readahead_len, readahead_skip;
   int ra;
@@ -2472,12 +2757,19 @@ void cache_get(struct rdcache_s* cache,
 #ifdef TIME
     clock_gettime(CLOCK_REALTIME, &start_get1);
 #endif
-    // Note: chpl_comm_get_nb could cause a different task body to run.
-    handle = 
-      chpl_comm_get_nb(page+(ra_line-ra_page), /*local addr*/
-                       node, (void*) ra_line,
-                       ra_line_end - ra_line /*size*/, -1/*typei*/,
-                       commID, ln, fn);
+    // The shared read cache might already have the data, or be getting it.
+    from_shared = shared_cache_get(cache, page, node, ra_page,
+                                   ra_line, ra_line_end, isprefetch,
+                                   commID, ln, fn);
+    handle = NULL;
+    if( ! from_shared ) {
+      // Note: chpl_comm_get_nb could cause a different task body to run.
+      handle =
+        chpl_comm_get_nb(page+(ra_line-ra_page), /*local addr*/
+                         node, (void*) ra_line,
+                         ra_line_end - ra_line /*size*/, -1/*typei*/,
+                         commID, ln, fn);
+    }
 #ifdef TIME
     clock_gettime(CLOCK_REALTIME, &start_get2);
 #endif
@@ -2495,7 +2787,7 @@ void cache_get(struct rdcache_s* cache,
                     (ra_line - ra_page) >> CACHELINE_BITS,
                     (ra_line_end - ra_line) >> CACHELINE_BITS);
 
-    if( ! isprefetch ) {
+    if( ! isprefetch || from_shared ) {
       // This will increment next request number so cache events are recorded.
       sn = cache->next_request_number;
       cache->next_request_number++;
@@ -2558,7 +2850,8 @@ void cache_get(struct rdcache_s* cache,
       clock_gettime(CLOCK_REALTIME, &wait1);
 #endif
 
-      chpl_comm_wait_nb_some(&handle, 1);
+      if( ! from_shared )
+        chpl_comm_wait_nb_some(&handle, 1);
 
 #ifdef TIME
       clock_gettime(CLOCK_REALTIME, &wait2);
@@ -2587,6 +2880,127 @@ void cache_get(struct rdcache_s* cache,
 }
 
 
+static int stride_prefetch_distance = DEFAULT_STRIDE_PREFETCH_DISTANCE;
+
+// Start prefetches for the stream up to stride_prefetch_distance
+// strides past raddr, continuing from wherever we stopped last time.
+static
+void stride_stream_prefetch(struct rdcache_s* cache,
+                            struct stride_stream_s* s,
+                            raddr_t raddr, size_t size,
+                            cache_seqn_t last_acquire,
+                            int ln, int32_t fn)
+{
+  raddr_t next;
+  raddr_t limit;
+  raddr_t page_mask = sys_page_size() - 1;
+  int forward = (s->stride > 0);
+
+  limit = raddr + s->stride * stride_prefetch_distance;
+  // Don't prefetch past the ends of the address space.
+  if( forward ? (limit < raddr) : (limit > raddr) ) return;
+
+  // Pick up after the last prefetch if it is still ahead of us.
+  next = raddr + s->stride;
+  if( s->prefetched_raddr != 0 &&
+      (forward ? (s->prefetched_raddr > raddr && s->prefetched_raddr < limit)
+               : (s->prefetched_raddr < raddr && s->prefetched_raddr > limit)) )
+    next = s->prefetched_raddr + s->stride;
+
+  for( ; forward ? (next <= limit) : (next >= limit); next += s->stride ) {
+    if( is_congested(cache) ) break;
+
+    // Only prefetch memory we know we can read: either the comm layer
+    // says it is gettable, or it's on the same system page as this GET.
+    if( ! chpl_comm_addr_gettable(s->node, (void*) next, size) &&
+        round_down_to_mask(next, page_mask) !=
+          round_down_to_mask(raddr, page_mask) )
+      break;
+
+    INFO_PRINT(("%i stride prefetch %i:%p stride %i\n",
+                (int) chpl_nodeID, (int) s->node, (void*) next,
+                (int) s->stride));
+
+    cache_get(cache, NULL /* prefetch */, s->node, next, size,
+              last_acquire, 0, CHPL_COMM_UNKNOWN_ID, ln, fn);
+    s->prefetched_raddr = next;
+  }
+}
+
+// Record a GET in the stream table and prefetch ahead of it if it
+// continues a stream with a constant stride.
+//
+// Each GET either continues a stream (it is exactly one stride past
+// that stream's last GET), trains the nearest stream that does not yet
+// have a confirmed stride, or replaces the least recently used stream.
+// Strides can be negative and can span many pages, but strides smaller
+// than a cache line are left to sequential readahead.
+static
+void cache_stride_prefetch(struct rdcache_s* cache,
+                           c_nodeid_t node, raddr_t raddr, size_t size,
+                           cache_seqn_t last_acquire,
+                           int ln, int32_t fn)
+{
+  struct stride_stream_s* s;
+  struct stride_stream_s* nearest = NULL;
+  struct stride_stream_s* lru = NULL;
+  uintptr_t nearest_dist = MAX_STRIDE_BYTES + 1;
+  uintptr_t dist;
+  intptr_t delta;
+  int i;
+
+  if( ! ENABLE_STRIDE_PREFETCH || stride_prefetch_distance == 0 ) return;
+
+  cache->stride_stream_uses++;
+
+  for( i = 0; i < STRIDE_STREAMS; i++ ) {
+    s = &cache->stride_streams[i];
+
+    if( lru == NULL || s->last_use < lru->last_use ) lru = s;
+
+    if( s->node != node ) continue;
+
+    delta = (intptr_t) (raddr - s->last_raddr);
+
+    if( delta == 0 ) {
+      // Another GET of the same thing.
+      s->last_use = cache->stride_stream_uses;
+      return;
+    }
+
+    if( delta == s->stride ) {
+      s->last_raddr = raddr;
+      s->last_use = cache->stride_stream_uses;
+      if( s->confirmations < STRIDE_CONFIRMATIONS ) s->confirmations++;
+      if( s->confirmations >= STRIDE_CONFIRMATIONS &&
+          (uintptr_t) (delta < 0 ? -delta : delta) >= CACHELINE_SIZE )
+        stride_stream_prefetch(cache, s, raddr, size, last_acquire, ln, fn);
+      return;
+    }
+
+    dist = (uintptr_t) (delta < 0 ? -delta : delta);
+    if( s->confirmations == 0 && dist < nearest_dist ) {
+      nearest = s;
+      nearest_dist = dist;
+    }
+  }
+
+  if( nearest ) {
+    // Guess that this is the stride for that stream.
+    s = nearest;
+    s->stride = (intptr_t) (raddr - s->last_raddr);
+  } else {
+    // Start a new stream.
+    s = lru;
+    s->node = node;
+    s->stride = 0;
+  }
+  s->last_raddr = raddr;
+  s->confirmations = 0;
+  s->prefetched_raddr = 0;
+  s->last_use = cache->stride_stream_uses;
+}
+
 #if 0
 static
 void cache_invalidate(struct rdcache_s* cache,
@@ -2746,6 +3160,15 @@ void chpl_cache_init(void) {
 
   //printf("CACHE IS ENABLED\n");
   chpl_cache_do_init();
+  shared_cache_init();
+
+  stride_prefetch_distance =
+    chpl_env_rt_get_int("CACHE_PREFETCH_DISTANCE",
+                        DEFAULT_STRIDE_PREFETCH_DISTANCE);
+  if( stride_prefetch_distance < 0 )
+    stride_prefetch_distance = 0;
+  if( stride_prefetch_distance > MAX_STRIDE_PREFETCH_DISTANCE )
+    stride_prefetch_distance = MAX_STRIDE_PREFETCH_DISTANCE;
 }
 
 void chpl_cache_exit(void)
@@ -2774,11 +3197,15 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
     if( acquire ) {
       task_local->last_acquire = cache->next_request_number;
       cache->next_request_number++;
+      shared_cache_acquire(cache);
     }
 
     if( release ) {
       cache_clean_dirty(cache);
       wait_all(cache);
+      if( shared_cache_enabled &&
+          cache->shared_min_stamp == SHARED_STAMP_BYPASS )
+        shared_cache_writes_done(cache);
     }
 #ifdef DUMP
     DEBUG_PRINT(("%d: task %d after fence\n", chpl_nodeID, (int) chpl_task_getId()));
@@ -2807,6 +3234,8 @@ void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
   //saturating_increment(&info->put_since_release);
   //task_local->last_op = seqn_max(cache, addr, node, raddr, size);
+  // Shared pages won't reflect this write until it is released.
+  cache->shared_min_stamp = SHARED_STAMP_BYPASS;
   cache_put(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             commID, ln, fn);
   return;
@@ -2833,6 +3262,9 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
   cache_get(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             0, commID, ln, fn);
 
+  cache_stride_prefetch(cache, node, (raddr_t)raddr, size,
+                        task_local->last_acquire, ln, fn);
+
   return;
 }
 
@@ -2894,6 +3326,10 @@ void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
   chpl_comm_put_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
                      elemSize, typeIndex, commID, ln, fn);
 #endif
+  // The strided put is complete, but pages already in the shared
+  // read cache might not reflect it.
+  if( shared_cache_enabled )
+    shared_cache_writes_done(tls_cache_remote_data());
 }
 
 // This is for debugging.
@@ -26,12 +26,144 @@
 
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
+#include "chpl-env.h"
 
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 
+chpl_comm_diags_shard_t chpl_comm_diags_shards[CHPL_COMM_DIAGS_NUM_SHARDS];
+atomic_int_least16_t chpl_comm_diags_disable_flag;
+
+CHPL_TLS_DECL(uintptr_t, chpl_comm_diags_shard_plus1);
+
+static atomic_uint_least64_t next_shard;
+
+uintptr_t chpl_comm_diags_assign_shard(void) {
+  uintptr_t i = (uintptr_t) atomic_fetch_add_uint_least64_t(&next_shard, 1);
+  i = i % CHPL_COMM_DIAGS_NUM_SHARDS + 1;
+  CHPL_TLS_SET(chpl_comm_diags_shard_plus1, i);
+  return i;
+}
+
+
+//
+// Per-source-line counts.  This is an open-addressed hash table keyed
+// by (fn, ln), with one extra entry at the end that counts everything
+// we couldn't find room for.  Entries are never removed, so lookups
+// and insertions only need a compare-and-swap on the key.
+//
+#define SRC_LINE_TABLE_SIZE 4096
+#define SRC_LINE_MAX_PROBES 32
+#define SRC_LINE_EMPTY UINT64_MAX
+
+typedef struct {
+  atomic_uint_least64_t key;
+  atomic_uint_least64_t ops;
+  atomic_uint_least64_t bytes;
+} src_line_entry_t;
+
+int chpl_comm_diags_src_lines = 0;
+static src_line_entry_t src_line_table[SRC_LINE_TABLE_SIZE + 1];
+
+static inline
+uint64_t src_line_key(int ln, int32_t fn) {
+  return ((uint64_t) (uint32_t) fn << 32) | (uint32_t) ln;
+}
+
+void chpl_comm_diags_init(void) {
+  int i;
+
+#define _COMM_DIAGS_INIT(cdv) \
+        atomic_init_uint_least64_t(&chpl_comm_diags_shards[i].cd.cdv, 0);
+  for (i = 0; i < CHPL_COMM_DIAGS_NUM_SHARDS; i++) {
+    CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_INIT);
+  }
+#undef _COMM_DIAGS_INIT
+  atomic_init_int_least16_t(&chpl_comm_diags_disable_flag, 0);
+  atomic_init_uint_least64_t(&next_shard, 0);
+  CHPL_TLS_INIT(chpl_comm_diags_shard_plus1);
+
+  chpl_comm_diags_src_lines =
+    chpl_env_rt_get_bool("COMM_DIAGS_SOURCE_LINES", false);
+  if (chpl_comm_diags_src_lines) {
+    for (i = 0; i <= SRC_LINE_TABLE_SIZE; i++) {
+      atomic_init_uint_least64_t(&src_line_table[i].key, SRC_LINE_EMPTY);
+      atomic_init_uint_least64_t(&src_line_table[i].ops, 0);
+      atomic_init_uint_least64_t(&src_line_table[i].bytes, 0);
+    }
+  }
+}
+
+void chpl_comm_diags_src_line_reset(void) {
+  int i;
+
+  if (!chpl_comm_diags_src_lines)
+    return;
+
+  for (i = 0; i <= SRC_LINE_TABLE_SIZE; i++) {
+    atomic_store_uint_least64_t(&src_line_table[i].ops, 0);
+    atomic_store_uint_least64_t(&src_line_table[i].bytes, 0);
+  }
+}
+
+void chpl_comm_diags_src_line_count(size_t size, int ln, int32_t fn) {
+  const uint64_t key = src_line_key(ln, fn);
+  uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+  src_line_entry_t* e = &src_line_table[SRC_LINE_TABLE_SIZE];
+  int i;
+
+  for (i = 0; i < SRC_LINE_MAX_PROBES; i++) {
+    src_line_entry_t* p =
+      &src_line_table[((h >> 32) + i) & (SRC_LINE_TABLE_SIZE - 1)];
+    uint64_t k = atomic_load_uint_least64_t(&p->key);
+    if (k == SRC_LINE_EMPTY) {
+      if (atomic_compare_exchange_strong_uint_least64_t(&p->key,
+                                                         SRC_LINE_EMPTY, key))
+        k = key;
+      else
+        k = atomic_load_uint_least64_t(&p->key);
+    }
+    if (k == key) {
+      e = p;
+      break;
+    }
+  }
+
+  (void) atomic_fetch_add_uint_least64_t(&e->ops, 1);
+  (void) atomic_fetch_add_uint_least64_t(&e->bytes, size);
+}
+
+int64_t chpl_comm_diags_src_line_capacity(void) {
+  return chpl_comm_diags_src_lines ? SRC_LINE_TABLE_SIZE + 1 : 0;
+}
+
+chpl_bool chpl_comm_diags_src_line_get(int64_t i, int32_t* ln, int32_t* fn,
+                                       uint64_t* ops, uint64_t* bytes) {
+  uint64_t key;
+
+  if (!chpl_comm_diags_src_lines || i < 0 || i > SRC_LINE_TABLE_SIZE)
+    return false;
+
+  *ops = atomic_load_uint_least64_t(&src_line_table[i].ops);
+  if (*ops == 0)
+    return false;
+  *bytes = atomic_load_uint_least64_t(&src_line_table[i].bytes);
+
+  if (i == SRC_LINE_TABLE_SIZE) {
+    // the overflow entry
+    *ln = -1;
+    *fn = -1;
+  } else {
+    key = atomic_load_uint_least64_t(&src_line_table[i].key);
+    *ln = (int32_t) (uint32_t) key;
+    *fn = (int32_t) (key >> 32);
+  }
+  return true;
+}
+
+
 void chpl_startVerboseComm() {
   chpl_verbose_comm = 1;
   chpl_comm_diags_disable();
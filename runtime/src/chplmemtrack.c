@@ -28,6 +28,7 @@
 #include "chpl-comm.h"
 #include "chplcgfns.h"
 #include "chpl-linefile-support.h"
+#include "chpl-thread-local-storage.h"
 #include "config.h"
 #include "error.h"
 
@@ -58,6 +59,7 @@ extern void chpl_memTracking_returnConfigVals(chpl_bool* memTrack,
                                               chpl_bool* memLeaks,
                                               size_t* memMax,
                                               size_t* memThreshold,
+                                              size_t* memSampleBytes,
                                               c_string* memLog,
                                               c_string* memLeaksLog);
 
@@ -70,6 +72,7 @@ typedef struct memTableEntry_struct { /* table entry */
   void* memAlloc;
   int32_t lineno;
   int32_t filename;
+  size_t charge;        /* bytes counted in the stats for this entry */
   struct memTableEntry_struct* nextInBucket;
 } memTableEntry;
 
@@ -79,10 +82,27 @@ static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table is split into shards by allocation address.  Each shard
+// has its own lock, hash table, and counters, so tasks allocating at
+// the same time rarely contend and a resize only rehashes one shard.
+// A free always finds its entry in the shard its allocation went to.
+// The reporting functions merge the shards.
+//
+#define MEMTRACK_NUM_SHARDS 64
+
+typedef struct {
+  pthread_mutex_t lock;
+  memTableEntry** table;
+  int hashSizeIndex;
+  int hashSize;
+  size_t entries;      /* number of entries in this shard's table */
+  size_t allocated;    /* memory allocated, for this shard's entries */
+  size_t freed;        /* memory freed, for this shard's entries */
+} __attribute__((aligned(64))) memTableShard;
+
+static memTableShard memShards[MEMTRACK_NUM_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -90,15 +110,22 @@ static c_string memLeaksByDesc = "";
 static _Bool memLeaks = false;
 static size_t memMax = 0;
 static size_t memThreshold = 0;
+static size_t memSampleBytes = 0;
 static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
 
 static size_t totalMem = 0;       /* total memory currently allocated */
 static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
+
+//
+// With sampling on (memSampleBytes > 0), each thread counts down the
+// bytes it allocates and records only the allocation that takes the
+// count to zero, charging it memSampleBytes.  Allocations at least
+// that large are always recorded at their actual size.  The stats are
+// then estimates, but ones that don't drift in either direction.
+//
+static CHPL_TLS_DECL(uintptr_t, memSampleCountdown);
 
 
 // We can't use a sync var for concurrency control here.  The Qthreads
@@ -111,18 +138,27 @@ static size_t totalEntries = 0;     /* number of entries in hash table */
 // by means of sync vars.  So, we use a pthread mutex.  Note that this
 // is only safe if we cannot switch tasks on a pthread while holding the
 // mutex and then try to lock it recursively.  Currently that is the
-// case, since we do not yield while holding the mutex.
+// case, since we do not yield while holding the mutex.  Each shard
+// has its own mutex, and the overall totals have another one that is
+// only ever held for a few instructions.
 // 
-static pthread_mutex_t memTrack_lockVar = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t memStat_lockVar = PTHREAD_MUTEX_INITIALIZER;
+
+static inline
+void memTrack_lock(memTableShard* shard) {
+  (void) pthread_mutex_lock(&shard->lock);
+}
 
 static inline
-void memTrack_lock(void) {
-  (void) pthread_mutex_lock(&memTrack_lockVar);
+void memTrack_unlock(memTableShard* shard) {
+  (void) pthread_mutex_unlock(&shard->lock);
 }
 
 static inline
-void memTrack_unlock(void) {
-  (void) pthread_mutex_unlock(&memTrack_lockVar);
+memTableShard* memTrack_shard(void* memAlloc) {
+  uint64_t h = ((uint64_t) (uintptr_t) memAlloc >> 4)
+               * UINT64_C(0x9E3779B97F4A7C15);
+  return &memShards[(h >> 32) % MEMTRACK_NUM_SHARDS];
 }
 
 
@@ -152,6 +188,7 @@ void chpl_setMemFlags(void) {
                                     &memLeaks,
                                     &memMax,
                                     &memThreshold,
+                                    &memSampleBytes,
                                     &memLog,
                                     &memLeaksLog);
 
@@ -179,9 +216,14 @@ void chpl_setMemFlags(void) {
   }
 
   if (chpl_memTrack) {
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+    for (int i = 0; i < MEMTRACK_NUM_SHARDS; i++) {
+      memTableShard* shard = &memShards[i];
+      (void) pthread_mutex_init(&shard->lock, NULL);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->table = sys_calloc(shard->hashSize, sizeof(memTableEntry*));
+    }
+    CHPL_TLS_INIT(memSampleCountdown);
   }
 }
 
@@ -198,37 +240,67 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
-    chpl_error("Exceeded memory limit", lineno, filename);
+//
+// Returns the number of bytes to charge for an allocation of the given
+// size, or 0 if sampling says not to record it.
+//
+static size_t sampleCharge(size_t chunk) {
+  uintptr_t left;
+
+  if (memSampleBytes == 0 || chunk >= memSampleBytes)
+    return chunk;
+
+  left = (uintptr_t) CHPL_TLS_GET(memSampleCountdown);
+  if (left == 0)
+    left = memSampleBytes;
+  if (chunk < left) {
+    CHPL_TLS_SET(memSampleCountdown, left - chunk);
+    return 0;
   }
+  CHPL_TLS_SET(memSampleCountdown, memSampleBytes - (chunk - left));
+  return memSampleBytes;
+}
+
+
+static void increaseMemStat(memTableShard* shard, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  _Bool overMax;
+
+  shard->allocated += chunk;
+  (void) pthread_mutex_lock(&memStat_lockVar);
+  totalMem += chunk;
+  overMax = (memMax && (totalMem > memMax));
   if (totalMem > maxMem)
     maxMem = totalMem;
+  (void) pthread_mutex_unlock(&memStat_lockVar);
+  if (overMax) {
+    chpl_error("Exceeded memory limit", lineno, filename);
+  }
 }
 
 
-static void decreaseMemStat(size_t chunk) {
+static void decreaseMemStat(memTableShard* shard, size_t chunk) {
+  shard->freed += chunk;
+  (void) pthread_mutex_lock(&memStat_lockVar);
   totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+  (void) pthread_mutex_unlock(&memStat_lockVar);
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTableShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->table[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -236,20 +308,23 @@ resizeTable(int direction) {
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(shard->table);
+  shard->table = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+static void addMemTableEntry(memTableShard* shard,
+                             void *memAlloc, size_t number, size_t size,
+                             size_t charge,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shard->entries+1)*2 > shard->hashSize
+      && shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
 
   memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
@@ -257,33 +332,35 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                lineno, filename);
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->table[hashValue];
+  shard->table[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  memEntry->charge = charge;
+  increaseMemStat(shard, charge, lineno, filename);
+  shard->entries += 1;
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+static memTableEntry* removeMemTableEntry(memTableShard* shard,
+                                          void* address) {
+  unsigned hashValue = hash(address, shard->hashSize);
+  memTableEntry* thisBucketEntry = shard->table[hashValue];
   memTableEntry* deletedBucket = NULL;
 
   if (!thisBucketEntry)
     return NULL;
 
   if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
+    shard->table[hashValue] = thisBucketEntry->nextInBucket;
     deletedBucket = thisBucketEntry;
   } else {
-    for (thisBucketEntry = memTable[hashValue];
+    for (thisBucketEntry = shard->table[hashValue];
          thisBucketEntry != NULL;
          thisBucketEntry = thisBucketEntry->nextInBucket) {
 
@@ -296,10 +373,10 @@ static memTableEntry* removeMemTableEntry(void* address) {
     }
   }
   if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    decreaseMemStat(shard, deletedBucket->charge);
+    shard->entries -= 1;
+    if (shard->entries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+      resizeTable(shard, -1);
   }
   return deletedBucket;
 }
@@ -343,20 +420,40 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
              nodeWidth, chpl_nodeID);
   }
 
+  //
+  // Merge the shards' counters.
+  //
+  size_t totalAllocated = 0;
+  size_t totalFreed = 0;
+
+  for (int i = 0; i < MEMTRACK_NUM_SHARDS; i++) {
+    memTrack_lock(&memShards[i]);
+    totalAllocated += memShards[i].allocated;
+    totalFreed += memShards[i].freed;
+    memTrack_unlock(&memShards[i]);
+  }
+
   //
   // Take a pre-run through the descriptions and values to figure
   // out how long each line will need to be.
   //
-  static const struct {
+  struct {
     const char* desc;
-    size_t* val;
+    size_t val;
   } descsVals[] = {
-    { "Allocated Now:", &totalMem },
-    { "Allocation High Water Mark:", &maxMem },
-    { "Sum of Allocations:", &totalAllocated },
-    { "Sum of Frees:", &totalFreed },
+    { "Allocated Now:", 0 },
+    { "Allocation High Water Mark:", 0 },
+    { "Sum of Allocations:", totalAllocated },
+    { "Sum of Frees:", totalFreed },
+    { "Sampling Interval (bytes):", memSampleBytes },
   };
-  const int nDescsVals = sizeof(descsVals) / sizeof(descsVals[0]);
+  const int nDescsVals = sizeof(descsVals) / sizeof(descsVals[0])
+                         - ((memSampleBytes == 0) ? 1 : 0);
+
+  (void) pthread_mutex_lock(&memStat_lockVar);
+  descsVals[0].val = totalMem;
+  descsVals[1].val = maxMem;
+  (void) pthread_mutex_unlock(&memStat_lockVar);
 
   int descWidth = 0;
   int memWidth = 0;
@@ -366,9 +463,9 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     if (thisDescWidth > descWidth)
       descWidth = thisDescWidth;
     const int thisMemWidth =
-                (*descsVals[i].val == 0)
+                (descsVals[i].val == 0)
                 ? 1
-                : (int) lrint(ceil(log10((double) *descsVals[i].val)));
+                : (int) lrint(ceil(log10((double) descsVals[i].val)));
     if (thisMemWidth > memWidth)
       memWidth = thisMemWidth;
   }
@@ -377,22 +474,19 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   // Now finally, size the buffer, print the information, and send it
   // to the memory log file.
   //
-  char buf[4 * (strlen(prefixBuf) + 1 + descWidth + 1 + memWidth + 1) + 1];
+  char buf[nDescsVals * (strlen(prefixBuf) + 1 + descWidth + 1 + memWidth + 1)
+           + 1];
   size_t len;
 
-  memTrack_lock();
-
   len = 0;
   for (int i = 0; i < nDescsVals; i++) {
     len += snprintf(buf + len, sizeof(buf) - len,
                     "%s %-*s %*zd\n",
                     prefixBuf,
                     descWidth, descsVals[i].desc,
-                    memWidth, *descsVals[i].val);
+                    memWidth, descsVals[i].val);
   }
 
-  memTrack_unlock();
-
   fputs(buf, memLogFile);
 }
 
@@ -420,12 +514,21 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  //
+  // With sampling, an entry stands for charge/(number*size) allocations
+  // of its size, so we count it that many times.
+  //
+  for (int s = 0; s < MEMTRACK_NUM_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->table[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->charge;
+        table[3*me->description+1] += me->charge / (me->number*me->size);
+        table[3*me->description+2] = me->description;
+      }
     }
+    memTrack_unlock(shard);
   }
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
@@ -446,6 +549,10 @@ static void printMemAllocsByType(_Bool forLeaks,
   }
 
   fprintf(memLogFile, "                      Description of allocation\n");
+  if (memSampleBytes > 0) {
+    fprintf(memLogFile, "(estimated from allocations sampled every %zu bytes)\n",
+            memSampleBytes);
+  }
   fprintf(memLogFile, "==============================================================\n");
   for (i = 0; i < 3*(CHPL_RT_MD_NUM+chpl_mem_numDescs); i += 3) {
     if (table[i] > 0) {
@@ -526,7 +633,7 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   memTableEntry* memEntry;
   c_string memEntryFilename;
-  int n, i;
+  int n, nMax, i, s;
   char* loc;
   memTableEntry** table;
 
@@ -538,21 +645,26 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (s = 0; s < MEMTRACK_NUM_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        n += 1;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
+    memTrack_unlock(shard);
   }
 
   totalWidth = filenameWidth+numberWidth*4+descWidth+20;
@@ -574,16 +686,24 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
   if (!table)
     chpl_error("out of memory printing memory table", lineno, filename);
 
+  nMax = n;
   n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
+  for (s = 0; s < MEMTRACK_NUM_SHARDS; s++) {
+    memTableShard* shard = &memShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize && n < nMax; i++) {
+      for (memEntry = shard->table[i];
+           memEntry != NULL && n < nMax;
+           memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        table[n++] = memEntry;
+      }
     }
+    memTrack_unlock(shard);
   }
   qsort(table, n, sizeof(memTableEntry*), descCmp);
 
@@ -651,9 +771,14 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        int32_t lineno, int32_t filename) {
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      memTrack_unlock();
+      size_t charge = sampleCharge(number * size);
+      if (charge > 0) {
+        memTableShard* shard = memTrack_shard(memAlloc);
+        memTrack_lock(shard);
+        addMemTableEntry(shard, memAlloc, number, size, charge,
+                         description, lineno, filename);
+        memTrack_unlock(shard);
+      }
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -669,8 +794,9 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
   if (chpl_memTrack) {
-    memTrack_lock();
-    memEntry = removeMemTableEntry(memAlloc);
+    memTableShard* shard = memTrack_shard(memAlloc);
+    memTrack_lock(shard);
+    memEntry = removeMemTableEntry(shard, memAlloc);
     if (memEntry) {
       if (chpl_verbose_mem) {
         fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -681,7 +807,7 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       sys_free(memEntry);
     }
-    memTrack_unlock();
+    memTrack_unlock(shard);
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -695,14 +821,13 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
                          int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
 
-  if (chpl_memTrack && size > memThreshold) {
-    memTrack_lock();
-    if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
-      if (memEntry)
-        sys_free(memEntry);
-    }
-    memTrack_unlock();
+  if (chpl_memTrack && size > memThreshold && memAlloc) {
+    memTableShard* shard = memTrack_shard(memAlloc);
+    memTrack_lock(shard);
+    memEntry = removeMemTableEntry(shard, memAlloc);
+    if (memEntry)
+      sys_free(memEntry);
+    memTrack_unlock(shard);
   }
 }
 
@@ -713,9 +838,14 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          int32_t lineno, int32_t filename) {
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      memTrack_unlock();
+      size_t charge = sampleCharge(size);
+      if (charge > 0) {
+        memTableShard* shard = memTrack_shard(moreMemAlloc);
+        memTrack_lock(shard);
+        addMemTableEntry(shard, moreMemAlloc, 1, size, charge,
+                         description, lineno, filename);
+        memTrack_unlock(shard);
+      }
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
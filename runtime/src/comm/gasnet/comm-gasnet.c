@@ -25,6 +25,8 @@
 #include "gasnet_tools.h"
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
+#include "chpl-comm-amo-buff.h"
+#include "chpl-comm-indexed-xfer.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
 #include "chpl-mem.h"
@@ -250,7 +252,8 @@ typedef enum {
   SHUTDOWN,             // tell nodes to get ready for shutdown
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  AMO_BUFF              // apply a batch of buffered atomic ops
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -586,6 +589,16 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+// Apply the buffered atomic ops in the payload of this active message.
+static
+void AM_amo_buff(gasnet_token_t token, void* buf, size_t nbytes,
+                 gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1)
+{
+  amo_buff_apply((amo_buff_op_t*) buf, nbytes / sizeof(amo_buff_op_t));
+
+  GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -604,7 +617,8 @@ static gasnet_handlerentry_t ftable[] = {
   {SHUTDOWN,      AM_shutdown},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {AMO_BUFF,      AM_amo_buff}
 };
 
 //
@@ -640,6 +654,7 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
   ret = gasnet_put_nb_bulk(node, raddr, addr, size);
 
   chpl_comm_diags_incr(put_nb);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -674,6 +689,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
   ret = gasnet_get_nb_bulk(addr, node, raddr, size);
 
   chpl_comm_diags_incr(get_nb);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -906,6 +922,9 @@ void chpl_comm_post_task_init(void) {
 
   // Initialize the caching layer, if it is active.
   chpl_cache_init();
+
+  // Buffered atomics ship each buffer in one medium AM.
+  amo_buff_init(gasnet_AMMaxMedium() / sizeof(amo_buff_op_t));
 }
 
 void chpl_comm_rollcall(void) {
@@ -1130,6 +1149,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
     chpl_comm_diags_verbose_rdma("put", node, size, ln, fn);
     chpl_comm_diags_incr(put);
+    chpl_comm_diags_incr_src_line(size, ln, fn);
 
     // Handle remote address not in remote segment.
 #ifdef GASNET_SEGMENT_EVERYTHING
@@ -1206,6 +1226,7 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
 
     chpl_comm_diags_verbose_rdma("get", node, size, ln, fn);
     chpl_comm_diags_incr(get);
+    chpl_comm_diags_incr_src_line(size, ln, fn);
 
     // Handle remote address not in remote segment.
 
@@ -1348,6 +1369,8 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   // the case (chpl_nodeID == srcnode) is internally managed inside gasnet
   chpl_comm_diags_verbose_rdmaStrd("get", srcnode, ln, fn);
   chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_src_line(
+    chpl_comm_diags_strd_size(count, stridelevels, elemSize), ln, fn);
 
   // TODO -- handle strided get for non-registered memory
   gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls); 
@@ -1391,11 +1414,199 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   // the case (chpl_nodeID == dstnode) is internally managed inside gasnet
   chpl_comm_diags_verbose_rdmaStrd("put", dstnode, ln, fn);
   chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_src_line(
+    chpl_comm_diags_strd_size(count, stridelevels, elemSize), ln, fn);
 
   // TODO -- handle strided put for non-registered memory
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
 }
 
+//
+// Indexed (gather/scatter) transfers.  We bucket the elements by node
+// and hand each node's share to GASNet as one nonblocking VIS indexed
+// transfer, then wait for all of them together.  Elements whose remote
+// address isn't in the remote segment are moved one at a time through
+// the regular get/put, which knows how to handle that.
+//
+static
+void indexed_xfer(chpl_bool isGet, void* localaddr,
+                  c_nodeid_t* nodes, void** raddrs,
+                  size_t n, size_t elemSize,
+                  int32_t commID, int ln, int32_t fn) {
+  size_t* nodeStart;
+  size_t* order;
+  void** locList;
+  void** remList;
+  gasnet_handle_t* handles;
+  size_t numHandles = 0;
+  c_nodeid_t node;
+
+  if (n == 0)
+    return;
+
+  indexed_xfer_bucket(nodes, n, &nodeStart, &order);
+  locList = chpl_mem_allocMany(n, sizeof(locList[0]),
+                               CHPL_RT_MD_COMM_UTIL, 0, 0);
+  remList = chpl_mem_allocMany(n, sizeof(remList[0]),
+                               CHPL_RT_MD_COMM_UTIL, 0, 0);
+  handles = chpl_mem_allocMany(chpl_numNodes, sizeof(handles[0]),
+                               CHPL_RT_MD_COMM_UTIL, 0, 0);
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    // each node gets its own slice of the lists, so that none of them
+    // is reused while GASNet might still be looking at it
+    void** myLocs = &locList[nodeStart[node]];
+    void** myRems = &remList[nodeStart[node]];
+    size_t cnt = 0;
+    size_t k;
+
+    for (k = nodeStart[node]; k < nodeStart[node + 1]; k++) {
+      const size_t i = order[k];
+      void* laddr = (char*) localaddr + i * elemSize;
+
+      if (node == chpl_nodeID) {
+        if (isGet)
+          memmove(laddr, raddrs[i], elemSize);
+        else
+          memmove(raddrs[i], laddr, elemSize);
+        continue;
+      }
+
+#ifndef GASNET_SEGMENT_EVERYTHING
+      if (!chpl_comm_addr_gettable(node, raddrs[i], elemSize)) {
+        if (isGet)
+          chpl_comm_get(laddr, node, raddrs[i], elemSize, -1,
+                        commID, ln, fn);
+        else
+          chpl_comm_put(laddr, node, raddrs[i], elemSize, -1,
+                        commID, ln, fn);
+        continue;
+      }
+#endif
+
+      myLocs[cnt] = laddr;
+      myRems[cnt] = raddrs[i];
+      cnt++;
+    }
+
+    if (cnt == 0)
+      continue;
+
+    if (isGet) {
+      chpl_comm_diags_verbose_rdmaIdx("get", node, cnt, ln, fn);
+      chpl_comm_diags_incr(get);
+      chpl_comm_diags_incr_src_line(cnt * elemSize, ln, fn);
+      handles[numHandles++] =
+        gasnet_geti_nb_bulk(cnt, myLocs, elemSize,
+                            (gasnet_node_t) node, cnt, myRems, elemSize);
+    } else {
+      chpl_comm_diags_verbose_rdmaIdx("put", node, cnt, ln, fn);
+      chpl_comm_diags_incr(put);
+      chpl_comm_diags_incr_src_line(cnt * elemSize, ln, fn);
+      handles[numHandles++] =
+        gasnet_puti_nb_bulk((gasnet_node_t) node, cnt, myRems, elemSize,
+                            cnt, myLocs, elemSize);
+    }
+  }
+
+  gasnet_wait_syncnb_all(handles, numHandles);
+
+  chpl_mem_free(handles, 0, 0);
+  chpl_mem_free(remList, 0, 0);
+  chpl_mem_free(locList, 0, 0);
+  indexed_xfer_bucket_free(nodeStart, order);
+}
+
+void  chpl_comm_gatherv(void* dstaddr, c_nodeid_t* srcnodes, void** srcaddrs,
+                        size_t n, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn) {
+  indexed_xfer(true, dstaddr, srcnodes, srcaddrs, n, elemSize,
+               commID, ln, fn);
+}
+
+void  chpl_comm_scatterv(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                         size_t n, size_t elemSize,
+                         int32_t commID, int ln, int32_t fn) {
+  indexed_xfer(false, srcaddr, dstnodes, dstaddrs, n, elemSize,
+               commID, ln, fn);
+}
+
+//
+// Buffered atomics.  There are no network atomics here, so these act on
+// processor atomic objects.  Each buffer of ops for a node goes there
+// in one medium AM and is applied in the handler.
+//
+static
+void amo_buff_ship(c_nodeid_t node, amo_buff_op_t* ops, size_t n) {
+  done_t done;
+
+  chpl_comm_diags_verbose_executeOn("fast", node);
+  chpl_comm_diags_incr(execute_on_fast);
+
+  init_done_obj(&done, 1);
+  GASNET_Safe(gasnet_AMRequestMedium2(node, AMO_BUFF,
+                                      ops, n * sizeof(ops[0]),
+                                      Arg0(&done), Arg1(&done)));
+  wait_done_obj(&done);
+}
+
+#define DEFN_CHPL_COMM_ATOMIC_BUFF(_o, _opc, _f, _t)                    \
+  void chpl_comm_atomic_##_o##_unordered_##_f(void* operand,            \
+                                              c_nodeid_t node,          \
+                                              void* object,             \
+                                              int ln, int32_t fn) {     \
+    amo_buff_enqueue(node, object, _opc, amo_buff_type_##_f,            \
+                     operand, sizeof(_t));                              \
+  }
+
+#define DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(_f, _t)                          \
+  void chpl_comm_atomic_sub_unordered_##_f(void* operand,               \
+                                           c_nodeid_t node,             \
+                                           void* object,                \
+                                           int ln, int32_t fn) {        \
+    _t negOpnd = -*(_t*) operand;                                       \
+    amo_buff_enqueue(node, object, amo_buff_op_add, amo_buff_type_##_f, \
+                     &negOpnd, sizeof(_t));                             \
+  }
+
+DEFN_CHPL_COMM_ATOMIC_BUFF(and, amo_buff_op_and, int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(and, amo_buff_op_and, int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(and, amo_buff_op_and, uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(and, amo_buff_op_and, uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_BUFF(or, amo_buff_op_or, int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(or, amo_buff_op_or, int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(or, amo_buff_op_or, uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(or, amo_buff_op_or, uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_BUFF(xor, amo_buff_op_xor, int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(xor, amo_buff_op_xor, int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(xor, amo_buff_op_xor, uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(xor, amo_buff_op_xor, uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, uint64, uint64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, real32, _real32)
+DEFN_CHPL_COMM_ATOMIC_BUFF(add, amo_buff_op_add, real64, _real64)
+
+// Negate the integer types as unsigned, so the most negative value wraps.
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(int32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(int64, uint64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(uint64, uint64_t)
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(real32, _real32)
+DEFN_CHPL_COMM_ATOMIC_BUFF_SUB(real64, _real64)
+
+void chpl_comm_atomic_unordered_fence(void) {
+  amo_buff_flush();
+}
+
+void chpl_comm_atomic_unordered_task_fence(void) {
+  amo_buff_task_flush();
+}
+
 static inline
 void  execute_on_common(c_nodeid_t node, c_sublocid_t subloc,
                         chpl_fn_int_t fid,
@@ -1586,7 +1797,9 @@ void chpl_comm_make_progress(void)
   gasnet_AMPoll();
 }
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  amo_buff_task_flush();
+}
 
 void chpl_comm_gasnet_help_register_global_var(int i, wide_ptr_t wide_addr) {
   if (chpl_nodeID == 0) {
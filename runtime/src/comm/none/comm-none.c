@@ -184,6 +184,28 @@ void  chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides, c_nodeid_t srcno
                   typeIndex, commID, ln, fn);
 }
 
+void  chpl_comm_gatherv(void* dstaddr, c_nodeid_t* srcnodes, void** srcaddrs,
+                        size_t n, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn) {
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    assert(srcnodes[i]==0);
+    memmove((char*) dstaddr + i * elemSize, srcaddrs[i], elemSize);
+  }
+}
+
+void  chpl_comm_scatterv(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                         size_t n, size_t elemSize,
+                         int32_t commID, int ln, int32_t fn) {
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    assert(dstnodes[i]==0);
+    memmove(dstaddrs[i], (char*) srcaddr + i * elemSize, elemSize);
+  }
+}
+
 typedef struct {
   chpl_fn_int_t fid;
   size_t        arg_size;
@@ -28,7 +28,9 @@
 #include "chpl-comm.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
+#include "chpl-comm-amo-buff.h"
 #include "chpl-comm-diags.h"
+#include "chpl-comm-indexed-xfer.h"
 #include "chpl-comm-strd-xfer.h"
 #include "chpl-env.h"
 #include "chplexit.h"
@@ -149,6 +151,8 @@ static /*inline*/ chpl_comm_nb_handle_t ofi_put(const void*, c_nodeid_t,
                                                 void*, size_t);
 static /*inline*/ chpl_comm_nb_handle_t ofi_get(void*, c_nodeid_t,
                                                 void*, size_t);
+static void ofi_indexed(chpl_bool, void*, c_nodeid_t*, void**,
+                        size_t, size_t, int32_t, int, int32_t);
 static void waitForAmoComplete(struct perTxCtxInfo_t*);
 static void waitForTxCQ(struct perTxCtxInfo_t*, int, uint64_t);
 static void* allocBounceBuf(size_t);
@@ -231,6 +235,7 @@ static void init_ofiForRma(void);
 static void init_ofiForAms(void);
 
 static void init_bar(void);
+static void init_xoAgg(void);
 
 
 void chpl_comm_init(int *argc_p, char ***argv_p) {
@@ -260,6 +265,8 @@ void chpl_comm_post_task_init(void) {
     return;
   init_ofi();
   init_bar();
+  init_xoAgg();
+  amo_buff_init(SIZE_MAX);
 
   // chpl_cache_init();
 }
@@ -825,9 +832,13 @@ static void exit_any(int);
 static void fini_amHandling(void);
 static void fini_ofi(void);
 
+static void xoAggFlush(void);
+
 
 void chpl_comm_pre_task_exit(int all) {
   if (all) {
+    if (chpl_numNodes > 1)
+      xoAggFlush();
     chpl_comm_barrier("chpl_comm_pre_task_exit");
     fini_amHandling();
   }
@@ -1206,9 +1217,11 @@ int mrGetLocalKey(uint64_t* pKey, void* addr, size_t size) {
 typedef enum {
   am_opNil = 0,                         // no-op
   am_opCall,                            // call a function table function
+  am_opCallBatch,                       // do a batch of am_opCall requests
   am_opGet,                             // do an RMA GET
   am_opPut,                             // do an RMA PUT
   am_opAMO,                             // do an AMO
+  am_opAMOBatch,                        // do a batch of buffered AMOs
 } amOp_t;
 
 static void amRequestExecOn(c_nodeid_t, c_sublocid_t, chpl_fn_int_t,
@@ -1219,6 +1232,9 @@ static void amRequestAMO(c_nodeid_t, void*, const void*, const void*, void*,
                          int, enum fi_datatype, size_t);
 static void amRequestCommon(c_nodeid_t, chpl_comm_on_bundle_t*, size_t,
                             chpl_comm_amDone_t**);
+static chpl_bool xoAggEnqueue(c_nodeid_t, c_sublocid_t, chpl_fn_int_t,
+                              chpl_comm_on_bundle_t*, size_t);
+static void xoAggTaskFlush(void);
 
 
 int chpl_comm_numPollingTasks(void) {
@@ -1240,7 +1256,12 @@ void chpl_comm_make_progress(void) {
 }
 
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  if (chpl_numNodes > 1) {
+    xoAggTaskFlush();
+    amo_buff_task_flush();
+  }
+}
 
 
 void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
@@ -1289,6 +1310,13 @@ void chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
     chpl_comm_do_callbacks (&cb_data);
   }
 
+  //
+  // Small ones are coalesced with others to the same node, and counted
+  // when the batch is sent.
+  //
+  if (xoAggEnqueue(node, subloc, fid, arg, argSize))
+    return;
+
   chpl_comm_diags_verbose_executeOn("non-blocking", node);
   chpl_comm_diags_incr(execute_on_nb);
 
@@ -1337,6 +1365,262 @@ void amRequestExecOn(c_nodeid_t node, c_sublocid_t subloc,
 }
 
 
+//
+// Non-blocking executeOn aggregation.
+//
+// Small non-blocking executeOns are coalesced in per-thread buffers,
+// one per destination node, and each buffer is sent as a single
+// am_opCallBatch AM which the target unpacks into the individual
+// executeOn tasks.  Buffers are sent when full, at task end, by the
+// unordered fences, and periodically by a task the AM handler starts,
+// so that no executeOn waits indefinitely in a buffer no task will
+// flush.  As with the buffered AMOs, a buffer is detached under the
+// thread's lock and sent after releasing it.  While this is on, the
+// execute_on_nb comm diagnostic counts batches sent rather than
+// executeOns.
+//
+// This is off by default.  Setting CHPL_RT_COMM_OFI_AGG_EXECUTE_ON=true
+// turns it on.
+//
+
+#define XO_AGG_BUF_SIZE      ((size_t) 16 * 1024)
+#define XO_AGG_MAX_ARG_SIZE  ((size_t) 1024)
+#define XO_AGG_ALIGN         ((size_t) 16)
+#define XO_AGG_HDR_SIZE      ALIGN_UP(sizeof(chpl_comm_on_bundle_t),   \
+                                      XO_AGG_ALIGN)
+
+struct xoAggBuf_t {
+  char* buf;                    // header bundle, then executeOn bundles
+  size_t used;                  // #bytes used, including header
+  uint32_t count;               // #executeOn bundles
+};
+
+struct xoAggInfo_t {
+  pthread_mutex_t lock;
+  struct xoAggBuf_t* bufs;      // [chpl_numNodes]
+  atomic_int_least32_t nonEmpty;
+  atomic_int_least32_t shipping;
+  struct xoAggInfo_t* next;
+};
+
+static chpl_bool xoAggEnabled;
+static atomic_bool xoAggFlushTaskPending;
+static struct xoAggInfo_t* xoAggInfos;
+static pthread_mutex_t xoAggInfosLock = PTHREAD_MUTEX_INITIALIZER;
+static __thread struct xoAggInfo_t* xoAggMyInfo;
+
+
+static
+void init_xoAgg(void) {
+  xoAggEnabled = chpl_env_rt_get_bool("COMM_OFI_AGG_EXECUTE_ON", false);
+  atomic_init_bool(&xoAggFlushTaskPending, false);
+}
+
+
+static
+struct xoAggInfo_t* xoAggGetMyInfo(void) {
+  if (xoAggMyInfo == NULL) {
+    struct xoAggInfo_t* info;
+    CHPL_CALLOC(info, 1);
+    PTHREAD_CHK(pthread_mutex_init(&info->lock, NULL));
+    CHPL_CALLOC(info->bufs, chpl_numNodes);
+    atomic_init_int_least32_t(&info->nonEmpty, 0);
+    atomic_init_int_least32_t(&info->shipping, 0);
+
+    PTHREAD_CHK(pthread_mutex_lock(&xoAggInfosLock));
+    info->next = xoAggInfos;
+    xoAggInfos = info;
+    PTHREAD_CHK(pthread_mutex_unlock(&xoAggInfosLock));
+
+    xoAggMyInfo = info;
+  }
+
+  return xoAggMyInfo;
+}
+
+
+//
+// Detach a non-empty buffer for sending.  Called with the info locked.
+//
+static inline
+struct xoAggBuf_t xoAggDetach(struct xoAggInfo_t* info, c_nodeid_t node) {
+  struct xoAggBuf_t ab = info->bufs[node];
+  info->bufs[node] = (struct xoAggBuf_t) { .buf = NULL, .used = 0,
+                                           .count = 0 };
+  (void) atomic_fetch_sub_int_least32_t(&info->nonEmpty, 1);
+  (void) atomic_fetch_add_int_least32_t(&info->shipping, 1);
+  return ab;
+}
+
+
+static
+void xoAggShip(struct xoAggInfo_t* info, c_nodeid_t node,
+               struct xoAggBuf_t ab) {
+  chpl_comm_on_bundle_t* hdr = (chpl_comm_on_bundle_t*) ab.buf;
+  hdr->comm.xob = (struct chpl_comm_bundleData_execOnBatch_t)
+                    { .b = (struct chpl_comm_bundleData_base_t)
+                           { .op = am_opCallBatch, .node = chpl_nodeID },
+                      .count = ab.count,
+                      .size = ab.used };
+
+  chpl_comm_diags_verbose_executeOn("non-blocking", node);
+  chpl_comm_diags_incr(execute_on_nb);
+
+  DBG_PRINTF(DBG_AM | DBG_AMSEND,
+             "executeOn batch: %d executeOns (%zd bytes) to node %d",
+             (int) ab.count, ab.used, (int) node);
+  amRequestCommon(node, hdr, ab.used, NULL);
+  CHPL_FREE(ab.buf);
+  (void) atomic_fetch_sub_int_least32_t(&info->shipping, 1);
+}
+
+
+static
+chpl_bool xoAggEnqueue(c_nodeid_t node, c_sublocid_t subloc,
+                       chpl_fn_int_t fid,
+                       chpl_comm_on_bundle_t* arg, size_t argSize) {
+  if (!xoAggEnabled || argSize > XO_AGG_MAX_ARG_SIZE)
+    return false;
+
+  struct xoAggInfo_t* info = xoAggGetMyInfo();
+  const size_t slotSize = ALIGN_UP(argSize, XO_AGG_ALIGN);
+  struct xoAggBuf_t full = { .buf = NULL };
+
+  arg->comm.xo = (struct chpl_comm_bundleData_execOn_t)
+                   { .b = (struct chpl_comm_bundleData_base_t)
+                          { .op = am_opCall, .node = chpl_nodeID },
+                     .fast = false,
+                     .fid = fid,
+                     .argSize = argSize,
+                     .subloc = subloc,
+                     .pDone = NULL };
+
+  PTHREAD_CHK(pthread_mutex_lock(&info->lock));
+  struct xoAggBuf_t* ab = &info->bufs[node];
+  if (ab->buf != NULL && ab->used + slotSize > XO_AGG_BUF_SIZE)
+    full = xoAggDetach(info, node);
+  if (ab->buf == NULL) {
+    CHPL_CALLOC_SZ(ab->buf, 1, XO_AGG_BUF_SIZE);
+    ab->used = XO_AGG_HDR_SIZE;
+    (void) atomic_fetch_add_int_least32_t(&info->nonEmpty, 1);
+  }
+  memcpy(ab->buf + ab->used, arg, argSize);
+  ab->used += slotSize;
+  ab->count++;
+  PTHREAD_CHK(pthread_mutex_unlock(&info->lock));
+
+  if (full.buf != NULL)
+    xoAggShip(info, node, full);
+
+  return true;
+}
+
+
+static
+void xoAggFlushInfo(struct xoAggInfo_t* info) {
+  if (atomic_load_int_least32_t(&info->nonEmpty) == 0)
+    return;
+
+  for (c_nodeid_t node = 0; node < chpl_numNodes; node++) {
+    struct xoAggBuf_t ab = { .buf = NULL };
+
+    PTHREAD_CHK(pthread_mutex_lock(&info->lock));
+    if (info->bufs[node].buf != NULL)
+      ab = xoAggDetach(info, node);
+    PTHREAD_CHK(pthread_mutex_unlock(&info->lock));
+
+    if (ab.buf != NULL)
+      xoAggShip(info, node, ab);
+  }
+}
+
+
+//
+// Send every thread's buffers, without waiting for other threads'
+// sends already in progress.
+//
+static
+void xoAggFlushNoWait(void) {
+  PTHREAD_CHK(pthread_mutex_lock(&xoAggInfosLock));
+  struct xoAggInfo_t* infos = xoAggInfos;
+  PTHREAD_CHK(pthread_mutex_unlock(&xoAggInfosLock));
+
+  for (struct xoAggInfo_t* info = infos; info != NULL; info = info->next)
+    xoAggFlushInfo(info);
+}
+
+
+static
+void xoAggFlushTask(void* argNil) {
+  atomic_store_bool(&xoAggFlushTaskPending, false);
+  xoAggFlushNoWait();
+}
+
+
+//
+// The AM handler calls this to make sure buffered executeOns eventually
+// go out even if no task on our side will flush them.  It can't send
+// them itself, because sending needs a non-handler tciTab[] entry and
+// the worker threads holding those may be waiting for the AM handler.
+// Instead it starts a task to do the sending, if one isn't already
+// pending.
+//
+static
+void xoAggStartFlushTask(void) {
+  PTHREAD_CHK(pthread_mutex_lock(&xoAggInfosLock));
+  struct xoAggInfo_t* infos = xoAggInfos;
+  PTHREAD_CHK(pthread_mutex_unlock(&xoAggInfosLock));
+
+  struct xoAggInfo_t* info;
+  for (info = infos; info != NULL; info = info->next) {
+    if (atomic_load_int_least32_t(&info->nonEmpty) > 0)
+      break;
+  }
+  if (info == NULL)
+    return;
+
+  if (atomic_exchange_bool(&xoAggFlushTaskPending, true))
+    return;
+
+  chpl_task_bundle_t arg = { .is_executeOn = false };
+  DBG_PRINTF(DBG_AM, "AM handler startMovedTask(xoAggFlushTask())");
+  chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) xoAggFlushTask,
+                           &arg, sizeof(arg), c_sublocid_any,
+                           chpl_nullTaskID);
+}
+
+
+static
+void xoAggFlush(void) {
+  if (!xoAggEnabled)
+    return;
+
+  xoAggFlushNoWait();
+
+  PTHREAD_CHK(pthread_mutex_lock(&xoAggInfosLock));
+  struct xoAggInfo_t* infos = xoAggInfos;
+  PTHREAD_CHK(pthread_mutex_unlock(&xoAggInfosLock));
+
+  for (struct xoAggInfo_t* info = infos; info != NULL; info = info->next) {
+    while (atomic_load_int_least32_t(&info->shipping) > 0)
+      local_yield();
+  }
+}
+
+
+static
+void xoAggTaskFlush(void) {
+  if (!xoAggEnabled)
+    return;
+
+  if (chpl_task_canMigrateThreads()) {
+    xoAggFlush();
+  } else if (xoAggMyInfo != NULL) {
+    xoAggFlushInfo(xoAggMyInfo);
+  }
+}
+
+
 static inline
 void amRequestRMA(c_nodeid_t node, amOp_t op,
                   void* addr, void* raddr, size_t size) {
@@ -1512,11 +1796,13 @@ static pthread_mutex_t amStartStopMutex = PTHREAD_MUTEX_INITIALIZER;
 static void amHandler(void*);
 static void processRxAmReq(struct perTxCtxInfo_t*);
 static void amHandleExecOn(chpl_comm_on_bundle_t*);
+static void amHandleExecOnBatch(chpl_comm_on_bundle_t*);
 static void amExecOnWrapper(void*);
 static inline void realExecOnWrapper(void*, chpl_bool);
 static void amGetWrapper(void*);
 static void amPutWrapper(void*);
 static void amHandleAMO(chpl_comm_on_bundle_t*);
+static void amAMOBatchWrapper(void*);
 static void amSendDone(c_nodeid_t, chpl_comm_amDone_t*);
 
 static inline void doCpuAMO(void*, const void*, const void*, void*,
@@ -1602,6 +1888,16 @@ void amHandler(void* argNil) {
       if ((++progressInterval & 0xff) == 0)
         chpl_comm_make_progress();
     }
+
+    //
+    // Similarly, have any coalesced executeOns that have been waiting
+    // a while sent, in case no task on our side will flush them.
+    //
+    {
+      static __thread int xoAggInterval;
+      if (xoAggEnabled && (++xoAggInterval & 0x3ff) == 0)
+        xoAggStartFlushTask();
+    }
   }
 
   //
@@ -1688,6 +1984,10 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
           }
           break;
 
+        case am_opCallBatch:
+          amHandleExecOnBatch(req);
+          break;
+
         case am_opGet:
           //
           // We use a task here mainly to ensure that the GET this AM
@@ -1724,6 +2024,18 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
           amHandleAMO(req);
           break;
 
+        case am_opAMOBatch:
+          //
+          // A task GETs the batch of ops, for the same reason as above.
+          //
+          DBG_PRINTF(DBG_AM | DBG_AMRECV,
+                     "AM req startMovedTask(amAMOBatchWrapper())");
+          chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) amAMOBatchWrapper,
+                                   chpl_comm_on_bundle_task_bundle(req),
+                                   sizeof(*req), c_sublocid_any,
+                                   chpl_nullTaskID);
+          break;
+
         default:
           INTERNAL_ERROR_V("unexpected AM op %d", req->comm.b.op);
           break;
@@ -1761,6 +2073,24 @@ void amHandleExecOn(chpl_comm_on_bundle_t* req) {
 }
 
 
+static
+void amHandleExecOnBatch(chpl_comm_on_bundle_t* req) {
+  struct chpl_comm_bundleData_execOnBatch_t* xob = &req->comm.xob;
+  DBG_PRINTF(DBG_AM | DBG_AMRECV,
+             "amHandleExecOnBatch() for node %d: %d executeOns",
+             (int) xob->b.node, (int) xob->count);
+
+  char* p = (char*) req + XO_AGG_HDR_SIZE;
+  for (uint32_t i = 0; i < xob->count; i++) {
+    chpl_comm_on_bundle_t* xoReq = (chpl_comm_on_bundle_t*) p;
+    CHK_TRUE(xoReq->comm.b.op == am_opCall);
+    amHandleExecOn(xoReq);
+    p += ALIGN_UP(xoReq->comm.xo.argSize, XO_AGG_ALIGN);
+  }
+  CHK_TRUE(p == (char*) req + xob->size);
+}
+
+
 static
 void amExecOnWrapper(void* p) {
   realExecOnWrapper(p, false);
@@ -1898,6 +2228,24 @@ void amHandleAMO(chpl_comm_on_bundle_t* req) {
 }
 
 
+static
+void amAMOBatchWrapper(void* p) {
+  chpl_comm_on_bundle_t* req = (chpl_comm_on_bundle_t*) p;
+  struct chpl_comm_bundleData_RMA_t* rma = &req->comm.rma;
+
+  DBG_PRINTF(DBG_AM | DBG_AMRECV | DBG_AMO,
+             "amAMOBatchWrapper(): %d:%p (%zd bytes)",
+             (int) rma->b.node, rma->raddr, rma->size);
+  CHK_TRUE(mrGetKey(NULL, rma->b.node, rma->raddr, rma->size) == 0); // sanity
+  amo_buff_op_t* ops = allocBounceBuf(rma->size);
+  (void) ofi_get(ops, rma->b.node, rma->raddr, rma->size);
+  amo_buff_apply(ops, rma->size / sizeof(ops[0]));
+  freeBounceBuf(ops);
+
+  amSendDone(rma->b.node, rma->pDone);
+}
+
+
 static
 void amSendDone(c_nodeid_t node, chpl_comm_amDone_t* pDone) {
   static __thread chpl_comm_amDone_t* myDone = NULL;
@@ -1991,6 +2339,7 @@ void chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("put", node, size, ln, fn);
   chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   (void) ofi_put(addr, node, raddr, size);
 }
@@ -2020,6 +2369,7 @@ void chpl_comm_get(void* addr, int32_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("get", node, size, ln, fn);
   chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   (void) ofi_get(addr, node, raddr, size);
 }
@@ -2055,6 +2405,20 @@ void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
 }
 
 
+void chpl_comm_gatherv(void* dstaddr, c_nodeid_t* srcnodes, void** srcaddrs,
+                       size_t n, size_t elemSize,
+                       int32_t commID, int ln, int32_t fn) {
+  ofi_indexed(true, dstaddr, srcnodes, srcaddrs, n, elemSize, commID, ln, fn);
+}
+
+
+void chpl_comm_scatterv(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                        size_t n, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn) {
+  ofi_indexed(false, srcaddr, dstnodes, dstaddrs, n, elemSize, commID, ln, fn);
+}
+
+
 ////////////////////////////////////////
 //
 // Internal communication support
@@ -2275,6 +2639,128 @@ chpl_comm_nb_handle_t ofi_get(void *addr, c_nodeid_t node,
 }
 
 
+//
+// Indexed (gather/scatter) RMA.  The elements are bucketed by node and
+// each node's share is issued back to back on a single tx context, so
+// that the only waiting we do is when the tx CQ fills up and once at
+// the end.  Elements whose remote address isn't RMA-accessible, and
+// those on our own node, go through the regular get/put instead.
+//
+static
+void ofi_indexed(chpl_bool isGet, void* addr,
+                 c_nodeid_t* nodes, void** raddrs,
+                 size_t n, size_t elemSize,
+                 int32_t commID, int ln, int32_t fn) {
+  const uint64_t xpctFlags = FI_RMA | (isGet ? FI_READ : FI_WRITE);
+  size_t* nodeStart;
+  size_t* order;
+  uint64_t mrKey;
+  c_nodeid_t node;
+  size_t k;
+
+  if (n == 0) {
+    return;
+  }
+
+  DBG_PRINTF(DBG_RMA | (isGet ? DBG_RMAREAD : DBG_RMAWRITE),
+             "%s indexed %p, %zd elems of size %zd",
+             isGet ? "GET" : "PUT", addr, n, elemSize);
+
+  void* mrDesc = NULL;
+  void* myAddr = addr;
+  if (mrGetLocalDesc(&mrDesc, myAddr, n * elemSize) != 0) {
+    myAddr = allocBounceBuf(n * elemSize);
+    CHK_TRUE(mrGetLocalDesc(&mrDesc, myAddr, n * elemSize) == 0);
+    if (!isGet) {
+      memcpy(myAddr, addr, n * elemSize);
+    }
+  }
+
+  indexed_xfer_bucket(nodes, n, &nodeStart, &order);
+
+  struct perTxCtxInfo_t* tcip;
+  CHK_TRUE((tcip = tciAlloc(false /*bindToAmHandler*/)) != NULL);
+  CHK_TRUE(tcip->txCtxHasCQ);
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    size_t cnt = 0;
+
+    if (node == chpl_nodeID) {
+      continue;
+    }
+
+    for (k = nodeStart[node]; k < nodeStart[node + 1]; k++) {
+      const size_t i = order[k];
+      void* lAddr = (char*) myAddr + i * elemSize;
+
+      if (mrGetKey(&mrKey, node, raddrs[i], elemSize) != 0) {
+        continue;
+      }
+
+      if (tcip->numTxsOut >= txCQSize) {
+        waitForTxCQ(tcip, tcip->numTxsOut, xpctFlags);
+      }
+
+      if (isGet) {
+        OFI_CHK(fi_read(tcip->txCtx, lAddr, elemSize,
+                        mrDesc, ofi_rxAddrsRma[node], (uint64_t) raddrs[i],
+                        mrKey, 0));
+      } else {
+        OFI_CHK(fi_write(tcip->txCtx, lAddr, elemSize,
+                         mrDesc, ofi_rxAddrsRma[node], (uint64_t) raddrs[i],
+                         mrKey, 0));
+      }
+      tcip->numTxsOut++;
+      cnt++;
+    }
+
+    if (cnt > 0) {
+      chpl_comm_diags_verbose_rdmaIdx(isGet ? "get" : "put", node, cnt,
+                                      ln, fn);
+      if (isGet) {
+        chpl_comm_diags_incr(get);
+      } else {
+        chpl_comm_diags_incr(put);
+      }
+      chpl_comm_diags_incr_src_line(cnt * elemSize, ln, fn);
+    }
+  }
+
+  waitForTxCQ(tcip, tcip->numTxsOut, xpctFlags);
+  tciFree(tcip);
+
+  //
+  // Now the stragglers: local elements, and ones we can't RMA to.
+  //
+  for (node = 0; node < chpl_numNodes; node++) {
+    for (k = nodeStart[node]; k < nodeStart[node + 1]; k++) {
+      const size_t i = order[k];
+      void* lAddr = (char*) myAddr + i * elemSize;
+
+      if (node != chpl_nodeID
+          && mrGetKey(&mrKey, node, raddrs[i], elemSize) == 0) {
+        continue;
+      }
+
+      if (isGet) {
+        chpl_comm_get(lAddr, node, raddrs[i], elemSize, -1, commID, ln, fn);
+      } else {
+        chpl_comm_put(lAddr, node, raddrs[i], elemSize, -1, commID, ln, fn);
+      }
+    }
+  }
+
+  indexed_xfer_bucket_free(nodeStart, order);
+
+  if (myAddr != addr) {
+    if (isGet) {
+      memcpy(addr, myAddr, n * elemSize);
+    }
+    freeBounceBuf(myAddr);
+  }
+}
+
+
 static
 chpl_comm_nb_handle_t ofi_amo(struct perTxCtxInfo_t* tcip,
                               c_nodeid_t node, void* object, uint64_t mrKey,
@@ -2593,8 +3079,8 @@ DEFN_CHPL_COMM_ATOMIC_CMPXCHG(real64, FI_DOUBLE, double)
                "chpl_comm_atomic_%s_unordered_%s(<%s>, %d, %p, %d, %s)",\
                #fnOp, #fnType, DBG_VAL(operand, ofiType), (int) node,   \
                object, ln, chpl_lookupFilename(fn));                    \
-    chpl_comm_atomic_##fnOp##_##fnType(operand, node, object,           \
-                                       memory_order_seq_cst, ln, fn);   \
+    amo_buff_enqueue(node, object, amo_buff_op_##fnOp,                  \
+                     amo_buff_type_##fnType, operand, sizeof(Type));    \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_##fnOp##_##fnType                         \
@@ -2653,8 +3139,9 @@ DEFN_IFACE_AMO_SIMPLE_OP(add, FI_SUM, real64, FI_DOUBLE, double)
                "%d, %s)",                                               \
                #fnType, DBG_VAL(operand, ofiType), (int) node, object,  \
                ln, chpl_lookupFilename(fn));                            \
-    chpl_comm_atomic_sub_##fnType(operand, node, object,                \
-                                  memory_order_seq_cst, ln, fn);        \
+    Type myOpnd = negate(*(Type*) operand);                             \
+    amo_buff_enqueue(node, object, amo_buff_op_add,                     \
+                     amo_buff_type_##fnType, &myOpnd, sizeof(Type));    \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_sub_##fnType                              \
@@ -2682,12 +3169,89 @@ DEFN_IFACE_AMO_SUB(real32, FI_FLOAT, float, NEGATE_U_OR_R)
 DEFN_IFACE_AMO_SUB(real64, FI_DOUBLE, double, NEGATE_U_OR_R)
 
 
+//
+// The unordered ops are buffered per destination node and each buffer
+// is applied on its target by the CPU, in one AM.  The target GETs the
+// ops from us, so they have to be in registered memory.  The buffers
+// come from the regular heap, which isn't registered unless it's the
+// fixed heap, so ship from a bounce buffer if needed.  If even that
+// isn't registered, send the ops one at a time.
+//
+static void amo_buff_ship_unbatched(c_nodeid_t, amo_buff_op_t*, size_t);
+
+static
+void amo_buff_ship(c_nodeid_t node, amo_buff_op_t* ops, size_t n) {
+  const size_t size = n * sizeof(ops[0]);
+  amo_buff_op_t* myOps = ops;
+  if (mrGetLocalKey(NULL, myOps, size) != 0) {
+    myOps = allocBounceBuf(size);
+    if (mrGetLocalKey(NULL, myOps, size) != 0) {
+      freeBounceBuf(myOps);
+      amo_buff_ship_unbatched(node, ops, n);
+      return;
+    }
+    DBG_PRINTF(DBG_AMO, "AMO batch BB: %p", myOps);
+    memcpy(myOps, ops, size);
+  }
+
+  DBG_PRINTF(DBG_AMO, "AMO batch via AM: %d ops to node %d", (int) n,
+             (int) node);
+  amRequestRMA(node, am_opAMOBatch, myOps, NULL, size);
+
+  if (myOps != ops) {
+    freeBounceBuf(myOps);
+  }
+}
+
+
+static
+void amo_buff_ship_unbatched(c_nodeid_t node, amo_buff_op_t* ops, size_t n) {
+  DBG_PRINTF(DBG_AMO, "AMO batch unbatched: %d ops to node %d", (int) n,
+             (int) node);
+  for (size_t i = 0; i < n; i++) {
+    int ofiOp = FI_SUM;
+    switch ((amo_buff_opcode_t) ops[i].op) {
+    case amo_buff_op_add: ofiOp = FI_SUM; break;
+    case amo_buff_op_and: ofiOp = FI_BAND; break;
+    case amo_buff_op_or:  ofiOp = FI_BOR; break;
+    case amo_buff_op_xor: ofiOp = FI_BXOR; break;
+    default:
+      INTERNAL_ERROR_V("unexpected buffered AMO op %d", (int) ops[i].op);
+    }
+
+    enum fi_datatype ofiType = FI_INT64;
+    size_t size = sizeof(int64_t);
+    switch ((amo_buff_type_t) ops[i].type) {
+    case amo_buff_type_int32:  ofiType = FI_INT32;  size = 4; break;
+    case amo_buff_type_int64:  ofiType = FI_INT64;  size = 8; break;
+    case amo_buff_type_uint32: ofiType = FI_UINT32; size = 4; break;
+    case amo_buff_type_uint64: ofiType = FI_UINT64; size = 8; break;
+    case amo_buff_type_real32: ofiType = FI_FLOAT;  size = 4; break;
+    case amo_buff_type_real64: ofiType = FI_DOUBLE; size = 8; break;
+    default:
+      INTERNAL_ERROR_V("unexpected buffered AMO type %d", (int) ops[i].type);
+    }
+
+    //
+    // These are processor atomics, so have the target's CPU do them.
+    //
+    amRequestAMO(node, ops[i].obj, &ops[i].operand, NULL, NULL,
+                 ofiOp, ofiType, size);
+  }
+}
+
 void chpl_comm_atomic_unordered_fence(void) {
-  return;
+  if (chpl_numNodes > 1) {
+    xoAggFlush();
+    amo_buff_flush();
+  }
 }
 
 void chpl_comm_atomic_unordered_task_fence(void) {
-  return;
+  if (chpl_numNodes > 1) {
+    xoAggTaskFlush();
+    amo_buff_task_flush();
+  }
 }
 
 
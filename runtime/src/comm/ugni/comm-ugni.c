@@ -56,6 +56,7 @@
 #include "chpl-comm-diags.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
+#include "chpl-comm-indexed-xfer.h"
 #include "chpl-comm-strd-xfer.h"
 #include "chpl-env.h"
 #include "chplexit.h"
@@ -5118,6 +5119,7 @@ void chpl_comm_put(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("put", locale, size, ln, fn);
   chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   do_remote_put(addr, locale, raddr, size, NULL, may_proxy_true);
 }
@@ -5601,6 +5603,7 @@ void chpl_comm_get_unordered(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("unordered get", locale, size, ln, fn);
   chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   do_remote_get_buff(addr, locale, raddr, size, may_proxy_true);
 }
@@ -5641,6 +5644,7 @@ void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("get", locale, size, ln, fn);
   chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   do_remote_get(addr, locale, raddr, size, may_proxy_true);
 }
@@ -6129,6 +6133,36 @@ void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
 }
 
 
+//
+// Indexed gathers ride on the unordered GET buffers, which already
+// batch GETs to the same locale into FMA chains.  Scatters use the
+// common nonblocking implementation.
+//
+void chpl_comm_gatherv(void* dstaddr, c_nodeid_t* srcnodes, void** srcaddrs,
+                       size_t n, size_t elemSize,
+                       int32_t commID, int ln, int32_t fn)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    chpl_comm_get_unordered((char*) dstaddr + i * elemSize,
+                            srcnodes[i], srcaddrs[i], elemSize,
+                            -1, commID, ln, fn);
+  }
+  chpl_comm_get_unordered_task_fence();
+}
+
+
+void chpl_comm_scatterv(c_nodeid_t* dstnodes, void** dstaddrs, void* srcaddr,
+                        size_t n, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn)
+{
+  scatterv_common(dstnodes, dstaddrs, srcaddr, n, elemSize,
+                  strd_maxHandles, local_yield,
+                  commID, ln, fn);
+}
+
+
 //
 // Non-blocking get interface
 //
@@ -6170,6 +6204,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t locale,
 
   chpl_comm_diags_verbose_rdma("non-blocking get", locale, size, ln, fn);
   chpl_comm_diags_incr(get_nb);
+  chpl_comm_diags_incr_src_line(size, ln, fn);
 
   //
   // For now, if the local address isn't in a memory region known to the
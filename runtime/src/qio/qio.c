@@ -33,10 +33,12 @@
 
 #ifndef CHPL_RT_UNIT_TEST
 #include "chplrt.h"
+#include "chpl-env.h"
 #endif
 
 #include "qio.h"
 #include "qbuffer.h"
+#include "qio_uring.h"
 
 #include "error.h"
 
@@ -54,6 +56,7 @@
 #include <sys/select.h>
 //#include <sys/fcntl.h> no sys/fcntl.h on AIX, fcntl.h should cover it.
 #include <sys/stat.h>
+#include <sched.h>
 
 #include <assert.h>
 
@@ -87,11 +90,29 @@
 // when rounding up to 4k pages.
 ssize_t qio_too_small_for_default_mmap = 16*1024;
 ssize_t qio_mmap_chunk_iobufs = 128; // mmap 128 iobufs at a time (8M)
+ssize_t qio_async_iobufs = 4; // QIO_HINT_ASYNC keeps 4 iobufs in flight
 
 // Future - possibly set this based on ulimit?
 ssize_t qio_initial_mmap_max = 8*1024*1024;
 bool qio_allow_default_mmap = true;
 
+// io_uring is still experimental, so QIO_HINT_PARALLEL files only
+// use it by default when CHPL_RT_IO_URING is true.
+static
+bool qio_allow_default_uring(void)
+{
+#ifdef _chplrt_H_
+  static int allow = -1;
+  if( allow < 0 ) {
+    allow = chpl_env_rt_get_bool("IO_URING", false) &&
+            qio_uring_supported();
+  }
+  return allow;
+#else
+  return false;
+#endif
+}
+
 #ifdef _chplrt_H_
 qioerr qio_lock(qio_lock_t* x) {
   // recursive mutex based on glibc pthreads implementation
@@ -410,6 +431,90 @@ error:
   return err;
 }
 
+// Returns the io_uring for QIO_METHOD_URING channels on this file,
+// creating it if necessary, or NULL to use preadv/pwritev instead.
+static
+qio_uring_t* _qio_file_uring(qio_file_t* file)
+{
+  qioerr err;
+
+  err = qio_lock(&file->lock);
+  if( err ) return NULL;
+
+  if( ! file->uring_tried ) {
+    file->uring_tried = true;
+    // On failure, file->uring stays NULL and we fall back to preadv.
+    (void) qio_uring_create(&file->uring);
+  }
+
+  qio_unlock(&file->lock);
+
+  return file->uring;
+}
+
+static
+qioerr _qio_uring_rwv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, int writing, ssize_t* num_out)
+{
+  ssize_t num = 0;
+  int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
+  ssize_t num_parts = qbuffer_iter_num_parts(start, end);
+  struct iovec* iov = NULL;
+  size_t iovcnt;
+  MAYBE_STACK_SPACE(struct iovec, iov_onstack);
+  qio_uring_t* ring;
+  qioerr err;
+
+  if( num_bytes < 0 || num_parts < 0 || num_parts > INT_MAX ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "range outside of buffer");
+  }
+
+  ring = _qio_file_uring(file);
+
+  STARTING_SLOW_SYSCALL;
+
+  MAYBE_STACK_ALLOC(struct iovec, num_parts, iov, iov_onstack);
+  if( ! iov ) {
+    err = QIO_ENOMEM;
+    goto error;
+  }
+
+  err = qbuffer_to_iov(buf, start, end, num_parts, iov, NULL, &iovcnt);
+  if( err ) goto error;
+
+  if( writing )
+    err = qio_int_to_err(sys_uring_pwritev(ring, file->fd, iov, iovcnt, seek_to_offset, &num));
+  else
+    err = qio_int_to_err(sys_uring_preadv(ring, file->fd, iov, iovcnt, seek_to_offset, &num));
+
+error:
+  MAYBE_STACK_FREE(iov, iov_onstack);
+
+  *num_out = num;
+
+  DONE_SLOW_SYSCALL;
+
+  return err;
+}
+
+// Like qio_preadv, but the read is submitted through the file's
+// io_uring along with those of any other channels on the file.
+qioerr qio_uring_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read)
+{
+  // Filesystem plugins do their own I/O.
+  if( file->fd == -1 )
+    return qio_preadv(file, buf, start, end, seek_to_offset, num_read);
+
+  return _qio_uring_rwv(file, buf, start, end, seek_to_offset, 0, num_read);
+}
+
+qioerr qio_uring_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written)
+{
+  if( file->fd == -1 )
+    return qio_pwritev(file, buf, start, end, seek_to_offset, num_written);
+
+  return _qio_uring_rwv(file, buf, start, end, seek_to_offset, 1, num_written);
+}
+
 qioerr qio_recv(fd_t sockfd, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int flags,
               sys_sockaddr_t* src_addr_out, /* can be NULL */
               void* ancillary_out, socklen_t* ancillary_len_inout, /* can be NULL */
@@ -566,8 +671,12 @@ qio_hint_t choose_io_method(qio_file_t* file, qio_hint_t hints, qio_hint_t defau
           // Always default to fread/fwrite with FILE* file pointers.
           method = QIO_METHOD_FREADFWRITE;
         } else if( fdflags & QIO_FDFLAG_SEEKABLE ) {
-          if( hints & QIO_HINT_NOREUSE ) method = QIO_METHOD_PREADPWRITE;
+          if( hints & (QIO_HINT_NOREUSE | QIO_HINT_ASYNC) )
+            method = QIO_METHOD_PREADPWRITE;
           else if( hints & QIO_HINT_CACHED ) method = QIO_METHOD_MMAP;
+          // Many channels on one file share an io_uring.
+          else if( (hints & QIO_HINT_PARALLEL) && qio_allow_default_uring() )
+            method = QIO_METHOD_URING;
           else {
             // default case
             if( qio_allow_default_mmap && (!writing) &&
@@ -1083,6 +1192,8 @@ void _qio_file_destroy(qio_file_t* f)
 
   qbytes_release(f->mmap); // Does nothing if null.
 
+  qio_uring_destroy(f->uring); // Does nothing if null.
+
   qbuffer_release(f->buf); // Does nothing if null.
 
   DO_DESTROY_REFCNT(f);
@@ -1434,6 +1545,399 @@ qioerr qio_file_length(qio_file_t* f, int64_t *len_out)
 }
 
 /* CHANNELS ----------------------------- */
+
+/* Asynchronous read-ahead and write-behind (QIO_HINT_ASYNC).
+ *
+ * A channel with an async helper has a pthread that performs its
+ * preads or pwrites, one iobuf-sized request at a time, with up to
+ * qio_async_iobufs requests outstanding in a ring.
+ *
+ * A reading channel keeps the ring full of reads of the iobufs after
+ * the last one it handed to the buffer. _buffered_read_atleast then
+ * appends completed reads to the channel buffer instead of calling
+ * preadv itself. If av_end is not where the read-ahead expected it
+ * (e.g. after an unbuffered read), the ring is drained and restarted.
+ *
+ * A writing channel passes the parts that _qio_buffered_behind would
+ * write to the helper (holding a reference to each qbytes) and only
+ * waits for them when the ring is full or when flushing everything.
+ * A write error is sticky, since the data has left the buffer.
+ *
+ * The helper thread only makes system calls. Allocating and releasing
+ * the qbytes happens on the channel's side with the channel lock held,
+ * and the channel waits for the helper by yielding rather than by
+ * blocking its thread.
+ */
+
+typedef enum {
+  QIO_ASYNC_FREE = 0,
+  QIO_ASYNC_QUEUED,
+  QIO_ASYNC_DONE
+} qio_async_state_t;
+
+typedef struct qio_async_req_s {
+  qbytes_t* bytes;
+  int64_t skip;
+  int64_t len;
+  int64_t offset; // file offset of bytes->data + skip
+  int64_t num; // bytes actually read or written
+  err_t err;
+  qio_async_state_t state; // protected by the lock
+} qio_async_req_t;
+
+typedef struct qio_async_s {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t work;
+  int shutdown; // protected by the lock
+  size_t pending; // requests not yet started; protected by the lock
+  size_t next_service; // next request for the helper; helper only
+
+  int writing;
+  fd_t fd;
+  size_t depth;
+  size_t head; // oldest request not yet reaped
+  size_t count; // requests not yet reaped
+  int64_t next_offset; // reading: where the next read-ahead starts
+  int eof; // reading: a read came up short
+  qioerr write_err; // writing: first write-behind error
+  qio_async_req_t* reqs;
+} qio_async_t;
+
+static inline
+void _qio_async_yield(void)
+{
+#ifdef _chplrt_H_
+  chpl_task_yield();
+#else
+  sched_yield();
+#endif
+}
+
+static
+void _qio_async_do_request(qio_async_t* a, qio_async_req_t* req)
+{
+  char* ptr = (char*) req->bytes->data + req->skip;
+  int64_t done = 0;
+  ssize_t got;
+  err_t err = 0;
+
+  while( done < req->len ) {
+    got = 0;
+    if( a->writing ) {
+      err = sys_pwrite(a->fd, ptr + done, req->len - done,
+                       req->offset + done, &got);
+    } else {
+      err = sys_pread(a->fd, ptr + done, req->len - done,
+                      req->offset + done, &got);
+    }
+    done += got;
+
+    // Ignore interrupted system call, just keep going.
+    if( err == EINTR ) continue;
+    // A short read is how the reader finds the end of the file.
+    if( err == EEOF && ! a->writing ) err = 0;
+    if( err || got == 0 ) break;
+  }
+
+  if( a->writing && ! err && done < req->len ) err = EIO;
+
+  req->num = done;
+  req->err = err;
+}
+
+static
+void* _qio_async_helper(void* arg)
+{
+  qio_async_t* a = (qio_async_t*) arg;
+  qio_async_req_t* req;
+
+  pthread_mutex_lock(&a->lock);
+  while( 1 ) {
+    while( ! a->shutdown && a->pending == 0 ) {
+      pthread_cond_wait(&a->work, &a->lock);
+    }
+    if( a->pending == 0 ) break; // shutdown
+
+    req = &a->reqs[a->next_service];
+    a->next_service = (a->next_service + 1) % a->depth;
+    a->pending--;
+    pthread_mutex_unlock(&a->lock);
+
+    _qio_async_do_request(a, req);
+
+    pthread_mutex_lock(&a->lock);
+    req->state = QIO_ASYNC_DONE;
+  }
+  pthread_mutex_unlock(&a->lock);
+
+  return NULL;
+}
+
+static
+qioerr _qio_async_create(qio_channel_t* ch)
+{
+  qio_async_t* a;
+  int rc;
+
+  a = (qio_async_t*) qio_calloc(1, sizeof(qio_async_t));
+  if( ! a ) return QIO_ENOMEM;
+
+  a->depth = qio_async_iobufs;
+  a->reqs = (qio_async_req_t*) qio_calloc(a->depth, sizeof(qio_async_req_t));
+  if( ! a->reqs ) {
+    qio_free(a);
+    return QIO_ENOMEM;
+  }
+
+  a->writing = (ch->flags & QIO_FDFLAG_WRITEABLE) != 0;
+  a->fd = ch->file->fd;
+  a->next_offset = -1; // the first read starts the read-ahead
+
+  pthread_mutex_init(&a->lock, NULL);
+  pthread_cond_init(&a->work, NULL);
+
+  rc = pthread_create(&a->thread, NULL, _qio_async_helper, a);
+  if( rc ) {
+    pthread_cond_destroy(&a->work);
+    pthread_mutex_destroy(&a->lock);
+    qio_free(a->reqs);
+    qio_free(a);
+    return qio_int_to_err(rc);
+  }
+
+  ch->async = a;
+  return 0;
+}
+
+// Queue a request at the back of the ring; takes over the
+// caller's reference to bytes. The ring must not be full.
+static
+void _qio_async_submit(qio_async_t* a, qbytes_t* bytes, int64_t skip,
+                       int64_t len, int64_t offset)
+{
+  qio_async_req_t* req = &a->reqs[(a->head + a->count) % a->depth];
+
+  req->bytes = bytes;
+  req->skip = skip;
+  req->len = len;
+  req->offset = offset;
+  req->num = 0;
+  req->err = 0;
+  a->count++;
+
+  pthread_mutex_lock(&a->lock);
+  req->state = QIO_ASYNC_QUEUED;
+  a->pending++;
+  pthread_cond_signal(&a->work);
+  pthread_mutex_unlock(&a->lock);
+}
+
+static
+int _qio_async_head_done(qio_async_t* a)
+{
+  int done;
+
+  pthread_mutex_lock(&a->lock);
+  done = (a->reqs[a->head].state == QIO_ASYNC_DONE);
+  pthread_mutex_unlock(&a->lock);
+
+  return done;
+}
+
+// Wait for the oldest request to complete and return it.
+static
+qio_async_req_t* _qio_async_wait_head(qio_async_t* a)
+{
+  while( ! _qio_async_head_done(a) ) _qio_async_yield();
+  return &a->reqs[a->head];
+}
+
+// Remove the oldest (completed) request from the ring.
+static
+void _qio_async_pop_head(qio_async_t* a)
+{
+  qio_async_req_t* req = &a->reqs[a->head];
+
+  if( a->writing && req->err && ! a->write_err ) {
+    a->write_err = qio_int_to_err(req->err);
+  }
+
+  qbytes_release(req->bytes);
+  req->bytes = NULL;
+  req->state = QIO_ASYNC_FREE;
+  a->head = (a->head + 1) % a->depth;
+  a->count--;
+}
+
+static
+void _qio_async_drain(qio_async_t* a)
+{
+  while( a->count > 0 ) {
+    _qio_async_wait_head(a);
+    _qio_async_pop_head(a);
+  }
+}
+
+// Stop the helper after waiting for its requests. Returns the
+// write-behind error, if any, since it is lost with the helper.
+static
+qioerr _qio_async_destroy(qio_channel_t* ch)
+{
+  qio_async_t* a = ch->async;
+  qioerr err;
+
+  if( ! a ) return 0;
+
+  _qio_async_drain(a);
+  err = a->write_err;
+
+  pthread_mutex_lock(&a->lock);
+  a->shutdown = 1;
+  pthread_cond_signal(&a->work);
+  pthread_mutex_unlock(&a->lock);
+
+  pthread_join(a->thread, NULL);
+
+  pthread_cond_destroy(&a->work);
+  pthread_mutex_destroy(&a->lock);
+  qio_free(a->reqs);
+  qio_free(a);
+  ch->async = NULL;
+
+  return err;
+}
+
+// Queue reads until the ring is full or we reach end_pos.
+static
+qioerr _qio_async_read_ahead(qio_channel_t* ch)
+{
+  qio_async_t* a = ch->async;
+  qbytes_t* tmp;
+  int64_t len;
+  qioerr err;
+
+  while( ! a->eof && a->count < a->depth ) {
+    len = qbytes_iobuf_size;
+    if( ch->end_pos < INT64_MAX ) {
+      if( a->next_offset >= ch->end_pos ) break;
+      if( len > ch->end_pos - a->next_offset ) {
+        len = ch->end_pos - a->next_offset;
+      }
+    }
+
+    err = qbytes_create_iobuf(&tmp);
+    if( err ) return err;
+
+    _qio_async_submit(a, tmp, 0, len, a->next_offset);
+    a->next_offset += len;
+  }
+
+  return 0;
+}
+
+// Like _buffered_read_atleast, but takes the data from the read-ahead
+// ring, appending whole completed reads to the end of the buffer.
+static
+qioerr _qio_async_read_atleast(qio_channel_t* ch, int64_t amt)
+{
+  qio_async_t* a = ch->async;
+  qio_async_req_t* req;
+  int64_t expect;
+  int64_t left = amt;
+  qioerr err = 0;
+
+  // Restart the read-ahead if the channel moved somewhere else.
+  expect = (a->count > 0) ? a->reqs[a->head].offset : a->next_offset;
+  if( expect != ch->av_end ) {
+    _qio_async_drain(a);
+    a->next_offset = ch->av_end;
+    a->eof = 0;
+  }
+  // Try again at the end of the file, in case it has grown.
+  if( a->count == 0 ) a->eof = 0;
+
+  while( left > 0 ) {
+    err = _qio_async_read_ahead(ch);
+    if( err ) break;
+
+    if( a->count == 0 ) {
+      // Nothing left before end_pos.
+      err = QIO_EEOF;
+      break;
+    }
+
+    req = _qio_async_wait_head(a);
+    if( req->err ) {
+      err = qio_int_to_err(req->err);
+      _qio_async_pop_head(a);
+      break;
+    }
+
+    if( req->num > 0 ) {
+      // qbuffer_append retains the bytes.
+      err = qbuffer_append(&ch->buf, req->bytes, req->skip, req->num);
+      if( err ) {
+        _qio_async_pop_head(a);
+        break;
+      }
+      ch->av_end += req->num;
+      left -= req->num;
+    }
+
+    if( req->num < req->len ) {
+      // End of file; anything queued after this read found nothing.
+      _qio_async_pop_head(a);
+      _qio_async_drain(a);
+      a->eof = 1;
+      a->next_offset = ch->av_end;
+      if( left > 0 ) err = QIO_EEOF;
+      break;
+    }
+
+    _qio_async_pop_head(a);
+  }
+
+  // Keep reading ahead while the caller consumes what it got.
+  if( ! err ) err = _qio_async_read_ahead(ch);
+
+  return err;
+}
+
+// Hand [*start, end) to the write-behind helper, advancing *start
+// past what was queued. If flushall is set, also wait for every
+// outstanding write.
+static
+qioerr _qio_async_write_behind(qio_channel_t* ch, qbuffer_iter_t* start,
+                               qbuffer_iter_t end, int flushall)
+{
+  qio_async_t* a = ch->async;
+  qbytes_t* bytes;
+  int64_t skip;
+  int64_t len;
+
+  while( ! a->write_err && qbuffer_iter_num_bytes(*start, end) > 0 ) {
+    if( a->count == a->depth ) {
+      // Window is full; wait for the oldest write.
+      _qio_async_wait_head(a);
+      _qio_async_pop_head(a);
+      continue;
+    }
+
+    qbuffer_iter_get(*start, end, &bytes, &skip, &len);
+    qbytes_retain(bytes);
+    _qio_async_submit(a, bytes, skip, len, start->offset);
+    qbuffer_iter_advance(&ch->buf, start, len);
+  }
+
+  // Reap whatever has finished without waiting for the rest.
+  while( a->count > 0 && _qio_async_head_done(a) ) _qio_async_pop_head(a);
+
+  if( flushall ) _qio_async_drain(a);
+
+  return a->write_err;
+}
+
 static
 qioerr _qio_channel_init(qio_channel_t* ch, qio_chtype_t type)
 {
@@ -1634,6 +2138,18 @@ qioerr _qio_channel_init_file(qio_channel_t* ch, qio_file_t* file, qio_hint_t hi
     }
   }
 
+  // Start the read-ahead/write-behind helper if it was requested and
+  // this channel does buffered pread/pwrite in one direction only.
+  // It's just a hint, so if the helper can't start we carry on with
+  // synchronous I/O.
+  if( (ch->hints & QIO_HINT_ASYNC) && qio_async_iobufs > 0 &&
+      (ch->hints & QIO_METHODMASK) == QIO_METHOD_PREADPWRITE &&
+      (ch->hints & QIO_CHTYPEMASK) == QIO_CH_BUFFERED &&
+      file->fd != -1 &&
+      !(ch->flags & QIO_FDFLAG_READABLE) != !(ch->flags & QIO_FDFLAG_WRITEABLE) ) {
+    (void) _qio_async_create(ch);
+  }
+
   //_qio_buffered_setup_cached(ch);
 
   return 0;
@@ -1793,9 +2309,16 @@ qioerr qio_channel_path_offset(const int threadsafe, qio_channel_t* ch, const ch
 
   *offset_out = qio_channel_offset_unlocked(ch);
 
-  err = qio_file_path(ch->file, &tmp);
-  if( !err ) {
-    err = qio_shortest_path(ch->file, string_out, tmp);
+  // A closed channel no longer has a file, e.g. when reporting
+  // an error from closing it.
+  if( ! ch->file ) {
+    *string_out = NULL;
+    QIO_GET_CONSTANT_ERROR(err, EINVAL, "channel is closed");
+  } else {
+    err = qio_file_path(ch->file, &tmp);
+    if( !err ) {
+      err = qio_shortest_path(ch->file, string_out, tmp);
+    }
   }
 
   qio_free((void*) tmp);
@@ -1813,6 +2336,7 @@ qioerr _qio_channel_final_flush_unlocked(qio_channel_t* ch)
   qioerr flush_or_truncate_error = 0;
   qioerr destroy_buffer_error = 0;
   qioerr close_file_error = 0;
+  qioerr async_write_error = 0;
   qio_method_t method = (qio_method_t) (ch->hints & QIO_METHODMASK);
   qio_chtype_t type = (qio_chtype_t) (ch->hints & QIO_CHTYPEMASK);
   struct stat stats;
@@ -1885,6 +2409,11 @@ qioerr _qio_channel_final_flush_unlocked(qio_channel_t* ch)
   // Make a note of any error from flush/truncate so we don't forget it
   flush_or_truncate_error = err;
 
+  // Stop the write-behind helper. If the flush failed before waiting
+  // for every write, one of those may have failed too.
+  async_write_error = _qio_async_destroy(ch);
+  if( ! flush_or_truncate_error ) flush_or_truncate_error = async_write_error;
+
   // set end_pos to the current position.
   ch->end_pos = qio_channel_offset_unlocked(ch);
 
@@ -2306,6 +2835,12 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
   err = _qio_channel_needbuffer_unlocked(ch);
   if( err ) return err;
 
+  // Take data from the read-ahead helper when we have one. It appends
+  // to the end of the buffer, so that has to be where av_end is.
+  if( ch->async && qbuffer_end_offset(&ch->buf) == ch->av_end ) {
+    return _qio_async_read_atleast(ch, amt);
+  }
+
   // do not exceed end_pos.
   max_amt = INT64_MAX;
   if( ch->end_pos < INT64_MAX ) {
@@ -2341,6 +2876,9 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
       case QIO_METHOD_PREADPWRITE:
         err = qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
         break;
+      case QIO_METHOD_URING:
+        err = qio_uring_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
+        break;
       case QIO_METHOD_FREADFWRITE:
         err = qio_freadv(ch->file->fp, &ch->buf, read_start, read_end, &num_read);
         break;
@@ -2549,6 +3087,10 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
   // to update the iterators. This is the common case.
   if( qbuffer_iter_num_bytes(write_start, write_end) == 0 ) {
     err = 0;
+    // Earlier parts may still be with the write-behind helper.
+    if( flushall && ch->async && (ch->flags & QIO_FDFLAG_WRITEABLE) ) {
+      err = _qio_async_write_behind(ch, &write_start, write_end, flushall);
+    }
     goto done;
   }
 
@@ -2560,7 +3102,11 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
     qbuffer_iter_ceil_part(&ch->buf, &write_end);
   }
 
-  if(ch->flags & QIO_FDFLAG_WRITEABLE) {
+  if( (ch->flags & QIO_FDFLAG_WRITEABLE) && ch->async ) {
+    // hand the data to the write-behind helper.
+    err = _qio_async_write_behind(ch, &write_start, write_end, flushall);
+    if( err ) goto error;
+  } else if(ch->flags & QIO_FDFLAG_WRITEABLE) {
     while( qbuffer_iter_num_bytes(write_start, write_end) > 0 ) {
       QIO_GET_CONSTANT_ERROR(err, EINVAL, "write method not implemented");
       num_written = 0;
@@ -2571,6 +3117,9 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
         case QIO_METHOD_PREADPWRITE:
           err = qio_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
           break;
+        case QIO_METHOD_URING:
+          err = qio_uring_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
+          break;
         case QIO_METHOD_FREADFWRITE:
           err = qio_fwritev(ch->file->fp, &ch->buf, write_start, write_end, &num_written);
           break;
@@ -2796,6 +3345,7 @@ qioerr _qio_unbuffered_write(qio_channel_t* ch, const void* ptr, ssize_t len_in,
         case QIO_METHOD_MMAP: // mmap uses pread/pwrite when we're 
                               // outside the mmap'd region.
         case QIO_METHOD_PREADPWRITE:
+        case QIO_METHOD_URING: // one contiguous write; nothing to batch
           err = qio_int_to_err(sys_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written));
           break;
         case QIO_METHOD_FREADFWRITE:
@@ -2870,7 +3420,8 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
   len = len_in;
 
   if( ch->file->mmap &&
-      (method == QIO_METHOD_PREADPWRITE || method == QIO_METHOD_MMAP) &&
+      (method == QIO_METHOD_PREADPWRITE || method == QIO_METHOD_MMAP ||
+       method == QIO_METHOD_URING) &&
       _right_mark_start(ch) + len <= ch->file->mmap->len) {
     // As long as we're using an I/O method that seeks on every read,
     // copy the data out of the mmap.
@@ -2886,6 +3437,7 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
           break;
         case QIO_METHOD_MMAP:
         case QIO_METHOD_PREADPWRITE:
+        case QIO_METHOD_URING: // one contiguous read; nothing to batch
           err = qio_int_to_err(sys_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read));
           break;
         case QIO_METHOD_FREADFWRITE:
@@ -3002,6 +3554,8 @@ int _use_buffered(qio_channel_t* ch, ssize_t len)
   else if (ch->cached_cur) return 1;
   else if (ch->mark_cur > 0) return 1;
   else if (method == QIO_METHOD_MEMORY) return 1;
+  // Keep QIO_HINT_ASYNC channels on the read-ahead/write-behind path.
+  else if (ch->async) return 1;
   // Do not bother initializing the buffer if we are going
   // to read outside of the channel's region.
   else if (offset == ch->end_pos) return 0; 
@@ -0,0 +1,462 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#endif
+
+#include "qio.h"
+#include "sys.h"
+
+#include "qio_uring.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <pthread.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define QIO_HAS_URING 1
+#endif
+#endif
+#endif
+
+// 0 if not yet known, 1 if io_uring works, -1 if it does not.
+static int qio_uring_status = 0;
+
+static inline
+void qio_uring_yield(void)
+{
+#ifdef _chplrt_H_
+  chpl_task_yield();
+#else
+  sched_yield();
+#endif
+}
+
+#ifdef QIO_HAS_URING
+
+// Number of submission queue entries; the kernel makes the
+// completion queue twice as large.
+#define QIO_URING_ENTRIES 64
+
+/* Submitting and reaping
+ *
+ * A task adds its SQE to the ring under the lock and then yields, so
+ * that other tasks reading the same file can add theirs. Whichever
+ * task next gets the lock passes all of the pending SQEs to the
+ * kernel with one io_uring_enter.
+ *
+ * Each SQE's user_data points to a qio_uring_wait_t on the stack of
+ * the task waiting for it. Completions are reaped under the lock by
+ * any task, except while some task (the "poller") is blocked in
+ * io_uring_enter waiting for a completion. Then only the poller
+ * reaps, so that no other task can take the completion it is waiting
+ * for out from under it. Other tasks just yield until the poller
+ * marks their request done.
+ *
+ * We never have more requests submitted or pending than there are
+ * SQEs, so the completion queue can't overflow.
+ */
+
+struct qio_uring_s {
+  int fd;
+  pthread_mutex_t lock;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_mask;
+  unsigned* sq_array;
+  unsigned sq_entries;
+  struct io_uring_sqe* sqes;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_mask;
+  struct io_uring_cqe* cqes;
+
+  void* sq_ptr;
+  size_t sq_len;
+  void* cq_ptr;
+  size_t cq_len;
+  size_t sqes_len;
+
+  // protected by the lock
+  unsigned unsubmitted; // SQEs not yet passed to the kernel
+  unsigned inflight; // submitted SQEs not yet reaped
+  int have_poller;
+};
+
+typedef struct qio_uring_wait_s {
+  int done;
+  int res;
+} qio_uring_wait_t;
+
+static
+int sys_io_uring_setup(unsigned entries, struct io_uring_params* p)
+{
+  return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                       unsigned flags)
+{
+  return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                       flags, NULL, 0);
+}
+
+err_t qio_uring_create(qio_uring_t** ring_out)
+{
+  struct io_uring_params p;
+  qio_uring_t* r;
+  err_t err;
+  char* sq;
+  char* cq;
+  int fd;
+
+  *ring_out = NULL;
+
+  if( qio_uring_status < 0 ) return ENOSYS;
+
+  memset(&p, 0, sizeof(p));
+  fd = sys_io_uring_setup(QIO_URING_ENTRIES, &p);
+  if( fd < 0 ) {
+    err = errno;
+    // Not built into the kernel, or not allowed for this process.
+    if( err == ENOSYS || err == EPERM || err == EACCES ) {
+      qio_uring_status = -1;
+    }
+    return err;
+  }
+
+  r = (qio_uring_t*) qio_calloc(1, sizeof(qio_uring_t));
+  if( ! r ) {
+    close(fd);
+    return ENOMEM;
+  }
+
+  r->fd = fd;
+  r->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  r->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  r->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+
+  r->sq_ptr = mmap(NULL, r->sq_len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  r->cq_ptr = mmap(NULL, r->cq_len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+  r->sqes = (struct io_uring_sqe*)
+            mmap(NULL, r->sqes_len, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+
+  if( r->sq_ptr == MAP_FAILED || r->cq_ptr == MAP_FAILED ||
+      r->sqes == MAP_FAILED ) {
+    err = errno;
+    if( r->sq_ptr != MAP_FAILED ) munmap(r->sq_ptr, r->sq_len);
+    if( r->cq_ptr != MAP_FAILED ) munmap(r->cq_ptr, r->cq_len);
+    if( r->sqes != MAP_FAILED ) munmap(r->sqes, r->sqes_len);
+    close(fd);
+    qio_free(r);
+    return err;
+  }
+
+  sq = (char*) r->sq_ptr;
+  r->sq_head = (unsigned*) (sq + p.sq_off.head);
+  r->sq_tail = (unsigned*) (sq + p.sq_off.tail);
+  r->sq_mask = (unsigned*) (sq + p.sq_off.ring_mask);
+  r->sq_array = (unsigned*) (sq + p.sq_off.array);
+  r->sq_entries = p.sq_entries;
+
+  cq = (char*) r->cq_ptr;
+  r->cq_head = (unsigned*) (cq + p.cq_off.head);
+  r->cq_tail = (unsigned*) (cq + p.cq_off.tail);
+  r->cq_mask = (unsigned*) (cq + p.cq_off.ring_mask);
+  r->cqes = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+
+  pthread_mutex_init(&r->lock, NULL);
+
+  qio_uring_status = 1;
+  *ring_out = r;
+  return 0;
+}
+
+void qio_uring_destroy(qio_uring_t* r)
+{
+  if( ! r ) return;
+
+  pthread_mutex_destroy(&r->lock);
+  munmap(r->sqes, r->sqes_len);
+  munmap(r->cq_ptr, r->cq_len);
+  munmap(r->sq_ptr, r->sq_len);
+  close(r->fd);
+  qio_free(r);
+}
+
+// Complete the pending SQEs with the error err, and take them back
+// out of the submission queue. Called with the lock held.
+static
+void qio_uring_fail_unsubmitted_locked(qio_uring_t* r, int err)
+{
+  unsigned tail = *r->sq_tail;
+  qio_uring_wait_t* w;
+
+  while( r->unsubmitted > 0 ) {
+    tail--;
+    w = (qio_uring_wait_t*) (uintptr_t) r->sqes[tail & *r->sq_mask].user_data;
+    w->res = -err;
+    w->done = 1;
+    r->unsubmitted--;
+  }
+
+  __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+}
+
+// Pass any pending SQEs to the kernel. Called with the lock held.
+static
+void qio_uring_submit_locked(qio_uring_t* r)
+{
+  int got;
+
+  while( r->unsubmitted > 0 ) {
+    got = sys_io_uring_enter(r->fd, r->unsubmitted, 0, 0);
+    if( got < 0 ) {
+      if( errno == EINTR ) continue;
+      // Out of kernel resources for now; try again later.
+      if( errno == EAGAIN || errno == EBUSY ) break;
+      // The kernel took none of them. Their tasks are waiting, so
+      // hand them the error to return.
+      qio_uring_fail_unsubmitted_locked(r, errno);
+      break;
+    }
+    if( got == 0 ) break;
+    r->unsubmitted -= got;
+    r->inflight += got;
+  }
+}
+
+// Record any completions. Called with the lock held and no poller.
+static
+void qio_uring_reap_locked(qio_uring_t* r)
+{
+  unsigned head = *r->cq_head;
+  unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+  struct io_uring_cqe* cqe;
+  qio_uring_wait_t* w;
+
+  while( head != tail ) {
+    cqe = &r->cqes[head & *r->cq_mask];
+    w = (qio_uring_wait_t*) (uintptr_t) cqe->user_data;
+    w->res = cqe->res;
+    w->done = 1;
+    head++;
+    r->inflight--;
+  }
+
+  __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+}
+
+static
+void qio_uring_progress_locked(qio_uring_t* r)
+{
+  qio_uring_submit_locked(r);
+  if( ! r->have_poller ) qio_uring_reap_locked(r);
+}
+
+// Submit one readv or writev and wait for it. Returns the
+// CQE result: bytes transferred, or a negated errno.
+static
+int qio_uring_rw(qio_uring_t* r, int opcode, fd_t fd,
+                 const struct iovec* iov, int iovcnt, off_t offset)
+{
+  qio_uring_wait_t w;
+  struct io_uring_sqe* sqe;
+  unsigned tail;
+  unsigned idx;
+
+  w.done = 0;
+  w.res = 0;
+
+  pthread_mutex_lock(&r->lock);
+
+  // Wait for a free SQE.
+  while( r->unsubmitted + r->inflight >= r->sq_entries ) {
+    qio_uring_progress_locked(r);
+    if( r->unsubmitted + r->inflight < r->sq_entries ) break;
+    pthread_mutex_unlock(&r->lock);
+    qio_uring_yield();
+    pthread_mutex_lock(&r->lock);
+  }
+
+  tail = *r->sq_tail;
+  idx = tail & *r->sq_mask;
+  sqe = &r->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = (uint64_t) (uintptr_t) iov;
+  sqe->len = iovcnt;
+  sqe->off = offset;
+  sqe->user_data = (uint64_t) (uintptr_t) &w;
+  r->sq_array[idx] = idx;
+  __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  r->unsubmitted++;
+
+  pthread_mutex_unlock(&r->lock);
+
+  // Let other tasks add to this batch before it is submitted.
+  qio_uring_yield();
+
+  pthread_mutex_lock(&r->lock);
+  while( 1 ) {
+    qio_uring_progress_locked(r);
+    if( w.done ) break;
+
+    if( ! r->have_poller && r->inflight > 0 ) {
+      // Wait in the kernel. Our request (or another one that was
+      // submitted before it) is in flight, so a completion will come.
+      r->have_poller = 1;
+      pthread_mutex_unlock(&r->lock);
+      sys_io_uring_enter(r->fd, 0, 1, IORING_ENTER_GETEVENTS);
+      pthread_mutex_lock(&r->lock);
+      r->have_poller = 0;
+    } else {
+      pthread_mutex_unlock(&r->lock);
+      qio_uring_yield();
+      pthread_mutex_lock(&r->lock);
+    }
+  }
+  pthread_mutex_unlock(&r->lock);
+
+  return w.res;
+}
+
+static
+err_t sys_uring_rwv(qio_uring_t* r, int opcode, fd_t fd,
+                    const struct iovec* iov, int iovcnt, off_t seek_to_offset,
+                    ssize_t* num_out)
+{
+  int got;
+  ssize_t got_total;
+  err_t err_out;
+  int i;
+  int niovs = IOV_MAX;
+
+  STARTING_SLOW_SYSCALL;
+
+  err_out = 0;
+  got_total = 0;
+  for( i = 0; i < iovcnt; i += niovs ) {
+    niovs = iovcnt - i;
+    if( niovs > IOV_MAX ) niovs = IOV_MAX;
+
+    got = qio_uring_rw(r, opcode, fd, &iov[i], niovs,
+                       seek_to_offset + got_total);
+    if( got >= 0 ) {
+      got_total += got;
+    } else {
+      err_out = -got;
+      break;
+    }
+    if( got != sys_iov_total_bytes(&iov[i], niovs) ) {
+      break;
+    }
+  }
+
+  *num_out = got_total;
+
+  DONE_SLOW_SYSCALL;
+
+  return err_out;
+}
+
+int qio_uring_supported(void)
+{
+  qio_uring_t* r;
+
+  if( qio_uring_status == 0 ) {
+    if( qio_uring_create(&r) == 0 ) qio_uring_destroy(r);
+    else qio_uring_status = -1;
+  }
+
+  return qio_uring_status > 0;
+}
+
+err_t sys_uring_preadv(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out)
+{
+  err_t err;
+
+  if( ! ring ) return sys_preadv(fd, iov, iovcnt, seek_to_offset, num_read_out);
+
+  err = sys_uring_rwv(ring, IORING_OP_READV, fd, iov, iovcnt, seek_to_offset,
+                      num_read_out);
+  if( err == 0 && *num_read_out == 0 &&
+      sys_iov_total_bytes(iov, iovcnt) != 0 ) err = EEOF;
+
+  return err;
+}
+
+err_t sys_uring_pwritev(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out)
+{
+  if( ! ring ) return sys_pwritev(fd, iov, iovcnt, seek_to_offset, num_written_out);
+
+  return sys_uring_rwv(ring, IORING_OP_WRITEV, fd, iov, iovcnt,
+                       seek_to_offset, num_written_out);
+}
+
+#else
+
+// No io_uring here; everything goes through preadv/pwritev.
+
+int qio_uring_supported(void)
+{
+  qio_uring_status = -1;
+  return 0;
+}
+
+err_t qio_uring_create(qio_uring_t** ring_out)
+{
+  *ring_out = NULL;
+  return ENOSYS;
+}
+
+void qio_uring_destroy(qio_uring_t* ring)
+{
+}
+
+err_t sys_uring_preadv(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out)
+{
+  return sys_preadv(fd, iov, iovcnt, seek_to_offset, num_read_out);
+}
+
+err_t sys_uring_pwritev(qio_uring_t* ring, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out)
+{
+  return sys_pwritev(fd, iov, iovcnt, seek_to_offset, num_written_out);
+}
+
+#endif
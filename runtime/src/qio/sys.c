@@ -969,10 +969,9 @@ err_t sys_pread(int fd, void* buf, size_t count, off_t offset, ssize_t* num_read
   STARTING_SLOW_SYSCALL;
   got = 0;
   err_out = do_pread(fd, buf, count, offset, &got);
-  if( got != -1 ) {
+  if( ! err_out ) {
     *num_read_out = got;
     if( got == 0 && count != 0 ) err_out = EEOF;
-    else err_out = 0;
   } else {
     *num_read_out = 0;
   }
@@ -989,9 +988,8 @@ err_t sys_pwrite(int fd, const void* buf, size_t count, off_t offset, ssize_t* n
   STARTING_SLOW_SYSCALL;
   got = 0;
   err_out = do_pwrite(fd, buf, count, offset, &got);
-  if( got != -1 ) {
+  if( ! err_out ) {
     *num_written_out = got;
-    err_out = 0;
   } else {
     *num_written_out = 0;
   }
@@ -24,7 +24,9 @@
 #include "chplrt.h"
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-env.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
 #include "chpl-mem.h"
@@ -61,6 +63,9 @@ typedef struct task_pool_struct {
   task_pool_p      next;         // double-link pointers for pool
   task_pool_p      prev;
 
+  atomic_bool          ws_claimed;  // work stealing: task has been taken
+  atomic_int_least32_t ws_refs;     // work stealing: deque/list references
+
   chpl_task_prvDataImpl_t chpl_data;
 
   chpl_task_bundle_t bundle; // ends in a variable-length array
@@ -76,10 +81,81 @@ typedef struct lockReport {
 } lockReport_t;
 
 
+//
+// Work-stealing task pool.
+//
+// By default all tasks go through the single global task pool above,
+// which is protected by threading_lock.  If CHPL_RT_FIFO_WORK_STEALING
+// is set, that pool is replaced by one Chase-Lev deque per worker
+// thread.  A worker pushes and pops tasks at the bottom of its own
+// deque without locking, and when that is empty it steals from the top
+// of the deques of randomly chosen victims.  Tasks created on threads
+// that are not workers (the main thread, comm layer threads) go into a
+// small shared injection queue.  Workers that find no work anywhere
+// park on a condition variable until more arrives.
+//
+// A task added to a task list is reachable both through a deque and
+// through the list that chpl_task_executeTasksInList() walks.  Whoever
+// first sets its ws_claimed flag runs it, and whichever of the two
+// references is dropped last frees it.
+//
+// Deadlock detection and task reporting need to see every pending task,
+// so work stealing is not used with --blockreport or --taskreport.
+//
+#define CACHE_LINE_SIZE 64
+#define CACHE_LINE_ALIGN __attribute__((aligned(CACHE_LINE_SIZE)))
+
+typedef struct ws_deque_buf_struct {
+  int64_t                     size;     // slot count, a power of 2
+  struct ws_deque_buf_struct* retired;  // earlier, smaller buffers
+  atomic_uintptr_t            slots[];
+} ws_deque_buf_t;
+
+typedef struct {
+  atomic_int_least64_t top CACHE_LINE_ALIGN;
+  atomic_int_least64_t bottom CACHE_LINE_ALIGN;
+  atomic_uintptr_t     buf;
+} ws_deque_t;
+
+#define WS_DEQUE_INIT_SIZE  64
+
+//
+// With an unbounded thread count we still need a fixed-size deque
+// table.  Threads beyond this many share the injection queue instead.
+//
+#define WS_MAX_DEQUES_UNBOUNDED 1024
+
+//
+// How many fruitless rounds of stealing an idle worker makes before it
+// parks, and how long it stays parked before looking again.  Parking
+// is bounded so that idle workers still reach a cancellation point
+// when the program exits.
+//
+#define WS_STEAL_ROUNDS     64
+#define WS_PARK_USEC        10000
+
+static chpl_bool            ws_enabled = false;
+static ws_deque_t*          ws_deques;          // one per worker thread
+static int32_t              ws_max_deques;
+static atomic_int_least32_t ws_num_deques;      // deques handed out
+static chpl_thread_mutex_t  ws_inject_lock;     // protects injection queue
+static volatile task_pool_p ws_inject_head;
+static task_pool_p          ws_inject_tail;
+static atomic_int_least64_t ws_queued_task_cnt; // unclaimed tasks
+static atomic_int_least64_t ws_idle_thread_cnt; // workers without a task
+static chpl_thread_mutex_t  ws_park_lock;
+static chpl_thread_condvar_t ws_park_cond;
+static atomic_int_least32_t ws_parked_cnt;      // workers waiting on cond
+static chpl_thread_mutex_t  ws_thread_lock;     // serializes thread creation
+static atomic_bool          ws_can_add_thread;
+
+
 // This is the data that is private to each thread.
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  ws_deque_t*   ws_deque;    // work stealing: our deque, if a worker
+  uint64_t      ws_rand;     // work stealing: victim selection state
 } thread_private_data_t;
 
 
@@ -87,7 +163,6 @@ static chpl_bool        initialized = false;
 
 static chpl_thread_mutex_t threading_lock;     // critical section lock
 static chpl_thread_mutex_t extra_task_lock;    // critical section lock
-static chpl_thread_mutex_t task_id_lock;       // critical section lock
 static chpl_thread_mutex_t task_list_lock;     // critical section lock
 static volatile task_pool_p
                            task_pool_head;     // head of task pool
@@ -108,6 +183,8 @@ static chpl_thread_mutex_t block_report_lock;   // critical section lock
 static lockReport_t* lockReportHead = NULL;
 static lockReport_t* lockReportTail = NULL;
 
+static atomic_uint_least64_t next_task_id;
+
 static chpl_bool do_taskReport = false;
 static chpl_thread_mutex_t taskTable_lock;     // critical section lock
 
@@ -141,6 +218,10 @@ static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, task_pool_p*,
                                                 chpl_bool, int, int32_t);
+static void                    ws_init(void);
+static void                    ws_enqueue_task(task_pool_p, task_pool_p*);
+static void                    ws_execute_tasks_in_list(task_pool_p*);
+static void                    ws_thread_loop(thread_private_data_t*);
 
 //
 // Condition variable methods
@@ -331,8 +412,8 @@ static void setup_main_thread_private_data(void)
 void chpl_task_init(void) {
   chpl_thread_mutexInit(&threading_lock);
   chpl_thread_mutexInit(&extra_task_lock);
-  chpl_thread_mutexInit(&task_id_lock);
   chpl_thread_mutexInit(&task_list_lock);
+  atomic_init_uint_least64_t(&next_task_id, chpl_nullTaskID + 1);
   queued_task_cnt = 0;
   blocked_thread_cnt = 0;
   idle_thread_cnt = 0;
@@ -341,6 +422,15 @@ void chpl_task_init(void) {
 
   chpl_thread_init(thread_begin, thread_end);
 
+  //
+  // Work stealing is opt-in, and is not compatible with the reporting
+  // modes that walk the global task pool.
+  //
+  ws_enabled = (chpl_env_rt_get_bool("FIFO_WORK_STEALING", false)
+                && !blockreport && !taskreport);
+  if (ws_enabled)
+    ws_init();
+
   //
   // Set main thread private data, so that things that require access
   // to it, like chpl_task_getID() and chpl_task_setSerial(), can be
@@ -595,6 +685,16 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
                              int32_t filename) {
   assert(subloc == c_sublocid_any);
 
+  if (ws_enabled) {
+    (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
+                            false,
+                            (task_list_locale == chpl_nodeID)
+                            ? (task_pool_p*) p_task_list_void
+                            : NULL,
+                            is_begin_stmt, lineno, filename);
+    return;
+  }
+
   // begin critical section
   chpl_thread_mutexLock(&threading_lock);
 
@@ -628,6 +728,11 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   // Note: this function needs to tolerate an empty task
   // list. That will happen for coforalls inside a serial block, say.
 
+  if (ws_enabled) {
+    ws_execute_tasks_in_list(p_task_list_head);
+    return;
+  }
+
   curr_ptask = get_current_ptask();
 
   while (*p_task_list_head != NULL) {
@@ -718,6 +823,12 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   chpl_task_bundle_t* arg, size_t arg_size,
                   c_sublocid_t subloc,
                   int lineno, int32_t filename) {
+  if (ws_enabled) {
+    (void) add_to_task_pool(fid, fp, arg, arg_size, true,
+                            NULL, false, lineno, filename);
+    return;
+  }
+
   // begin critical section
   chpl_thread_mutexLock(&threading_lock);
 
@@ -847,6 +958,8 @@ size_t chpl_task_getCallStackSize(void) {
 }
 
 uint32_t chpl_task_getNumQueuedTasks(void) {
+  if (ws_enabled)
+    return (uint32_t) atomic_load_int_least64_t(&ws_queued_task_cnt);
   return queued_task_cnt;
 }
 
@@ -878,15 +991,7 @@ int32_t chpl_task_getNumBlockedTasks(void) {
 // Get a new task ID.
 //
 static chpl_taskID_t get_next_task_id(void) {
-  static chpl_taskID_t       id = chpl_nullTaskID + 1;
-
-  chpl_taskID_t              next_id;
-
-  chpl_thread_mutexLock(&task_id_lock);
-  next_id = id++;
-  chpl_thread_mutexUnlock(&task_id_lock);
-
-  return next_id;
+  return (chpl_taskID_t) atomic_fetch_add_uint_least64_t(&next_task_id, 1);
 }
 
 
@@ -1125,9 +1230,16 @@ thread_begin(void* ptask_void) {
 
   tp->ptask = NULL;
   tp->lockRprt = NULL;
+  tp->ws_deque = NULL;
+  tp->ws_rand = 0;
   if (blockreport)
     initializeLockReportForThread();
 
+  if (ws_enabled) {
+    ws_thread_loop(tp);
+    return;
+  }
+
   while (true) {
     //
     // wait for a task to be present in the task pool
@@ -1274,7 +1386,10 @@ static void maybe_add_thread(void) {
 
   if (!warning_issued && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      if (ws_enabled)
+        (void) atomic_fetch_add_int_least64_t(&ws_idle_thread_cnt, 1);
+      else
+        idle_thread_cnt++;
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1299,7 +1414,8 @@ static void maybe_add_thread(void) {
 
 // create a task from the given function pointer and arguments
 // and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// assumes threading_lock has already been acquired, unless we are
+// work stealing!
 static inline
 task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                              chpl_task_bundle_t* a, size_t a_size,
@@ -1338,7 +1454,8 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->bundle.requested_fn    = fp;
   ptask->bundle.id              = get_next_task_id();
 
-  enqueue_task(ptask, p_task_list_head);
+  if (!ws_enabled)
+    enqueue_task(ptask, p_task_list_head);
 
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->bundle.requested_fid,
@@ -1355,6 +1472,15 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
 
+  //
+  // With work stealing, another thread may run and free the task as
+  // soon as it is published, so that has to come last.
+  //
+  if (ws_enabled) {
+    ws_enqueue_task(ptask, p_task_list_head);
+    return NULL;
+  }
+
   // If we now have more tasks than threads to run them on, try to start
   // another thread
   if (queued_task_cnt > idle_thread_cnt) {
@@ -1365,6 +1491,476 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
 }
 
 
+// Work-stealing task pool
+
+static ws_deque_buf_t* ws_deque_buf_alloc(int64_t size) {
+  ws_deque_buf_t* a;
+  int64_t i;
+
+  a = (ws_deque_buf_t*) chpl_mem_alloc(sizeof(ws_deque_buf_t)
+                                       + size * sizeof(atomic_uintptr_t),
+                                       CHPL_RT_MD_TASK_LAYER_UNSPEC, 0, 0);
+  a->size = size;
+  a->retired = NULL;
+  for (i = 0; i < size; i++)
+    atomic_init_uintptr_t(&a->slots[i], (uintptr_t) NULL);
+  return a;
+}
+
+
+//
+// Push a task onto the bottom of a deque.  Only the owner may do this.
+//
+static void ws_deque_push(ws_deque_t* d, task_pool_p ptask) {
+  int64_t b = atomic_load_explicit_int_least64_t(&d->bottom,
+                                                 memory_order_relaxed);
+  int64_t t = atomic_load_explicit_int_least64_t(&d->top,
+                                                 memory_order_acquire);
+  ws_deque_buf_t* a =
+    (ws_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                     memory_order_relaxed);
+
+  if (b - t > a->size - 1) {
+    //
+    // Full.  Copy into a buffer twice the size.  Thieves may still be
+    // reading the old one, so hang onto it rather than freeing it.
+    //
+    ws_deque_buf_t* na = ws_deque_buf_alloc(2 * a->size);
+    int64_t i;
+
+    for (i = t; i < b; i++) {
+      uintptr_t v =
+        atomic_load_explicit_uintptr_t(&a->slots[i & (a->size - 1)],
+                                       memory_order_relaxed);
+      atomic_store_explicit_uintptr_t(&na->slots[i & (na->size - 1)], v,
+                                      memory_order_relaxed);
+    }
+    na->retired = a;
+    atomic_store_explicit_uintptr_t(&d->buf, (uintptr_t) na,
+                                    memory_order_release);
+    a = na;
+  }
+
+  atomic_store_explicit_uintptr_t(&a->slots[b & (a->size - 1)],
+                                  (uintptr_t) ptask, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_release);
+  atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                      memory_order_relaxed);
+}
+
+
+//
+// Pop a task from the bottom of a deque.  Only the owner may do this.
+//
+static task_pool_p ws_deque_pop(ws_deque_t* d) {
+  int64_t b = atomic_load_explicit_int_least64_t(&d->bottom,
+                                                 memory_order_relaxed) - 1;
+  ws_deque_buf_t* a =
+    (ws_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                     memory_order_relaxed);
+  task_pool_p ptask = NULL;
+  int64_t t;
+
+  atomic_store_explicit_int_least64_t(&d->bottom, b, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  t = atomic_load_explicit_int_least64_t(&d->top, memory_order_relaxed);
+
+  if (t <= b) {
+    ptask = (task_pool_p)
+            atomic_load_explicit_uintptr_t(&a->slots[b & (a->size - 1)],
+                                           memory_order_relaxed);
+    if (t == b) {
+      // Last entry; thieves may be racing us for it.
+      if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+             &d->top, t, t + 1, memory_order_seq_cst))
+        ptask = NULL;
+      atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                          memory_order_relaxed);
+    }
+  }
+  else {
+    atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                        memory_order_relaxed);
+  }
+
+  return ptask;
+}
+
+
+//
+// Steal a task from the top of a deque.  Returns NULL if the deque was
+// empty or another thread beat us to the task.
+//
+static task_pool_p ws_deque_steal(ws_deque_t* d) {
+  int64_t t = atomic_load_explicit_int_least64_t(&d->top,
+                                                 memory_order_acquire);
+  int64_t b;
+
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  b = atomic_load_explicit_int_least64_t(&d->bottom, memory_order_acquire);
+
+  if (t < b) {
+    ws_deque_buf_t* a =
+      (ws_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                       memory_order_acquire);
+    task_pool_p ptask = (task_pool_p)
+      atomic_load_explicit_uintptr_t(&a->slots[t & (a->size - 1)],
+                                     memory_order_relaxed);
+    if (atomic_compare_exchange_strong_explicit_int_least64_t(
+          &d->top, t, t + 1, memory_order_seq_cst))
+      return ptask;
+  }
+
+  return NULL;
+}
+
+
+static inline
+chpl_bool ws_deque_maybe_nonempty(ws_deque_t* d) {
+  return (atomic_load_int_least64_t(&d->bottom)
+          > atomic_load_int_least64_t(&d->top));
+}
+
+
+static inline
+int32_t ws_num_active_deques(void) {
+  int32_t n = atomic_load_int_least32_t(&ws_num_deques);
+  return (n < ws_max_deques) ? n : ws_max_deques;
+}
+
+
+static void ws_init(void) {
+  uint32_t max_threads = chpl_thread_getMaxThreads();
+  int32_t i;
+
+  ws_max_deques = (max_threads > 0)
+                  ? (int32_t) max_threads
+                  : WS_MAX_DEQUES_UNBOUNDED;
+  ws_deques = (ws_deque_t*) chpl_mem_memalign(CACHE_LINE_SIZE,
+                                              ws_max_deques
+                                              * sizeof(ws_deque_t),
+                                              CHPL_RT_MD_TASK_LAYER_UNSPEC,
+                                              0, 0);
+  for (i = 0; i < ws_max_deques; i++) {
+    atomic_init_int_least64_t(&ws_deques[i].top, 0);
+    atomic_init_int_least64_t(&ws_deques[i].bottom, 0);
+    atomic_init_uintptr_t(&ws_deques[i].buf, (uintptr_t) NULL);
+  }
+  atomic_init_int_least32_t(&ws_num_deques, 0);
+
+  chpl_thread_mutexInit(&ws_inject_lock);
+  ws_inject_head = ws_inject_tail = NULL;
+
+  atomic_init_int_least64_t(&ws_queued_task_cnt, 0);
+  atomic_init_int_least64_t(&ws_idle_thread_cnt, 0);
+
+  chpl_thread_mutexInit(&ws_park_lock);
+  chpl_thread_condvar_init(&ws_park_cond);
+  atomic_init_int_least32_t(&ws_parked_cnt, 0);
+
+  chpl_thread_mutexInit(&ws_thread_lock);
+  atomic_init_bool(&ws_can_add_thread, true);
+}
+
+
+//
+// Give the calling worker thread a deque of its own, if any are left.
+//
+static void ws_register_worker(thread_private_data_t* tp) {
+  int32_t idx = atomic_fetch_add_int_least32_t(&ws_num_deques, 1);
+
+  tp->ws_rand = ((uint64_t) idx + 1) * UINT64_C(0x9e3779b97f4a7c15);
+
+  if (idx < ws_max_deques) {
+    ws_deque_t* d = &ws_deques[idx];
+    atomic_store_explicit_uintptr_t(&d->buf,
+                                    (uintptr_t)
+                                    ws_deque_buf_alloc(WS_DEQUE_INIT_SIZE),
+                                    memory_order_release);
+    tp->ws_deque = d;
+  }
+}
+
+
+static inline
+uint64_t ws_next_rand(thread_private_data_t* tp) {
+  uint64_t x = tp->ws_rand;
+
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return (tp->ws_rand = x);
+}
+
+
+//
+// Take ownership of a task we found in a deque, the injection queue, or
+// a task list.  Only the first taker wins.
+//
+static inline
+chpl_bool ws_claim(task_pool_p ptask) {
+  if (atomic_exchange_bool(&ptask->ws_claimed, true))
+    return false;
+  (void) atomic_fetch_sub_int_least64_t(&ws_queued_task_cnt, 1);
+  return true;
+}
+
+
+//
+// Drop one reference to a task, freeing it if that was the last.
+//
+static inline
+void ws_release(task_pool_p ptask) {
+  if (atomic_fetch_sub_int_least32_t(&ptask->ws_refs, 1) == 1) {
+    atomic_destroy_bool(&ptask->ws_claimed);
+    atomic_destroy_int_least32_t(&ptask->ws_refs);
+    chpl_mem_free(ptask, 0, 0);
+  }
+}
+
+
+static chpl_bool ws_work_available(void) {
+  int32_t n = ws_num_active_deques();
+  int32_t i;
+
+  if (ws_inject_head != NULL)
+    return true;
+  for (i = 0; i < n; i++) {
+    if (ws_deque_maybe_nonempty(&ws_deques[i]))
+      return true;
+  }
+  return false;
+}
+
+
+//
+// Wake a parked worker if there is one, and add a thread if we now
+// have more unclaimed tasks than idle threads to run them.
+//
+static void ws_notify_new_task(void) {
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+
+  if (atomic_load_int_least32_t(&ws_parked_cnt) > 0) {
+    chpl_thread_mutexLock(&ws_park_lock);
+    if (pthread_cond_signal(&ws_park_cond))
+      chpl_internal_error("pthread_cond_signal() failed");
+    chpl_thread_mutexUnlock(&ws_park_lock);
+  }
+
+  if (atomic_load_bool(&ws_can_add_thread)
+      && (atomic_load_int_least64_t(&ws_queued_task_cnt)
+          > atomic_load_int_least64_t(&ws_idle_thread_cnt))) {
+    chpl_thread_mutexLock(&ws_thread_lock);
+    maybe_add_thread();
+    if (!chpl_thread_canCreate())
+      atomic_store_bool(&ws_can_add_thread, false);
+    chpl_thread_mutexUnlock(&ws_thread_lock);
+  }
+}
+
+
+static void ws_enqueue_task(task_pool_p ptask,
+                            task_pool_p* p_task_list_head) {
+  thread_private_data_t* tp;
+
+  atomic_init_bool(&ptask->ws_claimed, false);
+  atomic_init_int_least32_t(&ptask->ws_refs,
+                            (p_task_list_head == NULL) ? 1 : 2);
+
+  //
+  // The task list belongs to the task creating these tasks, so it can
+  // be updated without locking.
+  //
+  if (p_task_list_head != NULL) {
+    ptask->list_next = *p_task_list_head;
+    *p_task_list_head = ptask;
+  }
+
+  (void) atomic_fetch_add_int_least64_t(&ws_queued_task_cnt, 1);
+
+  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
+  if (tp != NULL && tp->ws_deque != NULL) {
+    ws_deque_push(tp->ws_deque, ptask);
+  }
+  else {
+    chpl_thread_mutexLock(&ws_inject_lock);
+    if (ws_inject_tail)
+      ws_inject_tail->next = ptask;
+    else
+      ws_inject_head = ptask;
+    ws_inject_tail = ptask;
+    chpl_thread_mutexUnlock(&ws_inject_lock);
+  }
+
+  ws_notify_new_task();
+}
+
+
+static task_pool_p ws_take_injected(void) {
+  task_pool_p ptask = NULL;
+
+  if (ws_inject_head == NULL)
+    return NULL;
+
+  chpl_thread_mutexLock(&ws_inject_lock);
+  while (ptask == NULL && ws_inject_head != NULL) {
+    ptask = ws_inject_head;
+    if ((ws_inject_head = ptask->next) == NULL)
+      ws_inject_tail = NULL;
+    ptask->next = NULL;
+    if (!ws_claim(ptask)) {
+      ws_release(ptask);
+      ptask = NULL;
+    }
+  }
+  chpl_thread_mutexUnlock(&ws_inject_lock);
+
+  return ptask;
+}
+
+
+//
+// Find a task for a worker to run: first from its own deque, newest
+// first, then from the injection queue, then by stealing the oldest
+// task of some other worker.
+//
+static task_pool_p ws_find_task(thread_private_data_t* tp) {
+  task_pool_p ptask;
+  int32_t n;
+  int32_t i;
+
+  if (tp->ws_deque != NULL) {
+    while ((ptask = ws_deque_pop(tp->ws_deque)) != NULL) {
+      if (ws_claim(ptask))
+        return ptask;
+      ws_release(ptask);
+    }
+  }
+
+  if ((ptask = ws_take_injected()) != NULL)
+    return ptask;
+
+  if ((n = ws_num_active_deques()) == 0)
+    return NULL;
+
+  for (i = 0; i < 2 * n; i++) {
+    ws_deque_t* victim = &ws_deques[ws_next_rand(tp) % n];
+    if (victim == tp->ws_deque)
+      continue;
+    while ((ptask = ws_deque_steal(victim)) != NULL) {
+      if (ws_claim(ptask))
+        return ptask;
+      ws_release(ptask);
+    }
+  }
+
+  return NULL;
+}
+
+
+//
+// Wait until more work may be available, or a little while passes.
+//
+static void ws_park(void) {
+  chpl_thread_mutexLock(&ws_park_lock);
+  (void) atomic_fetch_add_int_least32_t(&ws_parked_cnt, 1);
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+
+  if (!ws_work_available()) {
+    struct timeval now;
+    struct timespec ts;
+
+    gettimeofday(&now, NULL);
+    ts.tv_sec  = now.tv_sec;
+    ts.tv_nsec = (now.tv_usec + WS_PARK_USEC) * 1000UL;
+    if (ts.tv_nsec >= 1000000000L) {
+      ts.tv_sec  += ts.tv_nsec / 1000000000L;
+      ts.tv_nsec %= 1000000000L;
+    }
+    (void) pthread_cond_timedwait(&ws_park_cond,
+                                  (pthread_mutex_t*) &ws_park_lock, &ts);
+  }
+
+  (void) atomic_fetch_sub_int_least32_t(&ws_parked_cnt, 1);
+  chpl_thread_mutexUnlock(&ws_park_lock);
+}
+
+
+static void ws_run_task(task_pool_p ptask) {
+  chpl_task_do_callbacks(chpl_task_cb_event_kind_begin,
+                         ptask->bundle.requested_fid,
+                         ptask->bundle.filename,
+                         ptask->bundle.lineno,
+                         ptask->bundle.id,
+                         ptask->bundle.is_executeOn);
+
+  (ptask->bundle.requested_fn)(&ptask->bundle);
+
+  chpl_task_do_callbacks(chpl_task_cb_event_kind_end,
+                         ptask->bundle.requested_fid,
+                         ptask->bundle.filename,
+                         ptask->bundle.lineno,
+                         ptask->bundle.id,
+                         ptask->bundle.is_executeOn);
+}
+
+
+//
+// The body of a worker thread when work stealing.  Idle workers spin
+// (yielding, which is also where they can be cancelled at exit) for a
+// while before parking.
+//
+static void ws_thread_loop(thread_private_data_t* tp) {
+  ws_register_worker(tp);
+
+  while (true) {
+    task_pool_p ptask;
+    int rounds = 0;
+
+    while ((ptask = ws_find_task(tp)) == NULL) {
+      if (++rounds < WS_STEAL_ROUNDS) {
+        chpl_thread_yield();
+      }
+      else {
+        ws_park();
+        chpl_thread_yield();
+        rounds = 0;
+      }
+    }
+
+    (void) atomic_fetch_sub_int_least64_t(&ws_idle_thread_cnt, 1);
+
+    tp->ptask = ptask;
+    ws_run_task(ptask);
+    tp->ptask = NULL;
+    ws_release(ptask);
+
+    (void) atomic_fetch_add_int_least64_t(&ws_idle_thread_cnt, 1);
+  }
+}
+
+
+//
+// Run any tasks in the list that no worker has taken yet.  Ones that
+// have been taken will be waited for by the caller, as usual.
+//
+static void ws_execute_tasks_in_list(task_pool_p* p_task_list_head) {
+  task_pool_p curr_ptask = get_current_ptask();
+  task_pool_p child_ptask;
+
+  while ((child_ptask = *p_task_list_head) != NULL) {
+    *p_task_list_head = child_ptask->list_next;
+
+    if (ws_claim(child_ptask)) {
+      set_current_ptask(child_ptask);
+      ws_run_task(child_ptask);
+      set_current_ptask(curr_ptask);
+    }
+
+    ws_release(child_ptask);
+  }
+}
+
 // Threads
 
 uint32_t chpl_task_getNumThreads(void) {
@@ -1372,5 +1968,7 @@ uint32_t chpl_task_getNumThreads(void) {
 }
 
 uint32_t chpl_task_getNumIdleThreads(void) {
+  if (ws_enabled)
+    return (uint32_t) atomic_load_int_least64_t(&ws_idle_thread_cnt);
   return idle_thread_cnt;
 }
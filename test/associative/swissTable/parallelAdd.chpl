@@ -0,0 +1,36 @@
+// Insert-heavy parallel workload for default associative domains: every
+// task adds a disjoint slice of pseudo-random keys to one parSafe domain,
+// then the keys are looked up again.  Compare the default table layout
+// against -sdefaultAssocSwissTable=true.
+
+use Time;
+
+config const n = 100000;
+config const printTimings = false;
+
+// keys spread over the whole int range, but distinct for distinct i
+inline proc key(i: int) return (i * 0x9E3779B97F4A7C15:int) ^ (i >> 7);
+
+var D: domain(int);
+var t: Timer;
+
+t.start();
+forall i in 1..n with (ref D) do
+  D += key(i);
+t.stop();
+const addTime = t.elapsed();
+
+t.clear();
+t.start();
+var found = 0;
+forall i in 1..2*n with (+ reduce found) do
+  if D.contains(key(i)) then found += 1;
+t.stop();
+const lookupTime = t.elapsed();
+
+const ok = D.size == n && found == n;
+writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
+if printTimings {
+  writeln("add time: ", addTime);
+  writeln("lookup time: ", lookupTime);
+}
@@ -0,0 +1,85 @@
+// Exercise the associative domain operations that touch the hash table
+// layout: adds that grow the table, removes that shrink it, lookups,
+// arrays over the domain, capacity requests, and clearing.
+
+config const n = 10000;
+
+proc check(cond: bool, msg: string) {
+  if !cond then writeln("FAILED: ", msg);
+}
+
+// serial adds and removes, with an array that must keep its values
+// across resizes
+{
+  var D: domain(int, parSafe=false);
+  var A: [D] int;
+  for i in 1..n {
+    D += i*7;
+    A[i*7] = i;
+  }
+  check(D.size == n, "serial add size");
+  var ok = true;
+  for i in 1..n do
+    if !D.contains(i*7) || A[i*7] != i then ok = false;
+  check(ok, "serial add lookup");
+  check(!D.contains(3), "absent index");
+
+  for i in 1..n by 2 do D -= i*7;
+  check(D.size == n/2, "remove size");
+  ok = true;
+  for i in 1..n do
+    if D.contains(i*7) != (i % 2 == 0) then ok = false;
+  for i in 2..n by 2 do
+    if A[i*7] != i then ok = false;
+  check(ok, "lookup after remove");
+
+  // re-adding into slots freed by the removes
+  for i in 1..n by 2 do D += i*7;
+  check(D.size == n, "re-add size");
+  check(+ reduce A == (n/2)*(n/2+1), "array values after re-add");
+
+  for i in 1..n do D -= i*7;
+  check(D.size == 0, "remove all");
+}
+
+// concurrent adds to a parSafe domain, including duplicates
+{
+  var D: domain(int);
+  forall i in 1..n with (ref D) {
+    D += i;
+    D += n + 1 - i;
+  }
+  check(D.size == n, "parallel add size");
+  check(+ reduce D == n*(n+1)/2, "parallel add contents");
+
+  forall i in 1..n by 3 with (ref D) do D -= i;
+  check(D.size == n - (n+2)/3, "parallel remove size");
+  var bad = 0;
+  forall i in 1..n with (+ reduce bad) do
+    if D.contains(i) == (i % 3 == 1) then bad += 1;
+  check(bad == 0, "lookup after parallel remove");
+}
+
+// implicit adds through an array that owns its domain, string indices
+{
+  var D: domain(string);
+  var A: [D] int;
+  for i in 1..1000 do A["key" + i] = i;
+  check(D.size == 1000, "implicit add size");
+  check(A["key500"] == 500, "string lookup");
+}
+
+// requestCapacity on empty and non-empty domains, then clear
+{
+  var D: domain(int);
+  D.requestCapacity(n);
+  for i in 1..n/2 do D += i;
+  D.requestCapacity(4*n);
+  check(D.size == n/2 && D.contains(n/2) && !D.contains(n), "capacity");
+  D.clear();
+  check(D.size == 0 && !D.contains(1), "clear");
+  D += 1;
+  check(D.size == 1 && D.contains(1), "add after clear");
+}
+
+writeln("done");
@@ -0,0 +1,27 @@
+// Make sure a program still works when its generated code is split
+// across several C files, including calls between generic instantiations
+// and methods that likely land in different files.
+
+record R {
+  var x: int;
+  proc double() return 2 * x;
+}
+
+class C {
+  var r: R;
+  proc sum(n: int) {
+    var s = 0;
+    for i in 1..n do s += r.double() + i;
+    return s;
+  }
+}
+
+proc fib(n: int): int return if n < 2 then n else fib(n-1) + fib(n-2);
+
+proc apply(f, x) return f(x);
+
+var c = new owned C(new R(3));
+writeln(c.sum(10));
+writeln(fib(20));
+writeln(apply(fib, 15));
+writeln(+ reduce [i in 1..100] i*i);
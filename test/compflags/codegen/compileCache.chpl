@@ -0,0 +1,38 @@
+use FileSystem, Spawn;
+
+const cacheDir = "compileCache_dir";
+const filename = "compileCache.chpl";
+
+proc mysystem(cmd: string): int {
+  var sub = spawnshell(cmd);
+  sub.wait();
+  return sub.exit_status;
+}
+
+proc numCached() {
+  var n = 0;
+  for f in listdir(cacheDir) do
+    if f.endsWith(".o") then n += 1;
+  return n;
+}
+
+var binpath = CHPL_HOST_PLATFORM + "-" + CHPL_HOST_ARCH;
+const chpl = CHPL_HOME + "/bin/" + binpath + "/chpl";
+const cmd = chpl + " -o a.out --compile-cache-dir " + cacheDir + " " + filename;
+
+// The first compile fills the cache and the second one should find
+// everything it needs there.
+if mysystem(cmd) != 0 then
+  halt("Error compiling Chapel code");
+const n1 = numCached();
+writeln("cache populated: ", n1 > 0);
+
+if mysystem("rm a.out*") != 0 then
+  halt("Error removing a.out executable(s)");
+
+if mysystem(cmd) != 0 then
+  halt("Error recompiling Chapel code");
+writeln("recompile hit the cache: ", numCached() == n1);
+
+if mysystem("rm -r a.out* " + cacheDir) != 0 then
+  halt("Error cleaning up");
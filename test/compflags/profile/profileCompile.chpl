@@ -0,0 +1,9 @@
+proc twice(x) return x + x;
+
+record Pair {
+  type t;
+  var a, b: t;
+}
+
+writeln(twice(1), " ", twice(2.0), " ", twice("a"));
+writeln(new Pair(int, 1, 2), " ", new Pair(real, 1.0, 2.0));
@@ -0,0 +1,62 @@
+// Calls with the same name and argument types can resolve to different
+// functions depending on what is visible from the call and on the
+// values of param actuals.  Check that the compiler does not reuse one
+// call's resolution for another when they differ.
+
+proc f(x: int) return "module f";
+
+proc a() {
+  proc f(x: int) return "a's f";
+  return f(1);
+}
+
+proc b() {
+  proc f(x: int) return "b's f";
+  return f(1);
+}
+
+proc c() {
+  return f(1);
+}
+
+proc p(param x: int) where x == 1 return "p == 1";
+proc p(param x: int) return "p != 1";
+
+module M {
+  proc q(x: int) return "M's q";
+}
+
+module N {
+  proc q(x: int) return "N's q";
+}
+
+proc d() {
+  use M;
+  return q(1);
+}
+
+proc e() {
+  use N;
+  return q(1);
+}
+
+proc g(x) {
+  return f(x);
+}
+
+proc h() {
+  proc f(x: real) return "h's f";
+  return g(1.0);
+}
+
+proc f(x: real) return "module f(real)";
+
+writeln(a());
+writeln(b());
+writeln(c());
+writeln(p(1));
+writeln(p(2));
+writeln(d());
+writeln(e());
+writeln(h());
+writeln(g(1));
@@ -0,0 +1,86 @@
+/*
+   Throughput of large sequential binary writes and reads through
+   a buffered channel, with and without IOHINT_ASYNC.
+
+   With 'work' > 0, each value written or read also gets that many
+   rounds of a cheap hash, standing in for the formatting or parsing
+   an application would do. That is the case IOHINT_ASYNC is for:
+   the background read-ahead/write-behind lets the disk work while
+   the channel's task computes.
+ */
+use IO, Time, FileSystem;
+
+config const n = 100000;          // number of int(64)s written and read
+config const work = 0;            // hash rounds per value
+config const path = "seqThroughput.tmp";
+config const timing = false;
+
+proc mix(x: int) {
+  var h = x: uint;
+  for 1..work {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+  }
+  return h;
+}
+
+proc writeFile(hints: iohints) {
+  var f = open(path, iomode.cw, hints=hints);
+  var w = f.writer(kind=ionative, locking=false, hints=hints);
+  var check: uint;
+  for i in 1..n {
+    check ^= mix(i);
+    w.write(i);
+  }
+  w.close();
+  f.close();
+  return check;
+}
+
+proc readFile(hints: iohints) {
+  var f = open(path, iomode.r, hints=hints);
+  var r = f.reader(kind=ionative, locking=false, hints=hints);
+  var check: uint;
+  var x: int;
+  var count = 0;
+  while r.read(x) {
+    count += 1;
+    if x != count then
+      halt("read ", x, " at position ", count);
+    check ^= mix(x);
+  }
+  r.close();
+  f.close();
+  if count != n then
+    halt("read ", count, " values, expected ", n);
+  return check;
+}
+
+const mb = (n * numBytes(int)):real / (1024 * 1024);
+
+for (name, hints) in [("sync", IOHINT_NONE),
+                      ("async", IOHINT_SEQUENTIAL | IOHINT_ASYNC)] {
+  var t: Timer;
+
+  t.start();
+  const wcheck = writeFile(hints);
+  t.stop();
+  const wtime = t.elapsed();
+
+  t.clear();
+  t.start();
+  const rcheck = readFile(hints);
+  t.stop();
+  const rtime = t.elapsed();
+
+  if wcheck != rcheck then
+    halt(name, ": checksum mismatch");
+
+  writeln(name, ": Validation: SUCCESS");
+  if timing {
+    writeln(name, " write MB/s: ", mb / wtime);
+    writeln(name, " read MB/s: ", mb / rtime);
+  }
+}
+
+remove(path);
@@ -0,0 +1,91 @@
+#include "qio.h"
+#include <assert.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/resource.h>
+
+// Write errors from the QIO_HINT_ASYNC write-behind helper must come
+// back, with their errno, from flush and from close, whether or not a
+// write saw them first.
+//
+// A file size limit of one iobuf makes the helper's later pwrites fail
+// with EFBIG.
+
+int verbose = 0;
+
+void check_async_write_error(int64_t nbufs, int flush, int64_t chunksz)
+{
+  qio_file_t* f;
+  qio_channel_t* writing;
+  qioerr err;
+  qioerr write_err = 0;
+  ssize_t amt_written;
+  unsigned char* chunk;
+  int64_t offset;
+  qio_hint_t hints = QIO_METHOD_PREADPWRITE | QIO_CH_BUFFERED | QIO_HINT_ASYNC;
+
+  if( verbose ) printf("check_async_write_error(nbufs=%i, flush=%i, chunksz=%i)\n",
+                       (int) nbufs, flush, (int) chunksz);
+
+  chunk = qio_calloc(chunksz, 1);
+  assert(chunk);
+
+  err = qio_file_open_tmp(&f, hints, NULL);
+  assert(!err);
+
+  err = qio_channel_create(&writing, f, hints, 0, 1, 0, INT64_MAX, NULL);
+  assert(!err);
+  assert(writing->async);
+
+  // A write may already see the error once the helper has reported it.
+  for( offset = 0; offset < nbufs * qbytes_iobuf_size; offset += chunksz ) {
+    err = qio_channel_write(true, writing, chunk, chunksz, &amt_written);
+    if( err ) {
+      write_err = err;
+      break;
+    }
+    assert(amt_written == chunksz);
+  }
+  assert(!write_err || qio_err_to_int(write_err) == EFBIG);
+
+  if( flush ) {
+    err = qio_channel_flush(true, writing);
+    assert(qio_err_to_int(err) == EFBIG);
+  }
+
+  err = qio_channel_close(true, writing);
+  assert(qio_err_to_int(err) == EFBIG);
+
+  qio_channel_release(writing);
+  qio_file_release(f);
+  qio_free(chunk);
+}
+
+int main(int argc, char** argv)
+{
+  struct rlimit lim;
+  int64_t nbufs;
+  int flush;
+
+  if( argc != 1 ) verbose = 1;
+
+  // use smaller qbytes_iobuf_size for testing
+  qbytes_iobuf_size = 4*1024;
+
+  // Writes past the limit fail with EFBIG instead of raising SIGXFSZ.
+  signal(SIGXFSZ, SIG_IGN);
+  getrlimit(RLIMIT_FSIZE, &lim);
+  lim.rlim_cur = qbytes_iobuf_size;
+  setrlimit(RLIMIT_FSIZE, &lim);
+
+  for( nbufs = 2; nbufs <= 2*qio_async_iobufs; nbufs++ ) {
+    for( flush = 0; flush < 2; flush++ ) {
+      check_async_write_error(nbufs, flush, qbytes_iobuf_size);
+      check_async_write_error(nbufs, flush, 100);
+    }
+  }
+
+  printf("qio_async_error PASS\n");
+
+  return 0;
+}
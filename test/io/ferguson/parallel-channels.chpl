@@ -0,0 +1,60 @@
+// Many channels reading and writing disjoint parts of one file
+// with IOHINT_PARALLEL.  The .execenv sets CHPL_RT_IO_URING, so they
+// should share an io_uring wherever the kernel supports it.
+use IO, FileSystem;
+require "qio_uring.h";
+
+extern const QIO_METHODMASK: c_int;
+extern const QIO_METHOD_URING: c_int;
+extern proc qio_uring_supported(): c_int;
+extern proc qio_channel_get_hints(ch: qio_channel_ptr_t): c_int;
+
+proc usedUring(ch) {
+  return (qio_channel_get_hints(ch._channel_internal) & QIO_METHODMASK)
+         == QIO_METHOD_URING;
+}
+
+const uringSupported = qio_uring_supported() != 0;
+
+config const nChunks = 16;
+config const perChunk = 50000;
+config const path = "parallel-channels.tmp";
+
+{
+  var f = open(path, iomode.cw, hints=IOHINT_PARALLEL);
+  var wrongMethod: int;
+  forall c in 0..#nChunks with (+ reduce wrongMethod) {
+    const start = c * perChunk * numBytes(int);
+    var w = f.writer(kind=ionative, locking=false, start=start,
+                     hints=IOHINT_PARALLEL);
+    if usedUring(w) != uringSupported then wrongMethod += 1;
+    for i in c*perChunk..#perChunk do
+      w.write(i);
+    w.close();
+  }
+  f.close();
+  writeln("writers used io_uring where supported: ", wrongMethod == 0);
+}
+
+{
+  var f = open(path, iomode.r, hints=IOHINT_PARALLEL);
+  var errors: int;
+  forall c in 0..#nChunks with (+ reduce errors) {
+    const start = c * perChunk * numBytes(int);
+    var r = f.reader(kind=ionative, locking=false, start=start,
+                     end=start + perChunk * numBytes(int),
+                     hints=IOHINT_PARALLEL);
+    if usedUring(r) != uringSupported then errors += 1;
+    var x: int;
+    for i in c*perChunk..#perChunk {
+      r.read(x);
+      if x != i then errors += 1;
+    }
+    if r.read(x) then errors += 1; // should be at the end
+    r.close();
+  }
+  f.close();
+  writeln("errors: ", errors);
+}
+
+remove(path);
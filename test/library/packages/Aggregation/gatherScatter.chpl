@@ -0,0 +1,90 @@
+use BlockDist, CyclicDist, Random, CommDiagnostics;
+use Aggregation;
+
+config const n = 1000,
+             m = 5000;
+
+proc check(name: string, ref A, inds) {
+  var vals: [inds.domain] int;
+  gather(vals, A, inds);
+  for (v, i) in zip(vals, inds) do
+    if v != A[i] then
+      halt(name, ": gather got ", v, " for A[", i, "] = ", A[i]);
+
+  // reuse the addresses, after the values have changed
+  const addrs = remoteAddrs(A, inds);
+  A += 1;
+  gatherv(vals, addrs);
+  for (v, i) in zip(vals, inds) do
+    if v != A[i] then
+      halt(name, ": gatherv got ", v, " for A[", i, "] = ", A[i]);
+
+  // scatter the negated indices back; duplicates all write the same value
+  const negInds: [inds.domain] int = -inds;
+  scatter(A, inds, negInds);
+  for i in inds do
+    if A[i] != -i then
+      halt(name, ": scatter left ", A[i], " at A[", i, "]");
+}
+
+proc randomInds(D, count) {
+  var inds: [1..count] int;
+  fillRandom(inds, seed=17);
+  inds = mod(inds, D.size) + D.low;
+  return inds;
+}
+
+{
+  const D = {1..n} dmapped Block({1..n});
+  var A: [D] int = D;
+  check("Block", A, randomInds(D, m));
+}
+
+{
+  const D = {0..#n} dmapped Cyclic(startIdx=0);
+  var A: [D] int = D;
+  check("Cyclic", A, randomInds(D, m));
+}
+
+{
+  var A: [1..n] int = 1..n;
+  check("local", A, randomInds(A.domain, m));
+}
+
+{
+  // empty batches, and a locale gathering with no elements of its own
+  const D = {1..n} dmapped Block({1..n});
+  var A: [D] int = D;
+  const none: [1..0] int;
+  check("empty", A, none);
+  on Locales[numLocales-1] {
+    const inds = [i in 1..10] i;   // all on locale 0
+    check("remote", A, inds);
+  }
+}
+
+//
+// Moving the values is one batch per locale, regardless of how many
+// elements there are.
+//
+proc countComm(count) {
+  const D = {1..n} dmapped Block({1..n});
+  var A: [D] int = D;
+  const inds = randomInds(D, count);
+  const addrs = remoteAddrs(A, inds);
+  var vals: [inds.domain] int;
+
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  gatherv(vals, addrs);
+  scatterv(addrs, vals);
+  stopCommDiagnostics();
+
+  var total = 0;
+  for d in getCommDiagnostics() do total += (d.get + d.put): int;
+  return total;
+}
+
+const few = countComm(m), many = countComm(10*m);
+if few != many then
+  writeln("comm count grew with the batch size: ", few, " vs. ", many);
@@ -0,0 +1,50 @@
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use LayoutCS;
+
+/* Sparse dot() products with a CSC matrix match the dense products */
+
+config const n = 100;
+
+proc test(m, n) {
+  const Space = {1..m, 1..n};
+  var cscDom: sparse subdomain(Space) dmapped CS(compressRows=false),
+      csrDom: sparse subdomain(Space) dmapped CS(compressRows=true);
+  var inds = [i in 1..m] (i, 1 + (i * 7) % n);
+  cscDom += inds; csrDom += inds;
+  inds = [i in 1..m] (i, 1 + (i + n/2) % n);
+  cscDom += inds; csrDom += inds;
+
+  var Acsc: [cscDom] int, Acsr: [csrDom] int, A: [Space] int;
+  for (i, j) in cscDom {
+    const v = (i + 2*j) % 5 - 2;
+    Acsc[i, j] = v; Acsr[i, j] = v; A[i, j] = v;
+  }
+
+  const x: [1..n] int = [j in 1..n] j % 3,
+        xt: [0..#m] int = [i in 0..#m] i % 4 + 1;
+  const B: [1..n, 1..3] int = [(j, k) in {1..n, 1..3}] j * k % 7;
+
+  proc check(z, zRef, msg) {
+    if !(&& reduce (z == zRef)) then
+      writeln(msg, " differs: ", m, "x", n);
+  }
+
+  check(dot(Acsc, x), dot(A, x), "A * x");
+  check(dot(xt, Acsc), dot(xt, A), "x * A");
+  check(dot(Acsc, B), dot(A, B), "A * B");
+  check(dot(Acsc, x), dot(Acsr, x), "CSC vs CSR A * x");
+}
+
+test(n, n);
+test(n, n/2);
+test(3, 2*n);
+
+{
+  const D = {1..4, 1..4};
+  var S: sparse subdomain(D) dmapped CS(compressRows=false);
+  S += [(1,1), (1,3), (2,2), (2,4), (3,1), (4,2), (4,3), (4,4)];
+  var A: [S] int;
+  for (i, j) in S do A[i, j] = i + 2*j;
+  writeln(dot(A, [1, 2, 3, 4]));
+}
@@ -0,0 +1,19 @@
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use BlockDist;
+use LayoutCS;
+
+/* DistributedSpMV only supports CSR blocks, so dot() of a SparseBlock
+   CSC matrix is rejected at compile time */
+
+config const n = 10;
+
+const Space = {1..n, 1..n} dmapped Block({1..n, 1..n},
+                                         sparseLayoutType=CS(compressRows=false));
+var D: sparse subdomain(Space);
+D += [i in 1..n] (i, i);
+
+var A: [D] real = 1.0;
+var x: [{1..n} dmapped Block({1..n})] real = 1.0;
+
+writeln(dot(A, x));
@@ -0,0 +1,70 @@
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use BlockDist;
+use LayoutCS;
+use CommDiagnostics;
+
+/* Distributed CSR matrix-vector multiplication (DistributedSpMV)
+
+   The matrix has a band, plus one entry per row far from the diagonal, so
+   that every locale needs entries of x from others.
+
+   Any output denotes failure
+*/
+
+config const n = 1000;
+
+proc test(m, n) {
+  const Space = {1..m, 1..n} dmapped Block({1..m, 1..n}, sparseLayoutType=CS);
+  var D: sparse subdomain(Space);
+  D += [i in 1..m] (i, 1 + (i * 7) % n);
+  D += [i in 1..m] (i, 1 + (i + n/2) % n);
+  D += [i in 1..min(m, n)] (i, i);
+
+  var A: [D] real;
+  forall (i, j) in D do A[i, j] = (i + 2*j) % 5 - 2;
+
+  const xDom = {1..n} dmapped Block({1..n}),
+        yDom = {1..m} dmapped Block({1..m});
+  var x: [xDom] real = [j in xDom] j % 3;
+  var y: [yDom] real;
+
+  var spmv = new owned DistributedSpMV(A, xDom, yDom);
+
+  proc check(msg) {
+    var yRef: [1..m] real;
+    for (i, j) in D do yRef[i] += A[i, j] * x[j];
+    if !(&& reduce (y == yRef)) then
+      writeln("y != A * x: ", msg, " ", m, "x", n);
+  }
+
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  spmv.apply(x, y);
+  stopCommDiagnostics();
+  check("apply");
+
+  // New values, same indices
+  A = -A + 1;
+  x = 2 * x;
+  spmv.apply(x, y);
+  check("apply after update");
+
+  const z = dot(A, x);
+  if !(&& reduce (z == y)) then
+    writeln("dot(A, x) != apply: ", m, "x", n);
+
+  var comms = 0;
+  for c in getCommDiagnostics() do
+    comms += (c.get + c.put + c.execute_on): int;
+  return comms;
+}
+
+// The communication of a product does not grow with the matrix
+const small = test(n, n),
+      large = test(10*n, 10*n);
+if small != large then
+  writeln("communication grows with n: ", small, " vs ", large);
+
+test(n, n/2);
+test(3, 2*n);
@@ -0,0 +1,59 @@
+use LinearAlgebra;
+use TestUtils;
+
+/* Native (no BLAS) matrix-matrix and matrix-vector multiplication
+
+   The inputs are small integers, so results are exact.  Sizes are chosen
+   to cover partial register blocks and more than one cache block.
+
+   Any output denotes failure
+*/
+
+proc naiveMatMat(A, B) {
+  var C: [A.domain.dim(1), B.domain.dim(2)] A.eltType;
+  forall (i, j) in C.domain do
+    for (k1, k2) in zip(A.domain.dim(2), B.domain.dim(1)) do
+      C[i, j] += A[i, k1] * B[k2, j];
+  return C;
+}
+
+proc test_gemm(type t, m, k, n) {
+  // Offset and strided dimensions exercise the index arithmetic.
+  var A: [1..m, 0..#k] t,
+      B: [3..#k, 1..2*n by 2] t;
+  forall (i, j) in A.domain do A[i, j] = ((i*7 + j*3) % 11 - 5): t;
+  forall (i, j) in B.domain do B[i, j] = ((i*5 + j) % 13 - 6): t;
+
+  const msg = t:string + " " + m:string + "x" + k:string + "x" + n:string;
+
+  assertEqual(dot(A, B), naiveMatMat(A, B), "dot(A, B) " + msg);
+
+  var x: [0..#k] t = [i in 0..#k] (i % 5): t;
+  var Ax: [1..m] t;
+  forall i in 1..m do
+    for j in 0..#k do
+      Ax[i] += A[i, j] * x[j];
+  assertEqual(dot(A, x), Ax, "dot(A, x) " + msg);
+
+  var z: [0..#m] t = [i in 0..#m] (i % 3 - 1): t;
+  var zA: [0..#k] t;
+  forall j in 0..#k do
+    for (i, zi) in zip(1..m, 0..#m) do
+      zA[j] += A[i, j] * z[zi];
+  assertEqual(dot(z, A), zA, "dot(z, A) " + msg);
+}
+
+for (m, k, n) in [(1, 1, 1), (5, 3, 7), (130, 257, 300), (0, 3, 4), (3, 0, 4)] {
+  test_gemm(real(32), m, k, n);
+  test_gemm(real(64), m, k, n);
+  test_gemm(complex(64), m, k, n);
+  test_gemm(complex(128), m, k, n);
+  test_gemm(int, m, k, n);
+}
+
+/* matPow */
+{
+  var M = Matrix(5, 5);
+  forall (i, j) in M.domain do M[i, j] = (i + j) % 3;
+  assertEqual(matPow(M, 3), naiveMatMat(naiveMatMat(M, M), M), "matPow(M, 3)");
+}
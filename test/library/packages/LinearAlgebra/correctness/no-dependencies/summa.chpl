@@ -0,0 +1,41 @@
+use LinearAlgebra;
+use BlockDist;
+use TestUtils;
+
+/* dot() of Block-distributed matrices (SUMMA)
+
+   The distributed product is compared against the product of local copies
+   of the operands.  The inputs are small integers, so results are exact.
+
+   Any output denotes failure
+*/
+
+config const m = 300,
+             k = 600,
+             n = 200;
+
+proc test_summa(type t, m, k, n) {
+  // Block requires a non-empty bounding box, even over an empty domain
+  const Adom = {1..m, 0..#k} dmapped Block({1..max(m, 1), 0..#max(k, 1)}),
+        Bdom = {0..#k, 1..n} dmapped Block({0..#max(k, 1), 1..max(n, 1)});
+  var A: [Adom] t,
+      B: [Bdom] t;
+  forall (i, j) in Adom do A[i, j] = ((i*7 + j*3) % 11 - 5): t;
+  forall (i, j) in Bdom do B[i, j] = ((i*5 + j) % 13 - 6): t;
+
+  var LA: [1..m, 0..#k] t = A,
+      LB: [0..#k, 1..n] t = B;
+
+  const msg = t:string + " " + m:string + "x" + k:string + "x" + n:string;
+
+  const C = dot(A, B);
+  assertEqual(C, dot(LA, LB), "dot(A, B) " + msg);
+  if C.targetLocales().size != numLocales then
+    writeln("C is not distributed over all locales: ", msg);
+}
+
+test_summa(real, m, k, n);
+test_summa(complex, 7, 3, 5);
+test_summa(int, 1, 1, 1);
+test_summa(real(32), 0, 3, 4);
+test_summa(real, 5, 0, 4);
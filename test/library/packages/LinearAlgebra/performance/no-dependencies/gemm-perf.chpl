@@ -0,0 +1,71 @@
+/*
+Native (no BLAS) dense matrix multiplication performance testing
+
+Reports GFLOP/s for dot() on n x n matrices and matrix-vector products.
+*/
+
+use LinearAlgebra;
+use Time;
+
+config const n = 1024,
+             iters = 3,
+             correctness = false;
+
+config type eltType = real;
+
+// flops per multiply-add
+param flopsPerFMA = if isComplexType(eltType) then 8 else 2;
+
+proc main() {
+  var A = Matrix(n, n, eltType=eltType),
+      B = Matrix(n, n, eltType=eltType),
+      x = Vector(n, eltType=eltType);
+
+  forall (i, j) in A.domain {
+    A[i, j] = ((i + 2*j) % 7): eltType;
+    B[i, j] = ((3*i + j) % 5): eltType;
+  }
+  forall i in x.domain do x[i] = (i % 3): eltType;
+
+  var t: Timer;
+
+  var C: A.type;
+  for 1..iters {
+    t.start();
+    C = dot(A, B);
+    t.stop();
+  }
+  const gemmTime = t.elapsed() / iters;
+  t.clear();
+
+  var y: x.type;
+  for 1..iters {
+    t.start();
+    y = dot(A, x);
+    t.stop();
+  }
+  const gemvTime = t.elapsed() / iters;
+  t.clear();
+
+  // Spot-check rows of C and y against the definition.
+  var ok = true;
+  for i in 1..n by max(1, n/7) {
+    for j in 1..n by max(1, n/5) {
+      var s: eltType;
+      for p in 1..n do s += A[i, p] * B[p, j];
+      if s != C[i, j] then ok = false;
+    }
+    var s: eltType;
+    for p in 1..n do s += A[i, p] * x[p];
+    if s != y[i] then ok = false;
+  }
+  writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
+
+  if !correctness {
+    writeln("n: ", n, " eltType: ", eltType:string);
+    writeln("gemm time (s): ", gemmTime);
+    writeln("gemm GFLOP/s: ", flopsPerFMA * n**3 / gemmTime / 1e9);
+    writeln("gemv time (s): ", gemvTime);
+    writeln("gemv GFLOP/s: ", flopsPerFMA * n**2 / gemvTime / 1e9);
+  }
+}
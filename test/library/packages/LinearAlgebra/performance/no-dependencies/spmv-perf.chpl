@@ -0,0 +1,121 @@
+/*
+Sparse (CSR) matrix-vector and matrix-dense matrix multiplication
+performance testing
+
+Reports GFLOP/s for dot(A, x) and dot(A, B), where A is a CSR matrix and
+x and B are dense.  A is read from a MatrixMarket file when one is given,
+and is otherwise generated with skewed row lengths, so that splitting rows
+evenly between tasks would leave them with very different amounts of work.
+*/
+
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use MatrixMarket;
+use Time;
+
+config const file = "",
+             n = 100000,
+             // nonzeros in most rows of the generated matrix
+             rowNNZ = 8,
+             // every denseRowStride'th generated row is much longer
+             denseRowStride = 1000,
+             // columns of the dense matrix B
+             k = 8,
+             iters = 10,
+             correctness = false;
+
+proc main() {
+  if file != "" {
+    const S = mmreadsp(real, file);
+    var D = CSRDomainOf(S);
+    var A: [D] real;
+    forall (i, j) in D do A[i, j] = S[i, j];
+    benchmark(A);
+  } else {
+    var D = generateCSRDomain(n);
+    var A: [D] real;
+    forall (i, j) in D do A[i, j] = ((i + 2*j) % 7 - 3): real;
+    benchmark(A);
+  }
+}
+
+proc benchmark(A: [?D] real) {
+  const (rows, cols) = D._value.parentDom.dims();
+  var x: [cols] real = [j in cols] (j % 5): real;
+  var B: [cols, 1..k] real = [(i, j) in {cols, 1..k}] ((i + j) % 3): real;
+
+  var t: Timer;
+
+  var y: [rows] real;
+  for 1..iters {
+    t.start();
+    y = dot(A, x);
+    t.stop();
+  }
+  const spmvTime = t.elapsed() / iters;
+  t.clear();
+
+  var C: [rows, 1..k] real;
+  for 1..iters {
+    t.start();
+    C = dot(A, B);
+    t.stop();
+  }
+  const spmmTime = t.elapsed() / iters;
+  t.clear();
+
+  if correctness {
+    // Check against the element-wise definition.  The inputs are small
+    // integers, so the results are exact.
+    var yRef: [rows] real,
+        CRef: [rows, 1..k] real;
+    for (i, j) in D {
+      yRef[i] += A[i, j] * x[j];
+      for c in 1..k do CRef[i, c] += A[i, j] * B[j, c];
+    }
+    const ok = && reduce (y == yRef) && && reduce (C == CRef);
+    writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
+  } else {
+    const nnz = D.size;
+    writeln("Matrix: ", rows.size, " x ", cols.size, ", ", nnz, " nonzeros");
+    writeln("spmv GFLOP/s: ", 2.0 * nnz / spmvTime / 1e9);
+    writeln("spmm GFLOP/s: ", 2.0 * nnz * k / spmmTime / 1e9);
+  }
+}
+
+/* CSR domain with the nonzero pattern of a sparse array */
+proc CSRDomainOf(S) {
+  const (m, n) = S.shape;
+  var D = CSRDomain(m, n);
+
+  // The default sparse layout iterates in sorted order
+  var inds: [1..S.domain.size] 2*int;
+  for (ind, i) in zip(S.domain, 1..) do inds[i] = ind;
+  D.bulkAdd(inds, dataSorted=true, isUnique=true);
+  return D;
+}
+
+/* CSR domain with a band of rowNNZ nonzeros in most rows, and rows
+   of 100*rowNNZ nonzeros every denseRowStride rows */
+proc generateCSRDomain(n) {
+  var D = CSRDomain(n, n);
+  const longRows = 1..n by denseRowStride,
+        longNNZ = 100*rowNNZ;
+
+  // Count the nonzeros in each row, then fill in their indices
+  var rowStart: [1..n+1] int;
+  forall i in 1..n do
+    rowStart[i+1] = min(n, if longRows.contains(i) then longNNZ else rowNNZ);
+  rowStart[1] = 1;
+  for i in 2..n+1 do rowStart[i] += rowStart[i-1];
+
+  var inds: [1..rowStart[n+1]-1] 2*int;
+  forall i in 1..n {
+    const len = rowStart[i+1] - rowStart[i],
+          first = min(max(1, i - len/2), n - len + 1);
+    for (p, j) in zip(rowStart[i]..#len, first..#len) do
+      inds[p] = (i, j);
+  }
+  D.bulkAdd(inds, dataSorted=true, isUnique=true);
+  return D;
+}
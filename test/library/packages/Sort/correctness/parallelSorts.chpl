@@ -0,0 +1,130 @@
+use Sort;
+use Random;
+
+//
+// Check radixSort() and sampleSort(), and sort() sizes that dispatch to
+// them, over a range of element types, comparators, and array shapes.
+//
+
+config const n = 100000;
+
+record R {
+  var key: int;
+  var val: int;
+}
+
+record KeyCmp { }
+proc KeyCmp.key(a: R) { return a.key; }
+
+class C {
+  var key: int;
+}
+
+record FieldKey { }
+proc FieldKey.key(a) { return a.key; }
+
+record AbsCmp { }
+proc AbsCmp.compare(a, b) { return abs(a) - abs(b); }
+
+record NegRealKey { }
+proc NegRealKey.key(a: real) { return -a; }
+
+proc check(name, A, comparator) {
+  writeln(name, ": ", isSorted(A, comparator=comparator));
+}
+
+proc testType(type T) {
+  var D: [1..n] T;
+  fillRandom(D, seed=17);
+
+  var A = D;
+  radixSort(A);
+  check("radixSort " + T:string, A, defaultComparator);
+
+  var B = D;
+  sampleSort(B);
+  check("sampleSort " + T:string, B, defaultComparator);
+
+  var C = D;
+  sort(C);
+  check("sort " + T:string, C, defaultComparator);
+  writeln("  same as radixSort: ", && reduce (A == C));
+}
+
+testType(int);
+testType(uint);
+testType(int(32));
+testType(uint(8));
+testType(real);
+testType(real(32));
+testType(int(16));
+
+// Negative reals, zeros, and infinities
+{
+  var A: [0..#n] real;
+  fillRandom(A, seed=3);
+  A = (A - 0.5) * 1.0e10;
+  A[0] = -0.0; A[1] = 0.0; A[2] = -INFINITY; A[3] = INFINITY; A[4] = -1.0e-300;
+  var B = A;
+  radixSort(A);
+  check("radixSort signed reals", A, defaultComparator);
+  radixSort(B, comparator=new NegRealKey());
+  check("radixSort real key", B, new NegRealKey());
+}
+
+// Radix sort is stable for records with a key method
+{
+  var Keys: [1..n] int;
+  fillRandom(Keys, seed=5);
+  var A: [1..n] R;
+  for (a, k, i) in zip(A, Keys, 1..) do a = new R(k % 100, i);
+  radixSort(A, comparator=new KeyCmp());
+  check("radixSort record key", A, new KeyCmp());
+  var stable = true;
+  for i in 2..n do
+    if A[i].key == A[i-1].key && A[i].val < A[i-1].val then stable = false;
+  writeln("  stable: ", stable);
+}
+
+// Compare-only and reverse comparators go to sample sort
+{
+  var A: [1..n] int;
+  fillRandom(A, seed=7);
+  A = A % 1000;
+  var B = A;
+  sampleSort(A, comparator=new AbsCmp());
+  check("sampleSort compare", A, new AbsCmp());
+  sort(B, comparator=reverseComparator);
+  check("sort reverse", B, reverseComparator);
+}
+
+// Strided arrays, duplicates, and trivial sizes
+{
+  var A: [1..2*n by 2] int;
+  fillRandom(A, seed=11);
+  A = A % 4;
+  var B = A;
+  radixSort(A);
+  check("radixSort strided", A, defaultComparator);
+  sampleSort(B);
+  check("sampleSort strided", B, defaultComparator);
+
+  var E: [1..0] int;
+  radixSort(E); sampleSort(E);
+  var One = [42];
+  radixSort(One); sampleSort(One);
+  writeln("trivial: ", One);
+}
+
+// Class elements, which default to nil
+{
+  var Keys: [1..n] int;
+  fillRandom(Keys, seed=13);
+  var Own = [k in Keys] new owned C(k % 1000);
+  var A: [1..n] borrowed C = [o in Own] o.borrow();
+  var B = A;
+  sort(A, comparator=new FieldKey());
+  check("sort borrowed class key", A, new FieldKey());
+  radixSort(B, comparator=new FieldKey());
+  check("radixSort borrowed class key", B, new FieldKey());
+}
@@ -0,0 +1,75 @@
+use Sort, BlockDist, CyclicDist, Random;
+
+//
+// Sort Block- and Cyclic-distributed arrays, which sort() does with a
+// distributed sample sort, and check the results against sorting a
+// local copy.
+//
+
+config const n = 200000;
+
+record R {
+  var key: real;
+  var id: int;
+}
+
+record KeyCmp { }
+proc KeyCmp.key(a: R) { return a.key; }
+
+class C {
+  var key: int;
+}
+
+record FieldKey { }
+proc FieldKey.key(a) { return a.key; }
+
+record AbsCmp { }
+proc AbsCmp.compare(a, b) { return abs(a) - abs(b); }
+
+proc test(name, D, type T, comparator, mod = 0) {
+  var A: [D] T;
+  if T == R {
+    var Keys: [D] real;
+    fillRandom(Keys, seed=31);
+    forall (a, k, i) in zip(A, Keys, D) do a = new R(k, i);
+  } else {
+    fillRandom(A, seed=31);
+    if isIntegralType(T) then
+      if mod != 0 then A %= mod: T;
+  }
+
+  var L: [0..#D.size] T = A;
+  sort(L, comparator=comparator);
+  sort(A, comparator=comparator);
+
+  var same = true;
+  forall (a, l) in zip(A, L) with (&& reduce same) {
+    if T == R {
+      same &&= a.key == l.key;
+    } else {
+      same &&= chpl_compare(a, l, comparator) == 0;
+    }
+  }
+  writeln(name, ": ", same);
+}
+
+const Space = {1..n};
+const BD = Space dmapped Block(Space);
+const CD = Space dmapped Cyclic(startIdx=Space.low);
+
+test("Block int", BD, int, defaultComparator);
+test("Cyclic int", CD, int, defaultComparator);
+test("Block real", BD, real, defaultComparator);
+test("Block reverse", BD, int, reverseComparator);
+test("Cyclic compare", CD, int, new AbsCmp(), mod=1000);
+test("Block duplicates", BD, int, defaultComparator, mod=3);
+test("Cyclic record key", CD, R, new KeyCmp());
+test("Block equal keys", BD, int, defaultComparator, mod=1);
+
+// Class elements are sorted without the distributed sort
+{
+  var Own = [i in BD] new owned C((i * 7919) % 1000);
+  var A: [BD] borrowed C = [o in Own] o.borrow();
+  sort(A, comparator=new FieldKey());
+  writeln("Block borrowed class: ", isSorted(A, comparator=new FieldKey()));
+}
@@ -0,0 +1,56 @@
+/*
+   Weak-scaling benchmark for sort() on distributed arrays.
+
+   Sorts perLocale random elements per locale on 1, 2, 4, ... of the
+   locales up to numLocales, so that the time stays flat if the sort
+   scales.  With --printTimes it reports the time at each locale count,
+   and then the time and rate with all the locales for the perf keys;
+   otherwise it just checks the results.
+ */
+
+use Sort, BlockDist, CyclicDist, Random, Time;
+
+config const perLocale = 100000,
+             dist = "block",
+             printTimes = false;
+
+config type T = int;
+
+var allSorted = true,
+    lastTime = 0.0;
+
+var k = 1;
+while k <= numLocales {
+  const Space = {0..#k*perLocale},
+        TL = Locales[0..#k];
+  if dist == "block" then
+    run(k, Space dmapped Block(Space, targetLocales=TL));
+  else if dist == "cyclic" then
+    run(k, Space dmapped Cyclic(startIdx=0, targetLocales=TL));
+  else
+    halt("unknown --dist: ", dist);
+  k = if k < numLocales && 2*k > numLocales then numLocales else 2*k;
+}
+
+writeln("sorted at every locale count: ", allSorted);
+if printTimes {
+  writeln("Time: ", lastTime);
+  writeln("MB/s per locale: ", perLocale * numBytes(T) / lastTime / 1.0e6);
+}
+
+proc run(k, D) {
+  var A: [D] T;
+  fillRandom(A, seed=314159);
+
+  var t: Timer;
+  t.start();
+  sort(A);
+  t.stop();
+
+  const ok = && reduce [i in D.low..D.high-1] A[i] <= A[i+1];
+  allSorted &&= ok;
+
+  lastTime = t.elapsed();
+  if printTimes then
+    writeln("sort on ", k, " locales (seconds): ", lastTime);
+}
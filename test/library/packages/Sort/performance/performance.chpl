@@ -11,7 +11,7 @@ use Time;
 
 config const M: int = 6,                    // 2**M bytes
              correctness: bool = true,      // Disables output
-             sorts: string = 'qhimsr';      // Sorts to use (first letter)
+             sorts: string = 'qhimsrxp';    // Sorts to use (see below)
 
 // Array properties
 config type T = int;                // Type of array
@@ -119,6 +119,30 @@ proc gatherTimings(const ref A) {
       print('selectionSort (seconds): ', t.elapsed());
     t.clear();
   }
+  if sorts.find('x')
+  {
+    var B = A;
+    t.start();
+    radixSort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('radixSort failed to sort data');
+    else
+      print('radixSort (seconds): ', t.elapsed());
+    t.clear();
+  }
+  if sorts.find('p')
+  {
+    var B = A;
+    t.start();
+    sampleSort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('sampleSort failed to sort data');
+    else
+      print('sampleSort (seconds): ', t.elapsed());
+    t.clear();
+  }
   if sorts.find('b')
   {
     var B = A;
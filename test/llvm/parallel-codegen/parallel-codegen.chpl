@@ -0,0 +1,25 @@
+// Check that a program whose code was generated in several parts, on
+// several threads, links and runs correctly.
+
+config const n = 1000;
+
+record R {
+  var x: int;
+  proc double() { return 2 * x; }
+}
+
+proc sum(A: [] int) {
+  return + reduce A;
+}
+
+proc fib(i: int): int {
+  return if i < 2 then i else fib(i-1) + fib(i-2);
+}
+
+var A: [1..n] int = [i in 1..n] i;
+var r = new R(21);
+
+writeln(sum(A));
+writeln(r.double());
+writeln(fib(20));
+writeln(+ reduce [i in 1..n] (i % 7));
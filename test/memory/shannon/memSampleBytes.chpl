@@ -0,0 +1,23 @@
+use Memory;
+
+extern proc chpl_mem_allocMany(number, size, description, lineno=-1, filename=0): c_void_ptr;
+extern proc chpl_mem_free(ptr, lineno=-1, filename=0);
+
+//
+// With --memSampleBytes, memoryUsed() is an estimate.  Do many small
+// allocations and check that the estimate is close, then free them and
+// check that the estimate returns exactly to where it started.
+//
+config const n = 100000,
+             size = 64;
+
+var ptrs: [1..n] c_void_ptr;
+const start = memoryUsed();
+for p in ptrs do p = chpl_mem_allocMany(1, size, 0);
+const allocated = memoryUsed() - start;
+for p in ptrs do chpl_mem_free(p);
+const afterFree = memoryUsed() - start;
+
+const expected = (n * size): real;
+writeln("estimate within 1%: ", abs(allocated - expected) < 0.01 * expected);
+writeln("after free: ", afterFree);
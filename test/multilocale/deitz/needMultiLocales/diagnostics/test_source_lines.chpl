@@ -0,0 +1,14 @@
+use CommDiagnostics;
+
+proc main() {
+  var x, y: int;
+  on Locales(1) {
+    startCommDiagnostics();
+    x = 1;
+    for i in 1..3 do
+      y = i;
+    stopCommDiagnostics();
+  }
+  writeln((x, y));
+  printCommDiagnosticsSourceLines();
+}
@@ -0,0 +1,58 @@
+// Many tasks read the same remote data through the shared read cache,
+// then read it again after it was overwritten.  The comm diagnostics
+// check that the reads went through the shared layer.
+use CommDiagnostics;
+
+config const n = 10000;
+config const tasksPerLocale = 2*here.maxTaskPar;
+
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    for i in 1..n {
+      A[i] = i;
+    }
+    on running {
+      coforall t in 1..tasksPerLocale {
+        for i in 1..n {
+          assert(A[i] == i);
+        }
+      }
+      forall i in 1..n {
+        A[i] = -i;
+      }
+      coforall t in 1..tasksPerLocale {
+        for i in 1..n by -1 {
+          assert(A[i] == -i);
+        }
+      }
+    }
+    for i in 1..n {
+      assert(A[i] == -i);
+      A[i] = 2*i;
+    }
+    on running {
+      coforall t in 1..tasksPerLocale {
+        for i in 1..n {
+          assert(A[i] == 2*i);
+        }
+      }
+    }
+  }
+}
+
+proc check(memory:locale, running:locale) {
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  doit(memory, running);
+  stopCommDiagnostics();
+  const d = getCommDiagnostics()[running.id];
+  // Some reads must have missed into the shared layer, and some must
+  // have been served by a page another pthread brought in.
+  writeln("shared read cache used: ",
+          d.cache_shared_miss > 0 &&
+          d.cache_shared_hit + d.cache_shared_dedup > 0);
+}
+
+check(Locales[1], Locales[0]);
+check(Locales[0], Locales[1]);
@@ -0,0 +1,50 @@
+//
+// Task spawn throughput driver shared by the spawnThroughput-pool and
+// spawnThroughput-ws tests, which run it with the default fifo task pool
+// and with CHPL_RT_FIFO_WORK_STEALING=true respectively.
+//
+module SpawnThroughput {
+  use Time;
+
+  config const numTrials = 10;
+  config const depth = 10;
+  config const width = here.maxTaskPar;
+  config const printTimings = false;
+
+  // Each call spawns 2**(d+1)-2 tasks, all from inside other tasks.
+  proc beginTree(d: int) {
+    if d == 0 then return;
+    sync {
+      begin beginTree(d-1);
+      begin beginTree(d-1);
+    }
+  }
+
+  proc nestedCoforall(n: int) {
+    coforall 1..n do
+      coforall 1..n { }
+  }
+
+  proc report(name: string, numTasks: int, t: Timer) {
+    writeln(name, ": ", numTasks, " tasks");
+    if printTimings {
+      writeln(name, " time: ", t.elapsed());
+      writeln(name, " tasks/sec: ", numTasks / t.elapsed());
+    }
+  }
+
+  proc run() {
+    var t: Timer;
+
+    t.start();
+    for 1..numTrials do beginTree(depth);
+    t.stop();
+    report("begin tree", numTrials * (2**(depth+1) - 2), t);
+
+    t.clear();
+    t.start();
+    for 1..numTrials do nestedCoforall(width);
+    t.stop();
+    report("nested coforall", numTrials * (width + width*width), t);
+  }
+}
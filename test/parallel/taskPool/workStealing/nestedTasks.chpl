@@ -0,0 +1,46 @@
+//
+// Exercise the fifo work-stealing task pool with nested begins,
+// coforalls and cobegins, including tasks that block on siblings.
+//
+config const depth = 10;
+config const width = 8;
+
+proc fib(n: int): int {
+  if n < 2 then return n;
+  var a, b: int;
+  cobegin with (ref a, ref b) {
+    a = fib(n-1);
+    b = fib(n-2);
+  }
+  return a + b;
+}
+
+proc countLeaves(d: int, ref count: atomic int) {
+  if d == 0 {
+    count.add(1);
+    return;
+  }
+  sync {
+    begin countLeaves(d-1, count);
+    begin countLeaves(d-1, count);
+  }
+}
+
+var leaves: atomic int;
+countLeaves(depth, leaves);
+writeln("leaves: ", leaves.read());
+
+var sum: atomic int;
+coforall i in 1..width do
+  coforall j in 1..width do
+    sum.add(i*j);
+writeln("sum: ", sum.read());
+
+writeln("fib: ", fib(15));
+
+// Each task waits for the one after it, so they all have to run.
+var flags: [0..width] sync bool;
+flags[width] = true;
+coforall i in 0..#width do
+  flags[i] = flags[i+1].readFE();
+writeln("chain: ", flags[0].readFE());
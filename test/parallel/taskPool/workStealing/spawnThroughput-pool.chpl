@@ -0,0 +1,3 @@
+use SpawnThroughput;
+
+run();
@@ -0,0 +1,88 @@
+//
+// Strided remote reads through the remote data cache.
+//
+// A row-major matrix lives on Locale 0 and the last locale reads it in
+// patterns that stride through remote memory, so the only way to hide
+// the GET latency is for the cache to detect the stride and prefetch
+// ahead of it.  Each pattern is timed separately.
+//
+module StridedRemoteRead {
+  use Time;
+
+  config const rows = 256;
+  config const cols = 256;
+  config const numTrials = 1;
+  config const printTimings = false;
+
+  enum pattern { columnSweep, reverseColumnSweep, twoStreams };
+  use pattern;
+
+  proc run() {
+    var A: [0..#rows, 0..#cols] int;
+    forall (i, j) in A.domain do A[i, j] = i*cols + j;
+
+    const n = rows*cols;
+    const expected = n*(n-1)/2;
+
+    for p in pattern {
+      var bestTime = max(real);
+      var sum: int;
+
+      for 1..numTrials {
+        // Starting an on-statement is an acquire fence, so each trial
+        // starts with nothing usable in the cache.
+        on Locales[numLocales-1] {
+          var t: Timer;
+          var mySum = 0;
+          t.start();
+          select p {
+            when columnSweep {
+              // stride of cols elements
+              for j in 0..#cols do
+                for i in 0..#rows do
+                  mySum += A[i, j];
+            }
+            when reverseColumnSweep {
+              // stride of -cols elements
+              for j in 0..#cols by -1 do
+                for i in 0..#rows by -1 do
+                  mySum += A[i, j];
+            }
+            when twoStreams {
+              // two interleaved streams with the same stride
+              const half = rows/2;
+              for j in 0..#cols {
+                for i in 0..#half do
+                  mySum += A[i, j] + A[i+half, j];
+                for i in 2*half..rows-1 do
+                  mySum += A[i, j];
+              }
+            }
+          }
+          t.stop();
+          sum = mySum;
+          bestTime = min(bestTime, t.elapsed());
+        }
+      }
+
+      const name = patternName(p);
+      if sum == expected then
+        writeln(name, ": OK");
+      else
+        writeln(name, ": got ", sum, ", expected ", expected);
+
+      if printTimings {
+        writeln(name, " time: ", bestTime);
+        writeln(name, " ns per GET: ", bestTime * 1e9 / n);
+      }
+    }
+  }
+
+  proc patternName(p: pattern) {
+    select p {
+      when columnSweep do return "column sweep";
+      when reverseColumnSweep do return "reverse column sweep";
+      otherwise do return "two streams";
+    }
+  }
+}
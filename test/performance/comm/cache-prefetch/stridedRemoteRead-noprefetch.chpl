@@ -0,0 +1,3 @@
+use StridedRemoteRead;
+
+run();
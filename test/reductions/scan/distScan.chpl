@@ -0,0 +1,28 @@
+// Check parallel scans of Block- and Cyclic-distributed arrays against
+// a serial loop, including sizes that leave some locales empty.
+
+use BlockDist, CyclicDist;
+
+config const n = 10007;
+
+proc checkScan(A) {
+  const B = + scan A;
+  var x = 0, ok = true;
+  for (a, b) in zip(A, B) {
+    x += a;
+    if b != x then ok = false;
+  }
+  const dist = if isSubtype(A._value.type, BlockArr) then "Block" else "Cyclic";
+  writeln(dist, " scan over ", A.size, " elements: ",
+          if ok then "OK" else "FAILED");
+}
+
+for size in (n, 3, 0) {
+  const BD = {1..size} dmapped Block({1..n});
+  const CD = {1..size} dmapped Cyclic(startIdx=1);
+  var BA: [BD] int, CA: [CD] int;
+  forall i in BD do BA[i] = (i * 7919) % 1009 - 500;
+  CA = BA;
+  checkScan(BA);
+  checkScan(CA);
+}
@@ -0,0 +1,43 @@
+// Check parallel scans of 1D arrays against serial loops, for the
+// built-in operators, strided and empty arrays, and sizes that don't
+// divide evenly among the tasks.
+
+config const n = 10007;
+
+proc checkScan(A, B, param op: string) {
+  var x = if op == "max" then min(A.eltType) else 0;
+  var ok = true;
+  for (a, b) in zip(A, B) {
+    if op == "+" then x += a;
+    else if op == "max" then x = max(x, a);
+    else x = x ^ a;
+    if b != x then ok = false;
+  }
+  writeln(op, " scan over ", A.domain, ": ", if ok then "OK" else "FAILED");
+}
+
+var A: [1..n] int;
+forall i in A.domain do A[i] = (i * 7919) % 1009 - 500;
+
+checkScan(A, + scan A, "+");
+checkScan(A, max scan A, "max");
+checkScan(A, ^ scan A, "^");
+
+var S: [0..#n by -3] int;
+forall i in S.domain do S[i] = i % 17;
+checkScan(S, + scan S, "+");
+
+var R: [1..n] real = 0.5;
+const RS = + scan R;
+writeln("real scan: ", RS[1], " ", RS[n]);
+
+var M: [0..#n] (int, int);
+forall i in M.domain do M[i] = ((i * 7919) % 1009, i);
+const MS = maxloc scan M;
+writeln("maxloc scan: ", MS[0], " ", MS[n-1]);
+
+var E: [1..0] int;
+writeln("empty scan: ", + scan E);
+
+var Small: [1..3] int = 1;
+writeln("small scan: ", + scan Small);
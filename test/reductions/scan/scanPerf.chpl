@@ -0,0 +1,18 @@
+// Time '+ scan' of a large Block-distributed array.
+
+use BlockDist, Time;
+
+config const n = 1000000;
+config const printTimings = false;
+
+const D = {1..n} dmapped Block({1..n});
+var A: [D] int = 1;
+
+var t: Timer;
+t.start();
+const B = + scan A;
+t.stop();
+
+writeln("Validation: ", if B[n] == n then "SUCCESS" else "FAILURE");
+if printTimings then
+  writeln("scan time: ", t.elapsed());
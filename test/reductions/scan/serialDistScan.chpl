@@ -0,0 +1,37 @@
+// Check that scans of Block- and Cyclic-distributed arrays complete and
+// are correct when their coforalls are serialized.  Two target locales
+// are used even when running on one.
+
+use BlockDist, CyclicDist;
+
+config const n = 1000;
+
+const targetLocs = for i in 0..#2 do Locales[i % numLocales];
+
+proc checkScan(A) {
+  const B = serialScan(A);
+  var x = 0, ok = true;
+  for (a, b) in zip(A, B) {
+    x += a;
+    if b != x then ok = false;
+  }
+  const dist = if isSubtype(A._value.type, BlockArr) then "Block" else "Cyclic";
+  writeln(dist, " serial scan over ", A.size, " elements: ",
+          if ok then "OK" else "FAILED");
+}
+
+proc serialScan(A) {
+  serial {
+    return + scan A;
+  }
+}
+
+for size in (n, 1) {
+  const BD = {1..size} dmapped Block({1..size}, targetLocales=targetLocs);
+  const CD = {1..size} dmapped Cyclic(startIdx=1, targetLocales=targetLocs);
+  var BA: [BD] int, CA: [CD] int;
+  forall i in BD do BA[i] = (i * 7919) % 1009 - 500;
+  CA = BA;
+  checkScan(BA);
+  checkScan(CA);
+}
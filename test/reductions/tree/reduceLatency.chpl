@@ -0,0 +1,49 @@
+/*
+This test measures the latency of small reductions over Block arrays
+spread across 1, 2, 4, ... numLocales locales.  Each reduction has
+only a few elements per locale, so its time is dominated by starting
+the tasks and combining their results.
+*/
+
+use BlockDist, Time;
+
+config const elemsPerLocale = 64;
+config const trials = 1000;
+config const printTimings = false;
+
+var ok = true;
+
+var numLocs = 1;
+while numLocs <= numLocales {
+  const targets = Locales[0..#numLocs];
+  const Space = {1..numLocs*elemsPerLocale};
+  const D = Space dmapped Block(Space, targetLocales=targets);
+  var A: [D] int = 1;
+
+  var t: Timer;
+  var sum = 0;
+  t.start();
+  for 1..trials do
+    sum += + reduce A;
+  t.stop();
+  if sum != trials * Space.size then ok = false;
+  if printTimings then
+    writeln("reduce latency on ", numLocs, " locales (us): ",
+            t.elapsed() * 1e6 / trials);
+
+  t.clear();
+  var ids = 0;
+  t.start();
+  for 1..trials do
+    coforall loc in targets with (+ reduce ids) do on loc do
+      ids += 1;
+  t.stop();
+  if ids != trials * numLocs then ok = false;
+  if printTimings then
+    writeln("coforall reduce latency on ", numLocs, " locales (us): ",
+            t.elapsed() * 1e6 / trials);
+
+  numLocs *= 2;
+}
+
+writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
@@ -0,0 +1,50 @@
+// Reductions whose tasks span locales combine through a tree of
+// per-locale node ops.  Check the results for reduce expressions and
+// intents, roots on different locales, and trees with unused subtrees.
+use BlockDist, CyclicDist;
+
+config const n = 1000;
+
+class SumXor: ReduceScanOp {
+  type eltType;
+  var value: 2*int;
+  proc identity return (0, 0);
+  proc accumulateOntoState(ref s, x) { s(1) += x; s(2) ^= x; }
+  proc accumulate(s) { value(1) += s(1); value(2) ^= s(2); }
+  proc combine(x) { accumulate(x.value); }
+  proc generate() return value;
+  proc clone() return new unmanaged SumXor(eltType=eltType);
+}
+
+proc test(D) {
+  var A: [D] int = [i in D] i;
+  writeln(+ reduce A);
+  writeln(max reduce A, " ", min reduce A);
+  writeln(minloc reduce zip(A, D), " ", maxloc reduce zip(A, D));
+  writeln(SumXor reduce A);
+  var s = 0;
+  forall a in A with (+ reduce s) do s += a;
+  writeln(s);
+}
+
+const Space = {1..n};
+test(Space dmapped Block(Space));
+test(Space dmapped Cyclic(startIdx=1));
+
+// only the last locale holds data, so the nodes between it and the
+// root have to be created when the tree is combined
+test(Space dmapped Block(Space, targetLocales=[Locales[numLocales-1]]));
+
+// the global op lives on a locale other than 0
+on Locales[numLocales/2] do test(Space dmapped Block(Space));
+
+// coforall reduce intent
+var ids = 0;
+coforall loc in Locales with (+ reduce ids) do on loc do ids += loc.id;
+writeln(ids == numLocales*(numLocales-1)/2);
+
+// reductions nested inside a distributed forall stay local
+const D = Space dmapped Block(Space);
+var B: [D] int;
+forall i in D do B[i] = + reduce [j in 1..i%7] j;
+writeln(+ reduce B);
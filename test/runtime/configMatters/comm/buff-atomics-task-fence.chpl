@@ -0,0 +1,28 @@
+use BufferedAtomics;
+
+// One task does buffered adds and never flushes them itself, while
+// another task keeps fencing.  The fences can detach the adder's
+// buffers and still be shipping them when the adder ends, so its task
+// end has to wait for those too before the adds are visible.
+
+config const rounds = 100;
+config const iters = 10000;
+
+var a: atomic int;
+
+on Locales[numLocales-1] {
+  for r in 1..rounds {
+    var adderDone: atomic bool;
+    cobegin with (ref adderDone) {
+      {
+        for 1..iters do a.addBuff(1);
+        adderDone.write(true);
+      }
+      while !adderDone.read() do flushAtomicBuff();
+    }
+    if a.read() != r * iters then
+      halt("round ", r, ": expected ", r * iters, ", got ", a.read());
+  }
+}
+
+writeln(a.read() == rounds * iters);
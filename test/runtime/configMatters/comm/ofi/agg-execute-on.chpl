@@ -0,0 +1,21 @@
+// With CHPL_RT_COMM_OFI_AGG_EXECUTE_ON=true, small non-blocking executeOns
+// to the same locale are coalesced, so fewer execute_on_nb messages go out
+// than there are remote begins.
+use CommDiagnostics;
+
+config const numOns = 1000;
+
+pragma "locale private"
+var counter: chpl__processorAtomicType(int);
+
+startCommDiagnostics();
+sync {
+  for 1..numOns do
+    begin on Locales[1] do counter.add(1);
+}
+stopCommDiagnostics();
+
+const nb = getCommDiagnostics()[0].execute_on_nb;
+on Locales[1] do writeln("remote begins run: ", counter.read() == numOns);
+writeln("execute_on_nb > 0: ", nb > 0);
+writeln("execute_on_nb < remote begins: ", nb < numOns);
@@ -0,0 +1,62 @@
+/* Building CS domains and arrays from unsorted coordinate lists */
+
+use LayoutCS;
+use LinearAlgebra.Sparse;
+use Random;
+
+config const m = 60,
+             n = 45,
+             nnz = 1000,
+             seed = 17;
+
+proc main() {
+  var rs = makeRandomStream(int, seed);
+  var inds: [1..nnz] 2*int;
+  for ind in inds do ind = (rs.getNext(1, m), rs.getNext(1, n));
+
+  // Repeat some indices
+  for k in 1..nnz by 7 do inds[k] = inds[(k*13) % nnz + 1];
+
+  testDomain(inds, compressRows=true);
+  testDomain(inds, compressRows=false);
+  testMatrix(inds);
+
+  // Small case with known layout
+  var D = CSRDomain(4, 4);
+  D += [(2, 2), (4, 1), (1, 3), (2, 2), (1, 1), (4, 4)];
+  writeln(D._value.startIdx);
+  writeln(D._value.idx[1..D.size]);
+
+  // Empty input
+  var E: [1..0] 2*int;
+  var ev: [1..0] real;
+  var B = CSRMatrix((3, 3), ev, E);
+  writeln(B.domain.size, " ", B.domain._value.startIdx);
+}
+
+/* Filling an empty domain from unsorted indices must give the same domain
+   as adding the indices one at a time */
+proc testDomain(inds, param compressRows) {
+  const P = {1..m, 1..n};
+  var D1, D2: sparse subdomain(P) dmapped CS(compressRows=compressRows);
+  const added = D1.bulkAdd(inds);
+  for ind in inds do D2 += ind;
+
+  writeln("compressRows=", compressRows, ": ", added == D2.size, " ",
+          D1._value.startIdx.equals(D2._value.startIdx), " ",
+          D1._value.idx[1..D1.size].equals(D2._value.idx[1..D2.size]));
+}
+
+/* CSRMatrix() from COO sums the values of repeated indices */
+proc testMatrix(inds) {
+  var vals: [inds.domain] real = [k in inds.domain] k: real;
+  var A = CSRMatrix((m, n), vals, inds);
+
+  var dense: [1..m, 1..n] real;
+  for (ind, v) in zip(inds, vals) do dense[ind] += v;
+
+  var ok = true;
+  for (i, j) in {1..m, 1..n} do
+    if A[i, j] != dense[i, j] then ok = false;
+  writeln("CSRMatrix: ", ok, " ", A.domain.size == + reduce (dense != 0));
+}
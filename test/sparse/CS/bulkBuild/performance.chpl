@@ -0,0 +1,53 @@
+/* Building a CSR domain and matrix from unsorted coordinates
+
+   Reports the time to fill an empty CSR domain with bulkAdd(), and to build
+   a CSR matrix with CSRMatrix(), from nnz random (row, col) pairs.  The
+   perfexecopts vary the number of tasks, to measure scaling.
+*/
+
+use LayoutCS;
+use LinearAlgebra.Sparse;
+use Random;
+use Time;
+
+config const m = 1000000,
+             n = 1000000,
+             nnz = 10000000,
+             seed = 31,
+             correctness = false;
+
+proc main() {
+  var inds: [1..nnz] 2*int;
+  var rows, cols: [1..nnz] int;
+  fillRandom(rows, seed);
+  fillRandom(cols, seed+1);
+  forall (ind, r, c) in zip(inds, rows, cols) do
+    ind = (mod(r, m) + 1, mod(c, n) + 1);
+
+  var t: Timer;
+
+  t.start();
+  var D = CSRDomain(m, n);
+  D.bulkAdd(inds);
+  t.stop();
+  const domainTime = t.elapsed();
+  t.clear();
+
+  var vals: [1..nnz] real = 1.0;
+  t.start();
+  var A = CSRMatrix((m, n), vals, inds);
+  t.stop();
+  const matrixTime = t.elapsed();
+
+  // Each nonzero's value counts how often its index was given
+  const ok = D.size == A.domain.size && + reduce A == nnz;
+
+  if correctness {
+    writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
+  } else {
+    writeln("Tasks: ", if dataParTasksPerLocale == 0 then here.maxTaskPar
+                       else dataParTasksPerLocale);
+    writeln("bulkAdd time (s): ", domainTime);
+    writeln("CSRMatrix time (s): ", matrixTime);
+  }
+}
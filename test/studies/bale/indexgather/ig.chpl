@@ -10,7 +10,8 @@ config const printStats = true,
 config const useRandomSeed = true,
              seed = if useRandomSeed then SeedGenerator.oddCurrentTime else 314159265;
 
-config const useBufferedGets = false;
+config const useBufferedGets = false,
+             useAggregation = false;
 
 const numTasksPerLocale = here.maxTaskPar;
 const numTasks = numLocales * numTasksPerLocale;
@@ -45,6 +46,18 @@ proc main() {
     use BufferedGets;
     forall i in D2 do
       getBuff(tmp.localAccess[i], A[rindex.localAccess[i]]);
+  } else if useAggregation {
+    use Aggregation, RangeChunk;
+    coforall loc in Locales do on loc {
+      const myInds = D2.localSubdomain().dim(1);
+      coforall tid in 0..#numTasksPerLocale {
+        const myChunk = chunk(myInds, numTasksPerLocale, tid);
+        const inds: [myChunk] int = rindex.localSlice(myChunk);
+        var vals: [myChunk] int;
+        gather(vals, A, inds);
+        tmp.localSlice(myChunk) = vals;
+      }
+    }
   } else {
     forall i in D2 do
       tmp.localAccess[i] = A[rindex.localAccess[i]];